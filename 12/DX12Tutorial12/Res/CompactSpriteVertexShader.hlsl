@@ -0,0 +1,33 @@
+/**
+* CompactSpriteVertexShader.hlsl
+*/
+
+struct PSInput
+{
+	float4 position : SV_POSITION;
+	float4 color : COLOR;
+	float2 texcoord : TEXCOORD;
+	nointerpolation float palette : PALETTE;
+};
+
+cbuffer RootConstants : register(b0)
+{
+	float4x4 matViewProjection;
+};
+
+/**
+* 圧縮形式のスプライト用頂点シェーダ.
+*
+* posのX, Yは1/16ピクセル単位、Zは1/32767単位の整数. Wはパレット番号.
+* 色とテクスチャ座標は頂点レイアウトのUNORM形式によって0.0～1.0に変換済み.
+*/
+PSInput main(int4 pos : POSITION, float4 color : COLOR, float2 texcoord : TEXCOORD)
+{
+	PSInput input;
+	const float3 position = float3(float2(pos.xy) * (1.0f / 16.0f), float(pos.z) * (1.0f / 32767.0f));
+	input.position = mul(float4(position, 1.0f), matViewProjection);
+	input.color = color;
+	input.texcoord = texcoord;
+	input.palette = float(pos.w);
+	return input;
+}
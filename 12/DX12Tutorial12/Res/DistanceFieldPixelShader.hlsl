@@ -0,0 +1,24 @@
+Texture2D<float> t0 : register(t0);
+SamplerState s0 : register(s0);
+
+struct PSInput
+{
+	float4 position : SV_POSITION;
+	float4 color : COLOR;
+	float2 texcoord : TEXCOORD;
+	nointerpolation float palette : PALETTE;
+};
+
+/**
+* 距離場テクスチャを使って、輪郭を滑らかに描画する.
+*
+* t0は輪郭上が0.5、内側ほど大きくなる距離場.
+* 画面上の1ピクセルで変化する距離の幅だけ輪郭をぼかすため、拡大しても縮小しても輪郭の鮮明さが変わらない.
+* 頂点カラーは乗算済みアルファであること.
+*/
+float4 main(PSInput input) : SV_TARGET
+{
+	const float distance = t0.Sample(s0, input.texcoord);
+	const float width = max(fwidth(distance) * 0.5, 0.0001);
+	return input.color * smoothstep(0.5 - width, 0.5 + width, distance);
+}
@@ -0,0 +1,27 @@
+Texture2D<uint> t0 : register(t0);
+Texture2D<float4> t1 : register(t1);
+
+struct PSInput
+{
+	float4 position : SV_POSITION;
+	float4 color : COLOR;
+	float2 texcoord : TEXCOORD;
+	nointerpolation float palette : PALETTE;
+};
+
+/**
+* パレット画像のテクスチャと頂点カラーを乗算する.
+*
+* t0はピクセル毎のパレット番号、t1は1行が1つのパレットとなるパレットテクスチャ.
+* パレット番号は補間できないため、最も近いテクセルを読み込む.
+* パレットは乗算済みアルファであること.
+*/
+float4 main(PSInput input) : SV_TARGET
+{
+	uint width, height;
+	t0.GetDimensions(width, height);
+	const int2 size = int2(width, height);
+	const int2 pos = int2(input.texcoord * float2(size));
+	const uint index = t0.Load(int3(clamp(pos, int2(0, 0), size - 1), 0));
+	return t1.Load(int3(index, (int)input.palette, 0)) * input.color;
+}
@@ -0,0 +1,74 @@
+/**
+* InstancedSpriteVertexShader.hlsl
+*/
+
+struct PSInput
+{
+	float4 position : SV_POSITION;
+	float4 color : COLOR;
+	float2 texcoord : TEXCOORD;
+	nointerpolation float palette : PALETTE;
+};
+
+cbuffer RootConstants : register(b0)
+{
+	float4x4 matViewProjection;
+};
+
+/// スプライト1つ分の描画データ. SpriteInstance::Instanceと同じ並び.
+struct Instance
+{
+	float3 center;
+	float rotation;
+	float2 size;
+	uint cellAndPalette;
+	uint color[2];
+};
+
+/// セルテーブルの要素. SpriteInstance::CellDataと同じ並び.
+struct CellData
+{
+	float2 uv;
+	float2 tsize;
+	uint vertexCount;
+	float2 mesh[8];
+};
+
+StructuredBuffer<Instance> instanceList : register(t0, space1);
+StructuredBuffer<CellData> cellTable : register(t1, space1);
+
+/**
+* RGBA8の色を展開する.
+*/
+float4 UnpackColor(uint color)
+{
+	return float4(color & 0xff, (color >> 8) & 0xff, (color >> 16) & 0xff, color >> 24) / 255.0f;
+}
+
+/**
+* インスタンス描画用スプライト頂点シェーダ.
+*
+* インスタンスデータとセルテーブルから、頂点番号に対応する形状の頂点を作成する.
+* 形状は頂点0を中心とする扇形の三角形リストで、頂点数が足りない三角形は頂点0に縮退させる.
+* 計算内容はSpriteInstance::Expandと一致させること.
+*/
+PSInput main(uint vertexId : SV_VertexID, uint instanceId : SV_InstanceID)
+{
+	const Instance instance = instanceList[instanceId];
+	const CellData cell = cellTable[instance.cellAndPalette & 0xffff];
+	const uint triangle = vertexId / 3;
+	const uint n = (triangle + 2 < cell.vertexCount && vertexId % 3) ? triangle + vertexId % 3 : 0;
+	const float2 p = cell.mesh[n];
+
+	const float2 l = float2((p.x - 0.5f) * instance.size.x, (0.5f - p.y) * instance.size.y);
+	float s, c;
+	sincos(instance.rotation, s, c);
+	const float3 pos = float3(instance.center.xy + float2(c * l.x + s * l.y, c * l.y - s * l.x), instance.center.z);
+
+	PSInput input;
+	input.position = mul(float4(pos, 1.0f), matViewProjection);
+	input.color = lerp(UnpackColor(instance.color[0]), UnpackColor(instance.color[1]), p.y);
+	input.texcoord = cell.uv + cell.tsize * p;
+	input.palette = instance.cellAndPalette >> 16;
+	return input;
+}
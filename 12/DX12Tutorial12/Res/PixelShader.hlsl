@@ -1,19 +1,20 @@
-Texture2D t0 : register(t0);
-SamplerState s0 : register(s0);
-
-struct PSInput
-{
-	float4 position : SV_POSITION;
-	float4 color : COLOR;
-	float2 texcoord : TEXCOORD;
-};
-
-float4 main(PSInput input) : SV_TARGET
-{
-	float4 tex = t0.Sample(s0, input.texcoord);
-	tex.a = smoothstep(0.4, 0.6, tex.a);
-	if (tex.a == 0) {
-		discard;
-	}
-	return tex * input.color;
+Texture2D t0 : register(t0);
+SamplerState s0 : register(s0);
+
+struct PSInput
+{
+	float4 position : SV_POSITION;
+	float4 color : COLOR;
+	float2 texcoord : TEXCOORD;
+};
+
+/**
+* テクスチャと頂点カラーを乗算する.
+*
+* テクスチャと頂点カラーはどちらも乗算済みアルファであること.
+* 頂点カラーのアルファが0の場合、結果のアルファも0になり加算合成として扱われる.
+*/
+float4 main(PSInput input) : SV_TARGET
+{
+	return t0.Sample(s0, input.texcoord) * input.color;
 }
\ No newline at end of file
@@ -0,0 +1,31 @@
+/**
+* SpriteVertexShader.hlsl
+*/
+
+struct PSInput
+{
+	float4 position : SV_POSITION;
+	float4 color : COLOR;
+	float2 texcoord : TEXCOORD;
+	nointerpolation float palette : PALETTE;
+};
+
+cbuffer RootConstants : register(b0)
+{
+	float4x4 matViewProjection;
+};
+
+/**
+* スプライト用頂点シェーダ.
+*
+* パレット番号は補間せずにピクセルシェーダへ渡す.
+*/
+PSInput main(float3 pos : POSITION, float4 color : COLOR, float2 texcoord : TEXCOORD, float palette : PALETTE)
+{
+	PSInput input;
+	input.position = mul(float4(pos, 1.0f), matViewProjection);
+	input.color = color;
+	input.texcoord = texcoord;
+	input.palette = palette;
+	return input;
+}
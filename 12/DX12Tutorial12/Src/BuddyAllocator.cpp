@@ -0,0 +1,145 @@
+/**
+* @file BuddyAllocator.cpp
+*/
+#include "BuddyAllocator.h"
+
+namespace Resource {
+
+namespace /* unnamed */ {
+
+/**
+* 2のべき乗か調べる.
+*/
+bool IsPowerOfTwo(uint64_t n)
+{
+	return n && !(n & (n - 1));
+}
+
+} // unnamed namespace
+
+/**
+* アロケータを初期化する.
+*
+* @param cap     管理する領域のバイト数. 2のべき乗であること.
+* @param minSize ブロックの最小バイト数. 2のべき乗かつcap以下であること.
+*
+* @retval true  初期化成功.
+* @retval false 引数が不正.
+*/
+bool BuddyAllocator::Init(uint64_t cap, uint64_t minSize)
+{
+	if (!IsPowerOfTwo(cap) || !IsPowerOfTwo(minSize) || minSize > cap) {
+		return false;
+	}
+	capacity = cap;
+	minBlockSize = minSize;
+	allocatedSize = 0;
+	requestedSize = 0;
+	uint32_t levelCount = 1;
+	while ((minBlockSize << (levelCount - 1)) < capacity) {
+		++levelCount;
+	}
+	freeList.clear();
+	freeList.resize(levelCount);
+	freeList.back().insert(0);
+	allocationMap.clear();
+	return true;
+}
+
+/**
+* 領域を確保する.
+*
+* @param size      確保するバイト数.
+* @param alignment 領域先頭のアラインメント. 2のべき乗であること.
+*
+* @return 確保した領域のオフセット.
+*         確保できなかった場合はinvalidOffset.
+*/
+uint64_t BuddyAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+	if (size == 0 || size > capacity || alignment > capacity) {
+		return invalidOffset;
+	}
+	uint64_t blockSize = size > alignment ? size : alignment;
+	uint32_t level = 0;
+	while ((minBlockSize << level) < blockSize) {
+		++level;
+	}
+	uint32_t freeLevel = level;
+	while (freeLevel < freeList.size() && freeList[freeLevel].empty()) {
+		++freeLevel;
+	}
+	if (freeLevel >= freeList.size()) {
+		return invalidOffset;
+	}
+
+	// 大きなブロックを必要な大きさまで分割し、後半を空きブロックに加える.
+	const uint64_t offset = *freeList[freeLevel].begin();
+	freeList[freeLevel].erase(freeList[freeLevel].begin());
+	while (freeLevel > level) {
+		--freeLevel;
+		freeList[freeLevel].insert(offset + (minBlockSize << freeLevel));
+	}
+	allocationMap.insert(std::make_pair(offset, Block{ level, size }));
+	allocatedSize += minBlockSize << level;
+	requestedSize += size;
+	return offset;
+}
+
+/**
+* Allocateで確保した領域を解放する.
+*
+* 隣接する空きブロック(バディ)があれば結合する.
+*
+* @param offset 解放する領域のオフセット.
+*
+* @retval true  解放成功.
+* @retval false offsetは割り当てられていない.
+*/
+bool BuddyAllocator::Free(uint64_t offset)
+{
+	const auto itr = allocationMap.find(offset);
+	if (itr == allocationMap.end()) {
+		return false;
+	}
+	uint32_t level = itr->second.level;
+	allocatedSize -= minBlockSize << level;
+	requestedSize -= itr->second.requestedSize;
+	allocationMap.erase(itr);
+
+	while (level + 1 < freeList.size()) {
+		const uint64_t buddy = offset ^ (minBlockSize << level);
+		const auto buddyItr = freeList[level].find(buddy);
+		if (buddyItr == freeList[level].end()) {
+			break;
+		}
+		freeList[level].erase(buddyItr);
+		offset = offset < buddy ? offset : buddy;
+		++level;
+	}
+	freeList[level].insert(offset);
+	return true;
+}
+
+/**
+* 断片化の統計情報を取得する.
+*
+* @param stats 統計情報を格納するオブジェクト.
+*/
+void BuddyAllocator::GetStatistics(Statistics& stats) const
+{
+	stats.capacity = capacity;
+	stats.allocatedSize = allocatedSize;
+	stats.requestedSize = requestedSize;
+	stats.largestFreeBlock = 0;
+	stats.allocationCount = static_cast<uint32_t>(allocationMap.size());
+	stats.freeBlockCount = 0;
+	for (size_t i = 0; i < freeList.size(); ++i) {
+		stats.freeBlockCount += static_cast<uint32_t>(freeList[i].size());
+		if (!freeList[i].empty()) {
+			stats.largestFreeBlock = minBlockSize << i;
+		}
+	}
+}
+
+} // namespace Resource
@@ -0,0 +1,79 @@
+/**
+* @file BuddyAllocator.h
+*/
+#ifndef DX12TUTORIAL_SRC_BUDDYALLOCATOR_H_
+#define DX12TUTORIAL_SRC_BUDDYALLOCATOR_H_
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Resource {
+
+/**
+* バディアロケータ.
+*
+* 領域を2のべき乗サイズのブロックに分割して割り当てる.
+* ブロックは自身のサイズでアラインメントされるため、2のべき乗のアラインメント要求を追加の隙間なしに満たせる.
+* オフセットを計算するだけで、ID3D12Heapへの対応付けはResourceHeapクラスが行う.
+* 分割と結合、断片化の統計はTest/BuddyAllocatorTest.cppで確かめている.
+*/
+class BuddyAllocator
+{
+public:
+	static const uint64_t invalidOffset = ~0ULL; ///< 確保失敗を示すオフセット.
+
+	/// 断片化の統計情報.
+	struct Statistics
+	{
+		uint64_t capacity; ///< 管理している領域のバイト数.
+		uint64_t allocatedSize; ///< 割り当てたブロックの合計バイト数.
+		uint64_t requestedSize; ///< 要求されたバイト数の合計.
+		uint64_t largestFreeBlock; ///< 最大の空きブロックのバイト数.
+		uint32_t allocationCount; ///< 割り当て中のブロック数.
+		uint32_t freeBlockCount; ///< 空きブロック数.
+
+		/// ブロック内の未使用領域の割合(内部断片化).
+		float GetInternalFragmentation() const {
+			return allocatedSize ? 1.0f - static_cast<float>(requestedSize) / static_cast<float>(allocatedSize) : 0.0f;
+		}
+		/// 最大ブロックとして確保できない空き領域の割合(外部断片化).
+		float GetExternalFragmentation() const {
+			const uint64_t freeSize = capacity - allocatedSize;
+			return freeSize ? 1.0f - static_cast<float>(largestFreeBlock) / static_cast<float>(freeSize) : 0.0f;
+		}
+	};
+
+	BuddyAllocator() = default;
+	BuddyAllocator(const BuddyAllocator&) = delete;
+	BuddyAllocator& operator=(const BuddyAllocator&) = delete;
+
+	bool Init(uint64_t capacity, uint64_t minBlockSize);
+	uint64_t Allocate(uint64_t size, uint64_t alignment);
+	bool Free(uint64_t offset);
+	void GetStatistics(Statistics& stats) const;
+
+	uint64_t GetCapacity() const { return capacity; }
+	uint64_t GetMinBlockSize() const { return minBlockSize; }
+	bool IsEmpty() const { return allocationMap.empty(); }
+
+private:
+	/// 割り当て中のブロックの情報.
+	struct Block
+	{
+		uint32_t level; ///< ブロックの大きさを示す段階. ブロックのバイト数はminBlockSize << level.
+		uint64_t requestedSize; ///< 要求されたバイト数.
+	};
+
+	uint64_t capacity = 0;
+	uint64_t minBlockSize = 0;
+	uint64_t allocatedSize = 0;
+	uint64_t requestedSize = 0;
+	std::vector<std::set<uint64_t>> freeList; ///< 段階ごとの空きブロックのオフセット.
+	std::unordered_map<uint64_t, Block> allocationMap; ///< オフセットをキーとする割り当て中のブロック.
+};
+
+} // namespace Resource
+
+#endif // DX12TUTORIAL_SRC_BUDDYALLOCATOR_H_
@@ -0,0 +1,51 @@
+/**
+* @file CopyFenceTracker.cpp
+*/
+#include "CopyFenceTracker.h"
+
+namespace Resource {
+
+/**
+* 転送コマンド用のフェンス値を発行する.
+*
+* @return 発行したフェンス値.
+*/
+uint64_t CopyFenceTracker::Issue()
+{
+	return ++lastIssuedValue;
+}
+
+/**
+* 次の描画で使うリソースの転送完了を示すフェンス値を登録する.
+*
+* @param value リソースの転送完了を示すフェンス値. 0なら転送完了済みとみなす.
+*/
+void CopyFenceTracker::Require(uint64_t value)
+{
+	if (value > requiredValue) {
+		requiredValue = value;
+	}
+}
+
+/**
+* 描画キューに挿入すべき待機のフェンス値を取得する.
+*
+* 登録されたフェンス値はリセットされる.
+*
+* @param completedValue コピーキューで完了済みのフェンス値.
+*
+* @return 描画キューが待機すべきフェンス値.
+*         待機が不要なら0.
+*/
+uint64_t CopyFenceTracker::GetWaitValue(uint64_t completedValue)
+{
+	const uint64_t value = requiredValue;
+	requiredValue = 0;
+	if (value <= completedValue || value <= waitedValue) {
+		return 0;
+	}
+	waitedValue = value;
+	return value;
+}
+
+} // namespace Resource
@@ -0,0 +1,40 @@
+/**
+* @file CopyFenceTracker.h
+*/
+#ifndef DX12TUTORIAL_SRC_COPYFENCETRACKER_H_
+#define DX12TUTORIAL_SRC_COPYFENCETRACKER_H_
+#include <stdint.h>
+
+namespace Resource {
+
+/**
+* コピーキューのフェンス値を管理し、描画キューに待機を挿入する必要があるか判定するクラス.
+*
+* ID3D12Fenceには触れず、値の比較だけで判定する. Test/CopyFenceTrackerTest.cppでは、コピーキューの完了を
+* 乱数で遅らせたシミュレーションで、待機の漏れと重複がないことを調べている.
+*
+* 使い方.
+* -# 転送コマンドを送るたびにIssueでフェンス値を発行する. 転送したリソースにはこの値を記録しておく.
+* -# 描画でリソースを使うとき、記録しておいた値をRequireに渡す.
+* -# 描画コマンドを送る直前にGetWaitValueを呼ぶ. 0以外が返されたら、描画キューにその値の待機を挿入する.
+*    既に完了している転送や、以前に待機を挿入した転送に対しては0を返す.
+*/
+class CopyFenceTracker
+{
+public:
+	uint64_t Issue();
+	void Require(uint64_t value);
+	uint64_t GetWaitValue(uint64_t completedValue);
+
+	uint64_t GetLastIssuedValue() const { return lastIssuedValue; }
+	uint64_t GetWaitedValue() const { return waitedValue; }
+
+private:
+	uint64_t lastIssuedValue = 0; ///< 最後に発行したフェンス値.
+	uint64_t requiredValue = 0; ///< 次の描画が必要とするフェンス値の最大値.
+	uint64_t waitedValue = 0; ///< 描画キューに待機を挿入した最大のフェンス値.
+};
+
+} // namespace Resource
+
+#endif // DX12TUTORIAL_SRC_COPYFENCETRACKER_H_
@@ -0,0 +1,103 @@
+/**
+* @file CopyQueue.cpp
+*/
+#include "CopyQueue.h"
+
+namespace Resource {
+
+/**
+* デストラクタ.
+*/
+CopyQueue::~CopyQueue()
+{
+	if (fenceEvent) {
+		CloseHandle(fenceEvent);
+	}
+}
+
+/**
+* コピーキューを初期化する.
+*
+* @param device D3Dデバイス.
+*
+* @retval true  初期化成功.
+* @retval false 初期化失敗.
+*/
+bool CopyQueue::Init(Microsoft::WRL::ComPtr<ID3D12Device> device)
+{
+	D3D12_COMMAND_QUEUE_DESC desc = {};
+	desc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+	if (FAILED(device->CreateCommandQueue(&desc, IID_PPV_ARGS(&commandQueue)))) {
+		return false;
+	}
+	commandQueue->SetName(L"Copy Queue");
+	if (FAILED(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)))) {
+		return false;
+	}
+	fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+	if (!fenceEvent) {
+		return false;
+	}
+	return true;
+}
+
+/**
+* 転送コマンドリストを実行する.
+*
+* @param commandList 転送コマンドを積んだコマンドリスト. D3D12_COMMAND_LIST_TYPE_COPYであること.
+* @param fenceValue  転送完了を示すフェンス値を格納する変数.
+*
+* @retval true  成功.
+* @retval false 失敗.
+*/
+bool CopyQueue::Submit(ID3D12CommandList* commandList, UINT64& fenceValue)
+{
+	ID3D12CommandList* ppCommandLists[] = { commandList };
+	commandQueue->ExecuteCommandLists(_countof(ppCommandLists), ppCommandLists);
+	fenceValue = tracker.Issue();
+	if (FAILED(commandQueue->Signal(fence.Get(), fenceValue))) {
+		return false;
+	}
+	return true;
+}
+
+/**
+* 転送の完了をCPUで待つ.
+*
+* @param fenceValue 待機するフェンス値.
+*
+* @retval true  成功.
+* @retval false 失敗.
+*/
+bool CopyQueue::Wait(UINT64 fenceValue)
+{
+	if (fence->GetCompletedValue() >= fenceValue) {
+		return true;
+	}
+	if (FAILED(fence->SetEventOnCompletion(fenceValue, fenceEvent))) {
+		return false;
+	}
+	WaitForSingleObject(fenceEvent, INFINITE);
+	return true;
+}
+
+/**
+* 必要なら、Requireで登録された転送の完了を待つ命令を描画キューに挿入する.
+*
+* 描画コマンドリストを描画キューに積む直前に呼び出すこと.
+*
+* @param graphicsQueue 描画キュー.
+*
+* @retval true  成功.
+* @retval false 失敗.
+*/
+bool CopyQueue::InsertWait(ID3D12CommandQueue* graphicsQueue)
+{
+	const UINT64 value = tracker.GetWaitValue(fence->GetCompletedValue());
+	if (value == 0) {
+		return true;
+	}
+	return SUCCEEDED(graphicsQueue->Wait(fence.Get(), value));
+}
+
+} // namespace Resource
@@ -0,0 +1,47 @@
+/**
+* @file CopyQueue.h
+*/
+#ifndef DX12TUTORIAL_SRC_COPYQUEUE_H_
+#define DX12TUTORIAL_SRC_COPYQUEUE_H_
+#include "CopyFenceTracker.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+
+namespace Resource {
+
+/**
+* データ転送用のコピーキュー.
+*
+* 転送は描画と並行して実行される.
+* 転送したリソースを描画で使う場合、Requireで転送完了のフェンス値を登録しておくと、
+* InsertWaitが必要な場合だけ描画キューに待機を挿入する.
+*/
+class CopyQueue
+{
+public:
+	CopyQueue() = default;
+	CopyQueue(const CopyQueue&) = delete;
+	CopyQueue& operator=(const CopyQueue&) = delete;
+	~CopyQueue();
+
+	bool Init(Microsoft::WRL::ComPtr<ID3D12Device> device);
+	bool Submit(ID3D12CommandList* commandList, UINT64& fenceValue);
+	bool Wait(UINT64 fenceValue);
+	bool Flush() { return Wait(tracker.GetLastIssuedValue()); }
+	void Require(UINT64 fenceValue) { tracker.Require(fenceValue); }
+	bool InsertWait(ID3D12CommandQueue* graphicsQueue);
+
+	bool IsCompleted(UINT64 fenceValue) const { return fence->GetCompletedValue() >= fenceValue; }
+	UINT64 GetCompletedValue() const { return fence->GetCompletedValue(); }
+	ID3D12CommandQueue* Get() const { return commandQueue.Get(); }
+
+private:
+	Microsoft::WRL::ComPtr<ID3D12CommandQueue> commandQueue;
+	Microsoft::WRL::ComPtr<ID3D12Fence> fence;
+	HANDLE fenceEvent = nullptr;
+	CopyFenceTracker tracker;
+};
+
+} // namespace Resource
+
+#endif // DX12TUTORIAL_SRC_COPYQUEUE_H_
@@ -0,0 +1,200 @@
+/**
+* @file DescriptorAllocator.cpp
+*/
+#include "DescriptorAllocator.h"
+#include <algorithm>
+
+namespace Resource {
+
+/**
+* アロケータを初期化する.
+*
+* @param size           1ページ(1つのデスクリプタヒープ)に含まれるデスクリプタ数.
+* @param transientCount 1フレームで一時的に割り当てられるデスクリプタ数.
+* @param frameCount     フレームバッファの数.
+*
+* @retval true  初期化成功.
+* @retval false 一時領域がページに収まらない.
+*/
+bool DescriptorAllocator::Init(uint32_t size, uint32_t transientCount, uint32_t frameCount)
+{
+	if (size == 0 || size > 0xffff || transientCount * frameCount >= size) {
+		return false;
+	}
+	pageSize = size;
+	transientCountPerFrame = transientCount;
+	allocatedCount = 0;
+	pageList.clear();
+	AddPage();
+
+	// 最初のページの先頭を一時領域として予約する.
+	const uint32_t transientTotal = transientCount * frameCount;
+	pageList[0].freeList[0] = { transientTotal, pageSize - transientTotal };
+	frameList.resize(frameCount);
+	for (uint32_t i = 0; i < frameCount; ++i) {
+		frameList[i] = { i * transientCount, i * transientCount, 0 };
+	}
+	currentFrame = 0;
+	return true;
+}
+
+/**
+* ページを追加する.
+*/
+void DescriptorAllocator::AddPage()
+{
+	pageList.push_back(Page());
+	Page& page = pageList.back();
+	page.freeList.push_back({ 0, pageSize });
+	page.generation.resize(pageSize, 0);
+	page.allocatedCount.resize(pageSize, 0);
+}
+
+/**
+* 永続的に使うデスクリプタの範囲を確保する.
+*
+* @param count 確保するデスクリプタ数.
+*
+* @return 確保した範囲を示すハンドル.
+*         確保できなかった場合はIsNull()がtrueを返すハンドル.
+*/
+DescriptorHandle DescriptorAllocator::Allocate(uint32_t count)
+{
+	if (count == 0 || count > pageSize) {
+		return {};
+	}
+	for (;;) {
+		for (size_t pageNo = 0; pageNo < pageList.size(); ++pageNo) {
+			Page& page = pageList[pageNo];
+			for (auto itr = page.freeList.begin(); itr != page.freeList.end(); ++itr) {
+				if (itr->count < count) {
+					continue;
+				}
+				const uint32_t offset = itr->offset;
+				itr->offset += count;
+				itr->count -= count;
+				if (itr->count == 0) {
+					page.freeList.erase(itr);
+				}
+				page.allocatedCount[offset] = static_cast<uint16_t>(count);
+				allocatedCount += count;
+				return { static_cast<uint16_t>(pageNo), static_cast<uint16_t>(count), offset, page.generation[offset] };
+			}
+		}
+		if (pageList.size() >= 0xffff) {
+			return {};
+		}
+		AddPage();
+	}
+}
+
+/**
+* Allocateで確保した範囲を解放する.
+*
+* @param handle 解放する範囲を示すハンドル.
+*
+* @retval true  解放成功.
+* @retval false handleは無効(解放済みか一時領域のハンドル).
+*/
+bool DescriptorAllocator::Free(const DescriptorHandle& handle)
+{
+	if (!IsValid(handle) || IsTransient(handle)) {
+		return false;
+	}
+	Page& page = pageList[handle.page];
+	page.allocatedCount[handle.offset] = 0;
+	++page.generation[handle.offset];
+	allocatedCount -= handle.count;
+
+	// 空き範囲をオフセット順に挿入し、隣接する範囲と結合する.
+	const Range range = { handle.offset, handle.count };
+	auto itr = std::lower_bound(page.freeList.begin(), page.freeList.end(), range,
+		[](const Range& lhs, const Range& rhs) { return lhs.offset < rhs.offset; });
+	itr = page.freeList.insert(itr, range);
+	const auto next = itr + 1;
+	if (next != page.freeList.end() && itr->offset + itr->count == next->offset) {
+		itr->count += next->count;
+		page.freeList.erase(next);
+	}
+	if (itr != page.freeList.begin()) {
+		const auto prev = itr - 1;
+		if (prev->offset + prev->count == itr->offset) {
+			prev->count += itr->count;
+			page.freeList.erase(itr);
+		}
+	}
+	return true;
+}
+
+/**
+* フレームの一時領域をリセットする.
+*
+* 以前にこのフレームで確保したハンドルは無効になる.
+*
+* @param frameIndex フレームバッファのインデックス.
+*/
+void DescriptorAllocator::BeginFrame(uint32_t frameIndex)
+{
+	currentFrame = frameIndex;
+	Frame& frame = frameList[currentFrame];
+	frame.cursor = frame.begin;
+	++frame.generation;
+}
+
+/**
+* 現在のフレームの間だけ使うデスクリプタの範囲を確保する.
+*
+* @param count 確保するデスクリプタ数.
+*
+* @return 確保した範囲を示すハンドル.
+*         一時領域が足りない場合はIsNull()がtrueを返すハンドル.
+*/
+DescriptorHandle DescriptorAllocator::AllocateTransient(uint32_t count)
+{
+	if (frameList.empty()) {
+		return {};
+	}
+	Frame& frame = frameList[currentFrame];
+	if (count == 0 || frame.cursor + count > frame.begin + transientCountPerFrame) {
+		return {};
+	}
+	const uint32_t offset = frame.cursor;
+	frame.cursor += count;
+	return { 0, static_cast<uint16_t>(count), offset, frame.generation };
+}
+
+/**
+* ハンドルが一時領域を指しているか調べる.
+*
+* @param handle 調べるハンドル.
+*
+* @retval true  一時領域を指している.
+* @retval false 永続領域を指している.
+*/
+bool DescriptorAllocator::IsTransient(const DescriptorHandle& handle) const
+{
+	return handle.page == 0 && handle.offset < transientCountPerFrame * frameList.size();
+}
+
+/**
+* ハンドルが有効か調べる.
+*
+* @param handle 調べるハンドル.
+*
+* @retval true  有効.
+* @retval false 解放済み、または一時領域のハンドルで既にフレームが変わっている.
+*/
+bool DescriptorAllocator::IsValid(const DescriptorHandle& handle) const
+{
+	if (handle.IsNull() || handle.page >= pageList.size() || handle.offset + handle.count > pageSize) {
+		return false;
+	}
+	if (IsTransient(handle)) {
+		const Frame& frame = frameList[handle.offset / transientCountPerFrame];
+		return frame.generation == handle.generation && handle.offset < frame.cursor;
+	}
+	const Page& page = pageList[handle.page];
+	return page.allocatedCount[handle.offset] == handle.count && page.generation[handle.offset] == handle.generation;
+}
+
+} // namespace Resource
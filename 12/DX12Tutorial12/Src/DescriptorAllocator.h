@@ -0,0 +1,92 @@
+/**
+* @file DescriptorAllocator.h
+*/
+#ifndef DX12TUTORIAL_SRC_DESCRIPTORALLOCATOR_H_
+#define DX12TUTORIAL_SRC_DESCRIPTORALLOCATOR_H_
+#include <vector>
+#include <stdint.h>
+
+namespace Resource {
+
+/**
+* デスクリプタの範囲を示すハンドル.
+*
+* generationは範囲の解放ごとに更新されるため、解放済みのハンドルの使用を検出できる.
+*/
+struct DescriptorHandle
+{
+	uint16_t page; ///< デスクリプタヒープ(ページ)の番号.
+	uint16_t count; ///< 範囲に含まれるデスクリプタ数. 0なら無効なハンドル.
+	uint32_t offset; ///< ページ先頭からのインデックス.
+	uint32_t generation; ///< 割り当て時の世代番号.
+
+	bool IsNull() const { return count == 0; }
+};
+
+/**
+* デスクリプタの割り当てを管理するクラス.
+*
+* 扱うのはページ番号とインデックスだけで、実際のデスクリプタヒープとの対応付けはDescriptorHeapクラスが行う.
+* 空き範囲の結合や世代番号による無効化はTest/DescriptorAllocatorTest.cppで確かめている.
+*
+* - 永続的な割り当て: Allocate/Freeで連続した範囲を確保・解放する.
+*   ページに空きがなければ新しいページを追加する.
+* - フレーム単位の一時的な割り当て: BeginFrameでそのフレームの領域がリセットされ、
+*   AllocateTransientで前から順に確保する. 一時領域は最初のページの先頭に置かれる.
+*/
+class DescriptorAllocator
+{
+public:
+	DescriptorAllocator() = default;
+	DescriptorAllocator(const DescriptorAllocator&) = delete;
+	DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+
+	bool Init(uint32_t pageSize, uint32_t transientCountPerFrame, uint32_t frameCount);
+	DescriptorHandle Allocate(uint32_t count = 1);
+	bool Free(const DescriptorHandle& handle);
+	void BeginFrame(uint32_t frameIndex);
+	DescriptorHandle AllocateTransient(uint32_t count = 1);
+	bool IsValid(const DescriptorHandle& handle) const;
+	bool IsTransient(const DescriptorHandle& handle) const;
+
+	uint32_t GetPageSize() const { return pageSize; }
+	uint32_t GetPageCount() const { return static_cast<uint32_t>(pageList.size()); }
+	uint32_t GetAllocatedCount() const { return allocatedCount; }
+
+private:
+	/// 空き範囲.
+	struct Range
+	{
+		uint32_t offset;
+		uint32_t count;
+	};
+
+	/// ページ単位の管理情報.
+	struct Page
+	{
+		std::vector<Range> freeList; ///< オフセット順に並んだ空き範囲.
+		std::vector<uint32_t> generation; ///< デスクリプタ毎の世代番号.
+		std::vector<uint16_t> allocatedCount; ///< 範囲の先頭に記録する割り当て数. 未割り当てなら0.
+	};
+
+	/// フレーム単位の一時割り当て領域.
+	struct Frame
+	{
+		uint32_t begin;
+		uint32_t cursor;
+		uint32_t generation;
+	};
+
+	void AddPage();
+
+	uint32_t pageSize = 0;
+	uint32_t transientCountPerFrame = 0;
+	uint32_t allocatedCount = 0;
+	std::vector<Page> pageList;
+	std::vector<Frame> frameList;
+	uint32_t currentFrame = 0;
+};
+
+} // namespace Resource
+
+#endif // DX12TUTORIAL_SRC_DESCRIPTORALLOCATOR_H_
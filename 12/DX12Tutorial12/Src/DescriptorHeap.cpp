@@ -0,0 +1,114 @@
+/**
+* @file DescriptorHeap.cpp
+*/
+#include "DescriptorHeap.h"
+#include "d3dx12.h"
+
+namespace Resource {
+
+/**
+* デスクリプタヒープを初期化する.
+*
+* @param device                 D3Dデバイス.
+* @param type                   デスクリプタヒープの種類.
+* @param pageSize               1つのデスクリプタヒープに含まれるデスクリプタ数.
+* @param transientCountPerFrame 1フレームで一時的に割り当てられるデスクリプタ数.
+* @param frameCount             フレームバッファの数.
+*
+* @retval true  初期化成功.
+* @retval false 初期化失敗.
+*/
+bool DescriptorHeap::Init(Microsoft::WRL::ComPtr<ID3D12Device> d, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t pageSize, uint32_t transientCountPerFrame, uint32_t frameCount)
+{
+	device = d;
+	heapType = type;
+	descriptorSize = device->GetDescriptorHandleIncrementSize(type);
+	heapList.clear();
+	if (!allocator.Init(pageSize, transientCountPerFrame, frameCount)) {
+		return false;
+	}
+	return AddHeap();
+}
+
+/**
+* デスクリプタヒープを追加する.
+*
+* @retval true  追加成功.
+* @retval false 追加失敗.
+*/
+bool DescriptorHeap::AddHeap()
+{
+	D3D12_DESCRIPTOR_HEAP_DESC desc = {};
+	desc.Type = heapType;
+	desc.NumDescriptors = allocator.GetPageSize();
+	if (heapType == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV || heapType == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER) {
+		desc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+	}
+	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> heap;
+	if (FAILED(device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&heap)))) {
+		return false;
+	}
+	heapList.push_back(heap);
+	return true;
+}
+
+/**
+* 永続的に使うデスクリプタの範囲を確保する.
+*
+* @param count 確保するデスクリプタ数.
+*
+* @return 確保した範囲を示すハンドル.
+*         確保できなかった場合はIsNull()がtrueを返すハンドル.
+*/
+DescriptorHandle DescriptorHeap::Allocate(uint32_t count)
+{
+	const DescriptorHandle handle = allocator.Allocate(count);
+	while (heapList.size() < allocator.GetPageCount()) {
+		if (!AddHeap()) {
+			allocator.Free(handle);
+			return {};
+		}
+	}
+	return handle;
+}
+
+/**
+* Allocateで確保した範囲を解放する.
+*
+* @param handle 解放する範囲を示すハンドル.
+*
+* @retval true  解放成功.
+* @retval false handleは無効.
+*/
+bool DescriptorHeap::Free(const DescriptorHandle& handle)
+{
+	return allocator.Free(handle);
+}
+
+/**
+* ハンドルに対応するCPUデスクリプタハンドルを取得する.
+*
+* @param handle デスクリプタの範囲を示すハンドル.
+* @param index  範囲内のインデックス.
+*
+* @return CPUデスクリプタハンドル.
+*/
+D3D12_CPU_DESCRIPTOR_HANDLE DescriptorHeap::GetCPUHandle(const DescriptorHandle& handle, uint32_t index) const
+{
+	return CD3DX12_CPU_DESCRIPTOR_HANDLE(heapList[handle.page]->GetCPUDescriptorHandleForHeapStart(), handle.offset + index, descriptorSize);
+}
+
+/**
+* ハンドルに対応するGPUデスクリプタハンドルを取得する.
+*
+* @param handle デスクリプタの範囲を示すハンドル.
+* @param index  範囲内のインデックス.
+*
+* @return GPUデスクリプタハンドル.
+*/
+D3D12_GPU_DESCRIPTOR_HANDLE DescriptorHeap::GetGPUHandle(const DescriptorHandle& handle, uint32_t index) const
+{
+	return CD3DX12_GPU_DESCRIPTOR_HANDLE(heapList[handle.page]->GetGPUDescriptorHandleForHeapStart(), handle.offset + index, descriptorSize);
+}
+
+} // namespace Resource
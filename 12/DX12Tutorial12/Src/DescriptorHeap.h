@@ -0,0 +1,52 @@
+/**
+* @file DescriptorHeap.h
+*/
+#ifndef DX12TUTORIAL_SRC_DESCRIPTORHEAP_H_
+#define DX12TUTORIAL_SRC_DESCRIPTORHEAP_H_
+#include "DescriptorAllocator.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <vector>
+
+namespace Resource {
+
+/**
+* 拡張可能なデスクリプタヒープ.
+*
+* DescriptorAllocatorが割り当てたハンドルを実際のデスクリプタヒープの位置に変換する.
+* ページが足りなくなると、新しいデスクリプタヒープを作成して連結する.
+* 異なるページのデスクリプタは同時にバインドできないため、描画時はGetHeapで得たヒープを設定すること.
+*/
+class DescriptorHeap
+{
+public:
+	DescriptorHeap() = default;
+	DescriptorHeap(const DescriptorHeap&) = delete;
+	DescriptorHeap& operator=(const DescriptorHeap&) = delete;
+
+	bool Init(Microsoft::WRL::ComPtr<ID3D12Device> device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint32_t pageSize, uint32_t transientCountPerFrame, uint32_t frameCount);
+	DescriptorHandle Allocate(uint32_t count = 1);
+	bool Free(const DescriptorHandle& handle);
+	void BeginFrame(uint32_t frameIndex) { allocator.BeginFrame(frameIndex); }
+	DescriptorHandle AllocateTransient(uint32_t count = 1) { return allocator.AllocateTransient(count); }
+	bool IsValid(const DescriptorHandle& handle) const { return allocator.IsValid(handle); }
+
+	D3D12_CPU_DESCRIPTOR_HANDLE GetCPUHandle(const DescriptorHandle& handle, uint32_t index = 0) const;
+	D3D12_GPU_DESCRIPTOR_HANDLE GetGPUHandle(const DescriptorHandle& handle, uint32_t index = 0) const;
+	ID3D12DescriptorHeap* GetHeap(uint32_t page = 0) const { return heapList[page].Get(); }
+	ID3D12DescriptorHeap* GetHeap(const DescriptorHandle& handle) const { return heapList[handle.page].Get(); }
+	ID3D12Device* GetDevice() const { return device.Get(); }
+
+private:
+	bool AddHeap();
+
+	Microsoft::WRL::ComPtr<ID3D12Device> device;
+	D3D12_DESCRIPTOR_HEAP_TYPE heapType;
+	UINT descriptorSize;
+	DescriptorAllocator allocator;
+	std::vector<Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>> heapList;
+};
+
+} // namespace Resource
+
+#endif // DX12TUTORIAL_SRC_DESCRIPTORHEAP_H_
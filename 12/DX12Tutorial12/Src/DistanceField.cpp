@@ -0,0 +1,258 @@
+/**
+* @file DistanceField.cpp
+*/
+#include "DistanceField.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <cmath>
+
+namespace DistanceField {
+
+namespace /* unnamed */ {
+
+const float infinity = 1e20f; ///< 距離の初期値. 画像の大きさの2乗より十分大きいこと.
+
+/**
+* 点q, pを頂点とする放物線の交点のX座標を計算する.
+*/
+float Intersect(const float* f, int q, int p)
+{
+	return ((f[q] + static_cast<float>(q * q)) - (f[p] + static_cast<float>(p * p))) / static_cast<float>(2 * q - 2 * p);
+}
+
+/**
+* 1次元の2乗距離変換を行う(Felzenszwalb-Huttenlocherのアルゴリズム).
+*
+* @param f 入力. 特徴点なら0、それ以外ならinfinity.
+* @param d 各点から最も近い特徴点までの2乗距離を格納する配列.
+* @param n 要素数.
+* @param v 作業用配列. n要素.
+* @param z 作業用配列. n + 1要素.
+*/
+void Transform1D(const float* f, float* d, int n, int* v, float* z)
+{
+	int k = 0;
+	v[0] = 0;
+	z[0] = -infinity;
+	z[1] = infinity;
+	for (int q = 1; q < n; ++q) {
+		// 放物線qが隠す放物線を取り除いてから、qを下側の包絡線に加える.
+		float s = Intersect(f, q, v[k]);
+		while (s <= z[k]) {
+			--k;
+			s = Intersect(f, q, v[k]);
+		}
+		++k;
+		v[k] = q;
+		z[k] = s;
+		z[k + 1] = infinity;
+	}
+	k = 0;
+	for (int q = 0; q < n; ++q) {
+		while (z[k + 1] < static_cast<float>(q)) {
+			++k;
+		}
+		const float dq = static_cast<float>(q - v[k]);
+		d[q] = dq * dq + f[v[k]];
+	}
+}
+
+/**
+* 2次元の2乗距離変換を行う.
+*
+* 列方向、行方向の順に1次元の変換を行う.
+*
+* @param grid   入力. 特徴点なら0、それ以外ならinfinity. 変換結果で上書きされる.
+* @param width  幅.
+* @param height 高さ.
+*/
+void Transform2D(std::vector<float>& grid, int width, int height)
+{
+	const int n = std::max(width, height);
+	std::vector<float> f(n);
+	std::vector<float> d(n);
+	std::vector<int> v(n);
+	std::vector<float> z(n + 1);
+	for (int x = 0; x < width; ++x) {
+		for (int y = 0; y < height; ++y) {
+			f[y] = grid[y * width + x];
+		}
+		Transform1D(f.data(), d.data(), height, v.data(), z.data());
+		for (int y = 0; y < height; ++y) {
+			grid[y * width + x] = d[y];
+		}
+	}
+	for (int y = 0; y < height; ++y) {
+		float* row = grid.data() + y * width;
+		std::copy(row, row + width, f.begin());
+		Transform1D(f.data(), row, width, v.data(), z.data());
+	}
+}
+
+} // unnamed namespace
+
+/**
+* グリフの距離場の大きさを取得する.
+*
+* @param glyph  元画像のグリフの範囲.
+* @param scale  縮小率.
+* @param spread 距離を記録する範囲(元画像のピクセル数).
+* @param width  距離場の幅を格納する変数.
+* @param height 距離場の高さを格納する変数.
+*/
+void GetSize(const Rect& glyph, uint32_t scale, uint32_t spread, uint32_t& width, uint32_t& height)
+{
+	if (glyph.width == 0 || glyph.height == 0) {
+		width = height = 0;
+		return;
+	}
+	width = (glyph.width + spread * 2 + scale - 1) / scale;
+	height = (glyph.height + spread * 2 + scale - 1) / scale;
+}
+
+/**
+* 1つのグリフの距離場を生成する.
+*
+* アルファ値が128以上のピクセルを内側とする. グリフの範囲外のピクセルは、隣のグリフがはみ出していても外側として扱う.
+* 元画像の解像度で正確な距離を求めてから、scale x scaleピクセルの平均で縮小する.
+*
+* @param alpha       元画像のアルファ値.
+* @param rowPitch    元画像の1行のバイト数.
+* @param glyph       元画像のグリフの範囲.
+* @param scale       縮小率.
+* @param spread      距離を記録する範囲(元画像のピクセル数).
+* @param dst         距離場を書き込むバッファ. 大きさはGetSizeで取得できる.
+* @param dstRowPitch dstの1行のバイト数.
+*/
+void Generate(const uint8_t* alpha, size_t rowPitch, const Rect& glyph, uint32_t scale, uint32_t spread, uint8_t* dst, size_t dstRowPitch)
+{
+	uint32_t dstWidth, dstHeight;
+	GetSize(glyph, scale, spread, dstWidth, dstHeight);
+	if (dstWidth == 0 || dstHeight == 0) {
+		return;
+	}
+	const int width = static_cast<int>(dstWidth * scale);
+	const int height = static_cast<int>(dstHeight * scale);
+	const int offset = static_cast<int>(spread);
+
+	// 外側から内側までの距離と、内側から外側までの距離を求める.
+	std::vector<float> outside(width * height);
+	std::vector<float> inside(width * height);
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			const int gx = x - offset;
+			const int gy = y - offset;
+			bool isInside = false;
+			if (gx >= 0 && gy >= 0 && gx < static_cast<int>(glyph.width) && gy < static_cast<int>(glyph.height)) {
+				isInside = alpha[rowPitch * (glyph.y + gy) + glyph.x + gx] >= 128;
+			}
+			outside[y * width + x] = isInside ? 0.0f : infinity;
+			inside[y * width + x] = isInside ? infinity : 0.0f;
+		}
+	}
+	Transform2D(outside, width, height);
+	Transform2D(inside, width, height);
+
+	// ピクセル中心間の距離から0.5を引いて、輪郭までの符号付き距離とする.
+	const float invSpread = 0.5f / static_cast<float>(spread);
+	const float invArea = 1.0f / static_cast<float>(scale * scale);
+	for (uint32_t y = 0; y < dstHeight; ++y) {
+		uint8_t* p = dst + dstRowPitch * y;
+		for (uint32_t x = 0; x < dstWidth; ++x) {
+			float sum = 0;
+			for (uint32_t sy = y * scale; sy < (y + 1) * scale; ++sy) {
+				for (uint32_t sx = x * scale; sx < (x + 1) * scale; ++sx) {
+					const size_t i = sy * width + sx;
+					sum += outside[i] > 0 ? std::sqrt(outside[i]) - 0.5f : 0.5f - std::sqrt(inside[i]);
+				}
+			}
+			const float value = 0.5f - sum * invArea * invSpread;
+			p[x] = static_cast<uint8_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+		}
+	}
+}
+
+/**
+* 複数のグリフの距離場を生成し、1枚の画像にまとめる.
+*
+* グリフは高い順に、左から右へ棚状に詰めて配置する.
+* 距離場の生成はグリフ単位で複数のスレッドに分けて行う.
+*
+* @param alpha       元画像のアルファ値.
+* @param rowPitch    元画像の1行のバイト数.
+* @param glyphList   元画像のグリフの範囲の配列. 幅または高さが0のグリフは配置しない.
+* @param glyphCount  グリフの数.
+* @param scale       縮小率.
+* @param spread      距離を記録する範囲(元画像のピクセル数).
+* @param atlasWidth  まとめた画像の幅.
+* @param atlas       まとめた画像を格納するオブジェクト. rectListはglyphListと同じ順に並ぶ.
+* @param threadCount 使用するスレッド数. 0ならハードウェアのスレッド数.
+*
+* @retval true  生成成功.
+* @retval false atlasWidthより幅の広いグリフがある.
+*/
+bool BuildAtlas(const uint8_t* alpha, size_t rowPitch, const Rect* glyphList, size_t glyphCount, uint32_t scale, uint32_t spread, uint32_t atlasWidth, Atlas& atlas, uint32_t threadCount)
+{
+	atlas.width = atlasWidth;
+	atlas.scale = scale;
+	atlas.spread = spread;
+	atlas.rectList.assign(glyphCount, Rect{ 0, 0, 0, 0 });
+
+	std::vector<size_t> order;
+	order.reserve(glyphCount);
+	for (size_t i = 0; i < glyphCount; ++i) {
+		GetSize(glyphList[i], scale, spread, atlas.rectList[i].width, atlas.rectList[i].height);
+		if (atlas.rectList[i].width > atlasWidth) {
+			return false;
+		}
+		if (atlas.rectList[i].width > 0) {
+			order.push_back(i);
+		}
+	}
+	std::stable_sort(order.begin(), order.end(), [&atlas](size_t lhs, size_t rhs) {
+		return atlas.rectList[lhs].height > atlas.rectList[rhs].height;
+	});
+	uint32_t x = 0;
+	uint32_t y = 0;
+	uint32_t shelfHeight = 0;
+	for (size_t i : order) {
+		Rect& r = atlas.rectList[i];
+		if (x + r.width > atlasWidth) {
+			x = 0;
+			y += shelfHeight;
+			shelfHeight = 0;
+		}
+		r.x = x;
+		r.y = y;
+		x += r.width;
+		shelfHeight = std::max(shelfHeight, r.height);
+	}
+	atlas.height = std::max(y + shelfHeight, 1U);
+	atlas.image.assign(static_cast<size_t>(atlas.width) * atlas.height, 0);
+
+	if (threadCount == 0) {
+		threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+	}
+	threadCount = static_cast<uint32_t>(std::min<size_t>(threadCount, std::max<size_t>(order.size(), 1)));
+	std::atomic<size_t> next(0);
+	const auto worker = [&]() {
+		for (size_t n = next++; n < order.size(); n = next++) {
+			const size_t i = order[n];
+			const Rect& r = atlas.rectList[i];
+			Generate(alpha, rowPitch, glyphList[i], scale, spread, atlas.image.data() + static_cast<size_t>(atlas.width) * r.y + r.x, atlas.width);
+		}
+	};
+	std::vector<std::thread> threadList;
+	threadList.reserve(threadCount - 1);
+	for (uint32_t i = 1; i < threadCount; ++i) {
+		threadList.push_back(std::thread(worker));
+	}
+	worker();
+	for (auto& e : threadList) {
+		e.join();
+	}
+	return true;
+}
+
+} // namespace DistanceField
@@ -0,0 +1,52 @@
+/**
+* @file DistanceField.h
+*/
+#ifndef DX12TUTORIAL_SRC_DISTANCEFIELD_H_
+#define DX12TUTORIAL_SRC_DISTANCEFIELD_H_
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+* 符号付き距離場(SDF)生成用名前空間.
+*
+* ビットマップフォントの各グリフを、輪郭までの距離を記録した縮小画像に変換して1枚の画像にまとめる.
+* 距離場はピクセルシェーダで0.5を境界として描画すれば、拡大しても輪郭がぼやけない.
+* 距離変換の結果はTest/DistanceFieldTest.cppで全ての点の組を調べた距離と比べている.
+*/
+namespace DistanceField {
+
+/**
+* 画像上の矩形.
+*/
+struct Rect
+{
+	uint32_t x;
+	uint32_t y;
+	uint32_t width;
+	uint32_t height;
+};
+
+/**
+* 距離場のグリフをまとめた画像.
+*
+* 各ピクセルの値は、輪郭上が128、内側ほど大きく外側ほど小さい.
+* spread以上離れたピクセルは0または255になる.
+*/
+struct Atlas
+{
+	uint32_t width;
+	uint32_t height;
+	uint32_t scale; ///< 元画像に対する縮小率.
+	uint32_t spread; ///< 距離を記録する範囲(元画像のピクセル数). グリフの周囲にこの幅の余白が付く.
+	std::vector<uint8_t> image; ///< 1ピクセル1バイトの画像. 1行はwidthバイト.
+	std::vector<Rect> rectList; ///< 各グリフの距離場の範囲. 余白を含む.
+};
+
+void GetSize(const Rect& glyph, uint32_t scale, uint32_t spread, uint32_t& width, uint32_t& height);
+void Generate(const uint8_t* alpha, size_t rowPitch, const Rect& glyph, uint32_t scale, uint32_t spread, uint8_t* dst, size_t dstRowPitch);
+bool BuildAtlas(const uint8_t* alpha, size_t rowPitch, const Rect* glyphList, size_t glyphCount, uint32_t scale, uint32_t spread, uint32_t atlasWidth, Atlas& atlas, uint32_t threadCount = 0);
+
+} // namespace DistanceField
+
+#endif // DX12TUTORIAL_SRC_DISTANCEFIELD_H_
@@ -1,31 +1,40 @@
-/**
-* @file PSO.h
-*/
-#ifndef DX12TUTORIAL_SRC_PSO_H_
-#define DX12TUTORIAL_SRC_PSO_H_
-#include <d3d12.h>
-#include <wrl/client.h>
-
-/**
-* [gVOl`PSO܂Ƃ߂\.
-*/
-struct PSO
-{
-	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature;
-	Microsoft::WRL::ComPtr<ID3D12PipelineState> pso;
-};
-
-/**
-* PSO̎.
-*/
-enum PSOType {
-	PSOType_Simple,
-	PSOType_NoiseTexture,
-	PSOType_Sprite,
-	countof_PSOType
-};
-
-bool CreatePSOList(ID3D12Device* device, bool warp);
-const PSO& GetPSO(PSOType);
-
+/**
+* @file PSO.h
+*/
+#ifndef DX12TUTORIAL_SRC_PSO_H_
+#define DX12TUTORIAL_SRC_PSO_H_
+#include <d3d12.h>
+#include <wrl/client.h>
+
+/**
+* ルートシグネチャとPSOをまとめた構造体.
+*/
+struct PSO
+{
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature;
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> pso;
+	const PSO* opaque = nullptr; ///< 完全に不透明なスプライトを描画するためのPSO. 合成せずに深度を書き込む. なければnullptr.
+};
+
+/**
+* PSOの種類.
+*/
+enum PSOType {
+	PSOType_Simple,
+	PSOType_NoiseTexture,
+	PSOType_Sprite,
+	PSOType_IndexedSprite,
+	PSOType_DistanceFieldSprite,
+	PSOType_InstancedSprite,
+	PSOType_InstancedIndexedSprite,
+	PSOType_CompactSprite,
+	PSOType_CompactIndexedSprite,
+	PSOType_OpaqueSprite,
+	PSOType_OpaqueCompactSprite,
+	countof_PSOType
+};
+
+bool CreatePSOList(ID3D12Device* device, bool warp);
+const PSO& GetPSO(PSOType);
+
 #endif // DX12TUTORIAL_SRC_PSO_H_
\ No newline at end of file
@@ -0,0 +1,302 @@
+/**
+* @file Palette.cpp
+*/
+#include "Palette.h"
+#include <emmintrin.h>
+#include <algorithm>
+#include <unordered_map>
+#include <string.h>
+
+namespace Palette {
+
+namespace /* unnamed */ {
+
+/// 画像に含まれる色と、その色のピクセル数.
+struct ColorCount
+{
+	uint32_t color;
+	uint32_t count;
+};
+
+/// メディアンカットで分割する色の範囲.
+struct Box
+{
+	size_t begin;
+	size_t end;
+	int channel; ///< 最も範囲が広いチャネル. 分割できない場合は-1.
+	int range; ///< channelの範囲.
+};
+
+/**
+* 色からチャネルの値を取り出す.
+*/
+int GetChannel(uint32_t color, int channel)
+{
+	return (color >> (channel * 8)) & 0xff;
+}
+
+/**
+* 範囲に含まれる色から、最も範囲が広いチャネルを調べる.
+*
+* @param list 色のリスト.
+* @param box  調べる範囲.
+*/
+void UpdateBox(const std::vector<ColorCount>& list, Box& box)
+{
+	int minValue[4] = { 255, 255, 255, 255 };
+	int maxValue[4] = { 0, 0, 0, 0 };
+	for (size_t i = box.begin; i < box.end; ++i) {
+		for (int c = 0; c < 4; ++c) {
+			const int v = GetChannel(list[i].color, c);
+			minValue[c] = std::min(minValue[c], v);
+			maxValue[c] = std::max(maxValue[c], v);
+		}
+	}
+	box.channel = -1;
+	box.range = 0;
+	if (box.end - box.begin < 2) {
+		return;
+	}
+	for (int c = 0; c < 4; ++c) {
+		if (maxValue[c] - minValue[c] > box.range) {
+			box.channel = c;
+			box.range = maxValue[c] - minValue[c];
+		}
+	}
+}
+
+/**
+* メディアンカットでパレットを作成する.
+*
+* @param list       画像に含まれる色のリスト. 分割のために並べ替えられる.
+* @param colorList  パレットを格納する配列.
+* @param colorCount パレットの最大色数.
+*
+* @return 作成したパレットの色数.
+*/
+uint32_t MedianCut(std::vector<ColorCount>& list, uint32_t* colorList, uint32_t colorCount)
+{
+	std::vector<Box> boxList;
+	boxList.reserve(colorCount);
+	boxList.push_back({ 0, list.size(), -1, 0 });
+	UpdateBox(list, boxList.back());
+	while (boxList.size() < colorCount) {
+		// 最も範囲が広い箱を、そのチャネルのピクセル数の中央で分割する.
+		auto itr = std::max_element(boxList.begin(), boxList.end(), [](const Box& lhs, const Box& rhs) { return lhs.range < rhs.range; });
+		if (itr->channel < 0) {
+			break;
+		}
+		Box& box = *itr;
+		const int channel = box.channel;
+		std::sort(list.begin() + box.begin, list.begin() + box.end, [channel](const ColorCount& lhs, const ColorCount& rhs) {
+			return GetChannel(lhs.color, channel) < GetChannel(rhs.color, channel);
+		});
+		uint64_t total = 0;
+		for (size_t i = box.begin; i < box.end; ++i) {
+			total += list[i].count;
+		}
+		uint64_t sum = 0;
+		size_t median = box.begin + 1;
+		for (size_t i = box.begin; i < box.end - 1; ++i) {
+			sum += list[i].count;
+			median = i + 1;
+			if (sum * 2 >= total) {
+				break;
+			}
+		}
+		Box second = { median, box.end, -1, 0 };
+		box.end = median;
+		UpdateBox(list, box);
+		UpdateBox(list, second);
+		boxList.push_back(second);
+	}
+
+	// 箱に含まれる色をピクセル数で重み付けした平均を、パレットの色とする.
+	for (size_t n = 0; n < boxList.size(); ++n) {
+		uint64_t sum[4] = {};
+		uint64_t total = 0;
+		for (size_t i = boxList[n].begin; i < boxList[n].end; ++i) {
+			for (int c = 0; c < 4; ++c) {
+				sum[c] += static_cast<uint64_t>(GetChannel(list[i].color, c)) * list[i].count;
+			}
+			total += list[i].count;
+		}
+		uint32_t color = 0;
+		for (int c = 0; c < 4; ++c) {
+			color |= static_cast<uint32_t>((sum[c] + total / 2) / total) << (c * 8);
+		}
+		colorList[n] = color;
+	}
+	return static_cast<uint32_t>(boxList.size());
+}
+
+/**
+* パレットから最も近い色を探すためのSIMD用データ.
+*
+* 4色ずつ比較できるように、チャネル毎に並べ替えたパレットを保持する.
+*/
+class NearestColorFinder
+{
+public:
+	NearestColorFinder(const uint32_t* colorList, uint32_t colorCount, uint32_t firstIndex)
+	{
+		first = firstIndex;
+		count = (colorCount - firstIndex + 3) & ~3U;
+		for (int c = 0; c < 4; ++c) {
+			// 余った要素は遠い色で埋めて、選ばれないようにする.
+			std::fill(channel[c], channel[c] + maxColorCount, 1.0e6f);
+			for (uint32_t i = firstIndex; i < colorCount; ++i) {
+				channel[c][i - firstIndex] = static_cast<float>(GetChannel(colorList[i], c));
+			}
+		}
+	}
+
+	/**
+	* 最も近い色のパレット番号を取得する.
+	*
+	* @param color 探す色.
+	*
+	* @return colorに最も近い色のパレット番号.
+	*/
+	uint8_t Find(uint32_t color) const
+	{
+		__m128 target[4];
+		for (int c = 0; c < 4; ++c) {
+			target[c] = _mm_set1_ps(static_cast<float>(GetChannel(color, c)));
+		}
+		__m128 minDistance = _mm_set1_ps(3.4e38f);
+		__m128i minIndex = _mm_setzero_si128();
+		__m128i index = _mm_setr_epi32(0, 1, 2, 3);
+		const __m128i four = _mm_set1_epi32(4);
+		for (uint32_t i = 0; i < count; i += 4) {
+			__m128 distance = _mm_setzero_ps();
+			for (int c = 0; c < 4; ++c) {
+				const __m128 d = _mm_sub_ps(_mm_loadu_ps(channel[c] + i), target[c]);
+				distance = _mm_add_ps(distance, _mm_mul_ps(d, d));
+			}
+			const __m128 closer = _mm_cmplt_ps(distance, minDistance);
+			minDistance = _mm_min_ps(distance, minDistance);
+			minIndex = _mm_or_si128(_mm_and_si128(_mm_castps_si128(closer), index), _mm_andnot_si128(_mm_castps_si128(closer), minIndex));
+			index = _mm_add_epi32(index, four);
+		}
+		float d[4];
+		int32_t n[4];
+		_mm_storeu_ps(d, minDistance);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(n), minIndex);
+		int best = 0;
+		for (int i = 1; i < 4; ++i) {
+			if (d[i] < d[best] || (d[i] == d[best] && n[i] < n[best])) {
+				best = i;
+			}
+		}
+		return static_cast<uint8_t>(n[best] + first);
+	}
+
+private:
+	float channel[4][maxColorCount];
+	uint32_t first;
+	uint32_t count;
+};
+
+} // unnamed namespace
+
+/**
+* 32ビットRGBA画像をパレット画像に変換する.
+*
+* 色数が256以下なら、そのままパレットにするため劣化しない.
+* 256を超える場合はメディアンカットでパレットを作成し、各色を最も近いパレットの色に置き換える.
+* 完全に透明な色(0, 0, 0, 0)は、他の色と混ざらないように専用のパレット番号を割り当てる.
+*
+* @param rgba     画像のピクセルデータ. 乗算済みアルファであること.
+* @param rowPitch 1行のバイト数.
+* @param width    画像の幅.
+* @param height   画像の高さ.
+* @param image    変換したパレット画像を格納するオブジェクト.
+*
+* @retval true  変換成功.
+* @retval false 画像が空.
+*/
+bool Quantize(const uint8_t* rgba, size_t rowPitch, uint32_t width, uint32_t height, IndexedImage& image)
+{
+	if (width == 0 || height == 0) {
+		return false;
+	}
+
+	// 画像に含まれる色を数える.
+	std::unordered_map<uint32_t, uint32_t> histogram;
+	for (uint32_t y = 0; y < height; ++y) {
+		const uint8_t* p = rgba + rowPitch * y;
+		for (uint32_t x = 0; x < width; ++x, p += 4) {
+			uint32_t color;
+			memcpy(&color, p, 4);
+			++histogram[color];
+		}
+	}
+
+	image.width = width;
+	image.height = height;
+	std::fill(image.colorList, image.colorList + maxColorCount, 0);
+	std::unordered_map<uint32_t, uint8_t> indexMap;
+	if (histogram.size() <= maxColorCount) {
+		image.colorCount = 0;
+		for (const auto& e : histogram) {
+			indexMap[e.first] = static_cast<uint8_t>(image.colorCount);
+			image.colorList[image.colorCount++] = e.first;
+		}
+	} else {
+		const auto transparent = histogram.find(0);
+		const uint32_t first = transparent != histogram.end() ? 1 : 0;
+		std::vector<ColorCount> list;
+		list.reserve(histogram.size());
+		for (const auto& e : histogram) {
+			if (e.first != 0) {
+				list.push_back({ e.first, e.second });
+			}
+		}
+		image.colorCount = first + MedianCut(list, image.colorList + first, maxColorCount - first);
+		const NearestColorFinder finder(image.colorList, image.colorCount, first);
+		for (const auto& e : list) {
+			indexMap[e.color] = finder.Find(e.color);
+		}
+		if (first) {
+			indexMap[0] = 0;
+		}
+	}
+
+	image.indexList.resize(static_cast<size_t>(width) * height);
+	uint8_t* dst = image.indexList.data();
+	for (uint32_t y = 0; y < height; ++y) {
+		const uint8_t* p = rgba + rowPitch * y;
+		for (uint32_t x = 0; x < width; ++x, p += 4) {
+			uint32_t color;
+			memcpy(&color, p, 4);
+			*dst++ = indexMap[color];
+		}
+	}
+	return true;
+}
+
+/**
+* パレットを変換して、別の種類のパレットを作成する.
+*
+* @param src     元のパレット.
+* @param dst     作成したパレットを格納する配列.
+* @param count   パレットの色数.
+* @param variant 作成するパレットの種類.
+*/
+void CreateVariant(const uint32_t* src, uint32_t* dst, size_t count, Variant variant)
+{
+	switch (variant) {
+	case Variant_Flash:
+		// 赤以外のチャネルを0にする. 乗算済みアルファなので赤はそのまま使える.
+		for (size_t i = 0; i < count; ++i) {
+			dst[i] = src[i] & 0xff0000ff;
+		}
+		break;
+	default:
+		std::copy(src, src + count, dst);
+		break;
+	}
+}
+
+} // namespace Palette
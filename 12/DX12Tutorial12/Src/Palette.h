@@ -0,0 +1,51 @@
+/**
+* @file Palette.h
+*/
+#ifndef DX12TUTORIAL_SRC_PALETTE_H_
+#define DX12TUTORIAL_SRC_PALETTE_H_
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+* パレット画像用名前空間.
+*
+* 32ビットRGBA画像を8ビットのインデックスと256色のパレットに変換する.
+* 変換はテクスチャを作る前にCPUだけで行う. 最も近い色の選択が全探索と一致することは
+* Test/PaletteTest.cppで確かめている.
+*/
+namespace Palette {
+
+static const uint32_t maxColorCount = 256; ///< パレットの最大色数.
+
+/**
+* パレットの種類.
+*
+* パレット画像は、元のパレットを変換した複数のパレットを持つ.
+* スプライトは描画時にパレットを選ぶだけで色を変えられる.
+*/
+enum Variant
+{
+	Variant_Normal, ///< 元の色.
+	Variant_Flash, ///< 被弾時の赤い点滅.
+	countof_Variant
+};
+
+/**
+* パレット画像.
+*/
+struct IndexedImage
+{
+	uint32_t width;
+	uint32_t height;
+	std::vector<uint8_t> indexList; ///< ピクセル毎のパレット番号. 1行はwidthバイト.
+	uint32_t colorList[maxColorCount]; ///< パレット. 1色はR, G, B, Aの順の4バイト.
+	uint32_t colorCount; ///< パレットの有効な色数.
+};
+
+bool Quantize(const uint8_t* rgba, size_t rowPitch, uint32_t width, uint32_t height, IndexedImage& image);
+void CreateVariant(const uint32_t* src, uint32_t* dst, size_t count, Variant variant);
+
+} // namespace Palette
+
+#endif // DX12TUTORIAL_SRC_PALETTE_H_
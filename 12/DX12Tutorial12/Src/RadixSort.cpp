@@ -0,0 +1,64 @@
+/**
+* @file RadixSort.cpp
+*/
+#include "RadixSort.h"
+#include <string.h>
+
+/**
+* キーの昇順に安定ソートする.
+*
+* 下位から8ビットずつ分配するLSD基数ソート. 全ての要素で同じ値の桁は分配を省く.
+*
+* @param list ソートする配列. ソート結果で上書きされる.
+* @param work 作業用配列. 大きさは自動的に調整される.
+*/
+void RadixSort(std::vector<SortItem>& list, std::vector<SortItem>& work)
+{
+	const size_t n = list.size();
+	if (n < 2) {
+		return;
+	}
+
+	// 全ての桁の度数分布を先に数えておく.
+	uint32_t histogram[8][256];
+	memset(histogram, 0, sizeof(histogram));
+	for (const SortItem& e : list) {
+		for (int digit = 0; digit < 8; ++digit) {
+			++histogram[digit][(e.key >> (digit * 8)) & 0xff];
+		}
+	}
+
+	work.resize(n);
+	for (int digit = 0; digit < 8; ++digit) {
+		uint32_t* count = histogram[digit];
+		const int shift = digit * 8;
+		if (count[(list[0].key >> shift) & 0xff] == n) {
+			continue;
+		}
+		uint32_t offset = 0;
+		for (int i = 0; i < 256; ++i) {
+			const uint32_t c = count[i];
+			count[i] = offset;
+			offset += c;
+		}
+		for (const SortItem& e : list) {
+			work[count[(e.key >> shift) & 0xff]++] = e;
+		}
+		list.swap(work);
+	}
+}
+
+/**
+* 浮動小数点数を、大小関係が同じ符号なし整数に変換する.
+*
+* @param f 変換する値. NaNは考慮しない.
+*
+* @return fと同じ順序を持つ整数.
+*/
+uint32_t FloatToSortKey(float f)
+{
+	uint32_t bits;
+	memcpy(&bits, &f, sizeof(bits));
+	// 負数は全ビットを反転し、正数は符号ビットだけを反転する.
+	return (bits & 0x80000000U) ? ~bits : (bits | 0x80000000U);
+}
@@ -0,0 +1,21 @@
+/**
+* @file RadixSort.h
+*/
+#ifndef DX12TUTORIAL_SRC_RADIXSORT_H_
+#define DX12TUTORIAL_SRC_RADIXSORT_H_
+#include <vector>
+#include <stdint.h>
+
+/**
+* ソートする要素.
+*/
+struct SortItem
+{
+	uint64_t key; ///< ソートキー.
+	uint32_t value; ///< 任意の値. 通常はソートする配列の添字.
+};
+
+void RadixSort(std::vector<SortItem>& list, std::vector<SortItem>& work);
+uint32_t FloatToSortKey(float f);
+
+#endif // DX12TUTORIAL_SRC_RADIXSORT_H_
@@ -0,0 +1,165 @@
+/**
+* @file ResourceHeap.cpp
+*/
+#include "ResourceHeap.h"
+#include "d3dx12.h"
+
+namespace Resource {
+
+/**
+* ヒープを初期化する.
+*
+* @param d     D3Dデバイス.
+* @param type  ヒープの種類.
+* @param flags ヒープの用途を示すフラグ.
+* @param size  1つのID3D12Heapのバイト数. 2のべき乗であること.
+*
+* @retval true  初期化成功.
+* @retval false 初期化失敗.
+*/
+bool ResourceHeap::Init(Microsoft::WRL::ComPtr<ID3D12Device> d, D3D12_HEAP_TYPE type, D3D12_HEAP_FLAGS flags, UINT64 size)
+{
+	device = d;
+	heapType = type;
+	heapFlags = flags;
+	heapSize = size;
+	heapList.clear();
+	return AddHeap();
+}
+
+/**
+* ヒープを追加する.
+*
+* @retval true  追加成功.
+* @retval false 追加失敗.
+*/
+bool ResourceHeap::AddHeap()
+{
+	std::unique_ptr<Heap> p(new Heap);
+	// 小さなテクスチャやバッファは4KB単位で配置できるため、最小ブロックを4KBとする.
+	if (!p->allocator.Init(heapSize, D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT)) {
+		return false;
+	}
+	const CD3DX12_HEAP_DESC desc(heapSize, heapType, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT, heapFlags);
+	if (FAILED(device->CreateHeap(&desc, IID_PPV_ARGS(&p->heap)))) {
+		return false;
+	}
+	heapList.push_back(std::move(p));
+	return true;
+}
+
+/**
+* リソースをヒープに配置できるか調べる.
+*
+* @param desc リソースの詳細情報.
+*
+* @retval true  配置できる.
+* @retval false 配置できない.
+*/
+bool ResourceHeap::IsPlaceable(const D3D12_RESOURCE_DESC& desc) const
+{
+	const bool isBuffer = desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER;
+	const bool isRenderTarget = (desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) != 0;
+	if ((heapFlags & D3D12_HEAP_FLAG_DENY_BUFFERS) && isBuffer) {
+		return false;
+	}
+	if ((heapFlags & D3D12_HEAP_FLAG_DENY_NON_RT_DS_TEXTURES) && !isBuffer && !isRenderTarget) {
+		return false;
+	}
+	if ((heapFlags & D3D12_HEAP_FLAG_DENY_RT_DS_TEXTURES) && !isBuffer && isRenderTarget) {
+		return false;
+	}
+	return true;
+}
+
+/**
+* リソースを作成する.
+*
+* @param desc         リソースの詳細情報.
+* @param initialState リソースの初期状態.
+* @param clearValue   クリア値. 不要ならnullptr.
+* @param resource     作成したリソースを格納するオブジェクト.
+* @param allocation   リソースの配置情報を格納するオブジェクト.
+*                     リソースが不要になったら、GPUが使い終えた後でFreeに渡すこと.
+*
+* @retval true  作成成功.
+* @retval false 作成失敗.
+*/
+bool ResourceHeap::CreateResource(const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue, Microsoft::WRL::ComPtr<ID3D12Resource>& resource, Allocation& allocation)
+{
+	allocation = Allocation();
+
+	// 小さなテクスチャは4KBアラインメントを試し、使えなければ既定のアラインメントにする.
+	D3D12_RESOURCE_DESC placedDesc = desc;
+	D3D12_RESOURCE_ALLOCATION_INFO info;
+	if (placedDesc.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER && placedDesc.Alignment == 0) {
+		placedDesc.Alignment = D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT;
+		info = device->GetResourceAllocationInfo(0, 1, &placedDesc);
+		if (info.Alignment != D3D12_SMALL_RESOURCE_PLACEMENT_ALIGNMENT) {
+			placedDesc.Alignment = 0;
+			info = device->GetResourceAllocationInfo(0, 1, &placedDesc);
+		}
+	} else {
+		info = device->GetResourceAllocationInfo(0, 1, &placedDesc);
+	}
+
+	if (!IsPlaceable(desc) || info.SizeInBytes > heapSize) {
+		return SUCCEEDED(device->CreateCommittedResource(&CD3DX12_HEAP_PROPERTIES(heapType), D3D12_HEAP_FLAG_NONE, &desc, initialState, clearValue, IID_PPV_ARGS(&resource)));
+	}
+
+	for (uint32_t i = 0; ; ++i) {
+		if (i >= heapList.size() && !AddHeap()) {
+			return false;
+		}
+		Heap& heap = *heapList[i];
+		const uint64_t offset = heap.allocator.Allocate(info.SizeInBytes, info.Alignment);
+		if (offset == BuddyAllocator::invalidOffset) {
+			continue;
+		}
+		if (FAILED(device->CreatePlacedResource(heap.heap.Get(), offset, &placedDesc, initialState, clearValue, IID_PPV_ARGS(&resource)))) {
+			heap.allocator.Free(offset);
+			return false;
+		}
+		allocation.heapIndex = i;
+		allocation.offset = offset;
+		return true;
+	}
+}
+
+/**
+* リソースの配置領域を解放する.
+*
+* @param allocation CreateResourceで得た配置情報. 解放後は空になる.
+*/
+void ResourceHeap::Free(Allocation& allocation)
+{
+	if (allocation.IsNull() || allocation.heapIndex >= heapList.size()) {
+		return;
+	}
+	heapList[allocation.heapIndex]->allocator.Free(allocation.offset);
+	allocation = Allocation();
+}
+
+/**
+* 全てのヒープを合計した断片化の統計情報を取得する.
+*
+* @param stats 統計情報を格納するオブジェクト.
+*/
+void ResourceHeap::GetStatistics(BuddyAllocator::Statistics& stats) const
+{
+	stats = {};
+	for (const auto& e : heapList) {
+		BuddyAllocator::Statistics s;
+		e->allocator.GetStatistics(s);
+		stats.capacity += s.capacity;
+		stats.allocatedSize += s.allocatedSize;
+		stats.requestedSize += s.requestedSize;
+		stats.allocationCount += s.allocationCount;
+		stats.freeBlockCount += s.freeBlockCount;
+		if (s.largestFreeBlock > stats.largestFreeBlock) {
+			stats.largestFreeBlock = s.largestFreeBlock;
+		}
+	}
+}
+
+} // namespace Resource
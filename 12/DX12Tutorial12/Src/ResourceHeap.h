@@ -0,0 +1,63 @@
+/**
+* @file ResourceHeap.h
+*/
+#ifndef DX12TUTORIAL_SRC_RESOURCEHEAP_H_
+#define DX12TUTORIAL_SRC_RESOURCEHEAP_H_
+#include "BuddyAllocator.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <vector>
+#include <memory>
+
+namespace Resource {
+
+/**
+* 配置リソース用のヒープ.
+*
+* 大きなID3D12Heapを確保しておき、BuddyAllocatorで分割してリソースを配置する.
+* ヒープが一杯になると新しいヒープを追加する.
+* ヒープに配置できないリソース(ヒープより大きい、ヒープの用途と合わない)はコミットリソースとして作成する.
+*/
+class ResourceHeap
+{
+public:
+	/// リソースの配置情報.
+	struct Allocation
+	{
+		uint32_t heapIndex = 0; ///< 配置したヒープの番号.
+		uint64_t offset = BuddyAllocator::invalidOffset; ///< ヒープ先頭からのオフセット. コミットリソースならinvalidOffset.
+
+		bool IsNull() const { return offset == BuddyAllocator::invalidOffset; }
+	};
+
+	ResourceHeap() = default;
+	ResourceHeap(const ResourceHeap&) = delete;
+	ResourceHeap& operator=(const ResourceHeap&) = delete;
+
+	bool Init(Microsoft::WRL::ComPtr<ID3D12Device> device, D3D12_HEAP_TYPE type, D3D12_HEAP_FLAGS flags, UINT64 heapSize);
+	bool CreateResource(const D3D12_RESOURCE_DESC& desc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue, Microsoft::WRL::ComPtr<ID3D12Resource>& resource, Allocation& allocation);
+	void Free(Allocation& allocation);
+	void GetStatistics(BuddyAllocator::Statistics& stats) const;
+	size_t GetHeapCount() const { return heapList.size(); }
+
+private:
+	/// ヒープと割り当て状況.
+	struct Heap
+	{
+		Microsoft::WRL::ComPtr<ID3D12Heap> heap;
+		BuddyAllocator allocator;
+	};
+
+	bool AddHeap();
+	bool IsPlaceable(const D3D12_RESOURCE_DESC& desc) const;
+
+	Microsoft::WRL::ComPtr<ID3D12Device> device;
+	D3D12_HEAP_TYPE heapType;
+	D3D12_HEAP_FLAGS heapFlags;
+	UINT64 heapSize;
+	std::vector<std::unique_ptr<Heap>> heapList;
+};
+
+} // namespace Resource
+
+#endif // DX12TUTORIAL_SRC_RESOURCEHEAP_H_
@@ -0,0 +1,136 @@
+/**
+* @file RingAllocator.cpp
+*/
+#include "RingAllocator.h"
+
+namespace Resource {
+
+namespace /* unnamed */ {
+
+/**
+* 値をアラインメントの倍数に切り上げる.
+*
+* @param value     切り上げる値.
+* @param alignment アラインメント. 2の累乗であること.
+*
+* @return 切り上げた値.
+*/
+uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // unnamed namespace
+
+/**
+* アロケータを初期化する.
+*
+* @param size 管理する領域のバイト数.
+*/
+void RingAllocator::Init(uint64_t size)
+{
+	capacity = size;
+	head = 0;
+	tail = 0;
+	usedSize = 0;
+	uncommittedSize = 0;
+	uncommittedExternalCount = 0;
+	fenceList.clear();
+}
+
+/**
+* 領域を確保する.
+*
+* @param size      確保するバイト数.
+* @param alignment 領域先頭のアラインメント. 2の累乗であること.
+*
+* @return 確保した領域のオフセット.
+*         空きが足りない場合や、sizeが容量を超える場合はinvalidOffsetを返す.
+*/
+uint64_t RingAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+	if (size == 0 || size > capacity) {
+		return invalidOffset;
+	}
+	if (usedSize == 0) {
+		// 空なら先頭から使うことで、大きな領域を確保しやすくする.
+		head = 0;
+		tail = 0;
+	}
+
+	uint64_t offset = invalidOffset;
+	uint64_t consumed = 0;
+	const uint64_t alignedHead = AlignUp(head, alignment);
+	if (usedSize == 0 || head > tail) {
+		// 空き領域は[head, capacity)と[0, tail)の二つ.
+		if (alignedHead + size <= capacity) {
+			offset = alignedHead;
+			consumed = alignedHead + size - head;
+		} else if (size <= tail) {
+			// 末尾の隙間を捨てて先頭に折り返す.
+			offset = 0;
+			consumed = (capacity - head) + size;
+		}
+	} else if (head < tail) {
+		// 空き領域は[head, tail)のみ.
+		if (alignedHead + size <= tail) {
+			offset = alignedHead;
+			consumed = alignedHead + size - head;
+		}
+	}
+	if (offset == invalidOffset) {
+		return invalidOffset;
+	}
+	head = offset + size;
+	if (head >= capacity) {
+		head = 0;
+	}
+	usedSize += consumed;
+	uncommittedSize += consumed;
+	return offset;
+}
+
+/**
+* 前回のCommit以降に確保した領域と、AddExternalで登録した外部の領域にフェンス値を関連付ける.
+*
+* @param fenceValue 領域の使用完了を示すフェンス値.
+*/
+void RingAllocator::Commit(uint64_t fenceValue)
+{
+	if (!HasUncommittedRange()) {
+		return;
+	}
+	if (!fenceList.empty() && fenceList.back().fenceValue == fenceValue) {
+		fenceList.back().end = head;
+		fenceList.back().size += uncommittedSize;
+		fenceList.back().externalCount += uncommittedExternalCount;
+	} else {
+		fenceList.push_back({ fenceValue, head, uncommittedSize, uncommittedExternalCount });
+	}
+	uncommittedSize = 0;
+	uncommittedExternalCount = 0;
+}
+
+/**
+* 使用が完了した領域を解放する.
+*
+* @param completedFenceValue GPUが通過したフェンス値.
+*
+* @return 解放された外部の領域の数.
+*/
+size_t RingAllocator::Reclaim(uint64_t completedFenceValue)
+{
+	size_t externalCount = 0;
+	while (!fenceList.empty() && fenceList.front().fenceValue <= completedFenceValue) {
+		// 外部の領域だけの範囲は、Commit後に空のリングの先頭へ戻ったheadを指している可能性があるため、tailを動かさない.
+		if (fenceList.front().size) {
+			tail = fenceList.front().end;
+		}
+		usedSize -= fenceList.front().size;
+		externalCount += fenceList.front().externalCount;
+		fenceList.pop_front();
+	}
+	return externalCount;
+}
+
+} // namespace Resource
@@ -0,0 +1,69 @@
+/**
+* @file RingAllocator.h
+*/
+#ifndef DX12TUTORIAL_SRC_RINGALLOCATOR_H_
+#define DX12TUTORIAL_SRC_RINGALLOCATOR_H_
+#include <deque>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Resource {
+
+/**
+* フェンス値によって領域を解放するリングアロケータ.
+*
+* フェンスとは整数値でしかやり取りしないので、Test/RingAllocatorTest.cppではフェンスを模したカウンタで
+* 折り返しや複数フレームの同時実行を調べている.
+*
+* 使い方.
+* -# Allocateで領域を確保する.
+* -# 確保した領域を使うコマンドを送ったら、Commitでそのコマンドの完了を示すフェンス値を関連付ける.
+* -# Reclaimに完了済みのフェンス値を渡すと、それ以前にCommitされた領域が解放される.
+*
+* 容量を超える要求はリングの外で確保し、AddExternalで登録する. 登録した領域はリング内の領域と同じフェンス値で解放され、
+* Reclaimの戻り値として解放された数が返される. 外部の領域は登録した順に解放される.
+*/
+class RingAllocator
+{
+public:
+	static const uint64_t invalidOffset = ~0ULL; ///< 確保失敗を示すオフセット.
+
+	RingAllocator() = default;
+	explicit RingAllocator(uint64_t size) { Init(size); }
+
+	void Init(uint64_t size);
+	uint64_t Allocate(uint64_t size, uint64_t alignment);
+	void AddExternal() { ++uncommittedExternalCount; }
+	void Commit(uint64_t fenceValue);
+	size_t Reclaim(uint64_t completedFenceValue);
+
+	bool IsOversized(uint64_t size) const { return size > capacity; }
+	bool HasCommittedRange() const { return !fenceList.empty(); }
+	bool HasUncommittedRange() const { return uncommittedSize || uncommittedExternalCount; }
+	uint64_t GetOldestFenceValue() const { return fenceList.empty() ? 0 : fenceList.front().fenceValue; }
+	uint64_t GetCapacity() const { return capacity; }
+	uint64_t GetUsedSize() const { return usedSize; }
+	uint64_t GetUncommittedSize() const { return uncommittedSize; }
+
+private:
+	/// Commit済み領域の情報.
+	struct FencedRange
+	{
+		uint64_t fenceValue; ///< 領域の使用完了を示すフェンス値.
+		uint64_t end; ///< 領域の終端(解放後の先頭位置).
+		uint64_t size; ///< 領域のバイト数(アラインメントや折り返しによる隙間を含む).
+		size_t externalCount; ///< 同じフェンス値で解放される外部の領域の数.
+	};
+
+	uint64_t capacity = 0;
+	uint64_t head = 0; ///< 次に確保する位置.
+	uint64_t tail = 0; ///< 使用中の領域の先頭位置.
+	uint64_t usedSize = 0; ///< 使用中のバイト数.
+	uint64_t uncommittedSize = 0; ///< まだCommitされていないバイト数.
+	size_t uncommittedExternalCount = 0; ///< まだCommitされていない外部の領域の数.
+	std::deque<FencedRange> fenceList;
+};
+
+} // namespace Resource
+
+#endif // DX12TUTORIAL_SRC_RINGALLOCATOR_H_
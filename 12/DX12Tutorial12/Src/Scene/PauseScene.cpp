@@ -1,116 +1,103 @@
-/**
-* @file PauseScene.cpp
-*/
-#include "PauseScene.h"
-#include "../Graphics.h"
-#include "../PSO.h"
-#include "../GamePad.h"
-#include <DirectXMath.h>
-
-using namespace DirectX;
-
-/**
-* XvCgpZf[^.
-*/
-const Sprite::Cell cellList[] = {
-	{ XMFLOAT2(0.0f, 0.0f), XMFLOAT2(1.0f, 1.0f), XMFLOAT2(800, 600) },
-
-	{ XMFLOAT2(16.0f / 1024.0f, 48.0f / 512.0f), XMFLOAT2(480.0f / 1024.0f, 256.0f / 512.0f), XMFLOAT2(480, 256) },
-};
-
-/**
-*
-*/
-::Scene::ScenePtr PauseScene::Create()
-{
-	return ::Scene::ScenePtr(new PauseScene);
-}
-
-/**
-* RXgN^.
-*/
-PauseScene::PauseScene() : Scene(L"Pause")
-{
-}
-
-/**
-*
-*/
-bool PauseScene::Load(::Scene::Context&)
-{
-	Graphics::Graphics& graphics = Graphics::Graphics::Get();
-
-	graphics.texMap.Begin();
-	if (!graphics.texMap.LoadFromFile(texFont, L"Res/TextFont.png")) {
-		return false;
-	}
-	ID3D12CommandList* ppCommandLists[] = { graphics.texMap.End() };
-	graphics.commandQueue->ExecuteCommandLists(_countof(ppCommandLists), ppCommandLists);
-
-	cellFile = Sprite::LoadFromJsonFile(L"Res/Cell/CellFont.json");
-	animationFile = LoadAnimationFromJsonFile(L"Res/Anm/AnmTitle.json");
-
-	graphics.WaitForGpu();
-	graphics.texMap.ResetLoader();
-
-	static const char text[] = "PAUSE";
-	XMFLOAT3 textPos(400 - (_countof(text) - 2) * 16.0f, 400, 0.0f);
-	for (const char c : text) {
-		if (c >= ' ' && c < '`') {
-			sprFont.push_back(Sprite::Sprite(&animationFile[1], textPos, 0, XMFLOAT2(1, 1), XMFLOAT4(0.5f, 1.0f, 0.5f, 1.0f)));
-			sprFont.back().SetSeqIndex(c - ' ');
-			textPos.x += 32.0f;
-		}
-	}
-
-	time = 0.0f;
-
-	return true;
-}
-
-/**
-*
-*/
-bool PauseScene::Unload(::Scene::Context&)
-{
-	return true;
-}
-
-/**
-*
-*/
-int PauseScene::Update(::Scene::Context&, double delta)
-{
-	time += delta;
-	const float brightness = static_cast<float>(std::fabs(std::fmod(time, 2.0) - 1.0)) > 0.5f ? 1.0f : 0.0f;
-	for (auto& e : sprFont) {
-		e.color[0].w = brightness;
-		e.color[1].w = brightness;
-	}
-
-	for (Sprite::Sprite& sprite : sprFont) {
-		sprite.animeController.Update(delta);
-	}
-
-	const GamePad gamepad = GetGamePad(GamePadId_1P);
-	if (gamepad.buttonDown & GamePad::START) {
-		return ExitCode_Exit;
-	}
-	return ExitCode_Continue;
-}
-
-/**
-*
-*/
-void PauseScene::Draw(Graphics::Graphics& graphics) const
-{
-	Sprite::RenderingInfo spriteRenderingInfo;
-	spriteRenderingInfo.rtvHandle = graphics.GetRTVHandle();
-	spriteRenderingInfo.dsvHandle = graphics.GetDSVHandle();
-	spriteRenderingInfo.viewport = graphics.viewport;
-	spriteRenderingInfo.scissorRect = graphics.scissorRect;
-	spriteRenderingInfo.texDescHeap = graphics.csuDescriptorHeap.Get();
-	spriteRenderingInfo.matViewProjection = graphics.matViewProjection;
-
-	graphics.spriteRenderer.Draw(sprFont, cellFile->Get(0)->list.data(), GetPSO(PSOType_Sprite), texFont, spriteRenderingInfo);
-}
+/**
+* @file PauseScene.cpp
+*/
+#include "PauseScene.h"
+#include "../Graphics.h"
+#include "../PSO.h"
+#include "../GamePad.h"
+#include <DirectXMath.h>
+
+using namespace DirectX;
+
+/**
+* スプライト用セルデータ.
+*/
+const Sprite::Cell cellList[] = {
+	{ XMFLOAT2(0.0f, 0.0f), XMFLOAT2(1.0f, 1.0f), XMFLOAT2(800, 600) },
+
+	{ XMFLOAT2(16.0f / 1024.0f, 48.0f / 512.0f), XMFLOAT2(480.0f / 1024.0f, 256.0f / 512.0f), XMFLOAT2(480, 256) },
+};
+
+/**
+*
+*/
+::Scene::ScenePtr PauseScene::Create()
+{
+	return ::Scene::ScenePtr(new PauseScene);
+}
+
+/**
+* コンストラクタ.
+*/
+PauseScene::PauseScene() : Scene(L"Pause")
+{
+}
+
+/**
+*
+*/
+bool PauseScene::Load(::Scene::Context&)
+{
+	Graphics::Graphics& graphics = Graphics::Graphics::Get();
+
+	graphics.texMap.Begin();
+	if (!graphics.texMap.LoadIndexedFromFile(texFont, L"Res/TextFont.png")) {
+		return false;
+	}
+	if (!graphics.texMap.End()) {
+		return false;
+	}
+
+	cellFile = Sprite::LoadFromJsonFile(L"Res/Cell/CellFont.json");
+
+	static const char text[] = "PAUSE";
+	textPause = Sprite::Text(*cellFile->Get(0), ' ', XMFLOAT3(400 - (_countof(text) - 2) * 16.0f, 400, 0.0f), XMFLOAT2(1, 1), XMFLOAT4(0.5f, 1.0f, 0.5f, 1.0f));
+	textPause.SetText(text);
+
+	time = 0.0f;
+
+	return true;
+}
+
+/**
+*
+*/
+bool PauseScene::Unload(::Scene::Context&)
+{
+	return true;
+}
+
+/**
+*
+*/
+int PauseScene::Update(::Scene::Context&, double delta)
+{
+	time += delta;
+	const float brightness = static_cast<float>(std::fabs(std::fmod(time, 2.0) - 1.0)) > 0.5f ? 1.0f : 0.0f;
+	textPause.color[0].w = brightness;
+	textPause.color[1].w = brightness;
+
+	const GamePad gamepad = GetGamePad(GamePadId_1P);
+	if (gamepad.buttonDown & GamePad::START) {
+		return ExitCode_Exit;
+	}
+	return ExitCode_Continue;
+}
+
+/**
+*
+*/
+void PauseScene::Draw(Graphics::Graphics& graphics) const
+{
+	Sprite::RenderingInfo spriteRenderingInfo;
+	spriteRenderingInfo.rtvHandle = graphics.GetRTVHandle();
+	spriteRenderingInfo.dsvHandle = graphics.GetDSVHandle();
+	spriteRenderingInfo.viewport = graphics.viewport;
+	spriteRenderingInfo.scissorRect = graphics.scissorRect;
+	spriteRenderingInfo.texDescHeap = graphics.csuDescriptorHeap.GetHeap();
+	spriteRenderingInfo.matViewProjection = graphics.matViewProjection;
+
+	graphics.spriteRenderer.AddLayer([this, spriteRenderingInfo](Sprite::Layer& layer) {
+		layer.Draw(textPause, GetPSO(PSOType_IndexedSprite), texFont, spriteRenderingInfo);
+	});
+}
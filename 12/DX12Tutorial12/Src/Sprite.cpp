@@ -1,551 +1,2152 @@
-/**
-* @file Sprite.cpp
-*/
-#include "Sprite.h"
-#include "Texture.h"
-#include "PSO.h"
-#include "Json.h"
-#include "d3dx12.h"
-#include <memory>
-#include <iostream>
-
-using Microsoft::WRL::ComPtr;
-using namespace DirectX;
-
-namespace Sprite {
-
-namespace /* unnamed */ {
-
-/**
-* XvCg`p_f[^^.
-*/
-struct Vertex {
-	XMFLOAT3 position;
-	XMFLOAT4 color;
-	XMFLOAT2 texcoord;
-};
-
-XMFLOAT3 RotateZ(XMVECTOR c, float x, float y, float r)
-{
-	float fs, fc;
-	XMScalarSinCos(&fs, &fc, r);
-	const float rx = fc * x + fs * y;
-	const float ry = -fs * x + fc * y;
-	const XMVECTORF32 tmp{ rx, ry, 0.0f, 0.0f };
-	XMFLOAT3 ret;
-	XMStoreFloat3(&ret, XMVectorAdd(c, tmp));
-	return ret;
-}
-
-/**
-* ЂƂ̃XvCgf[^𒸓_obt@ɐݒ.
-*
-* @param sprite XvCgf[^.
-* @param v      _f[^`ރAhX.
-* @param offset XN[W.
-*/
-void AddVertex(const Sprite& sprite, const Cell* cell, const AnimationData& anm, Vertex* v, XMFLOAT2 offset)
-{
-	const XMVECTORF32 center{ offset.x + sprite.pos.x + cell->offset.x * sprite.scale.x, offset.y - sprite.pos.y - cell->offset.y * sprite.scale.y, sprite.pos.z, 0.0f };
-	const XMFLOAT2 halfSize{ cell->ssize.x * 0.5f * sprite.scale.x * anm.scale.x, cell->ssize.y * 0.5f * sprite.scale.y * anm.scale.y };
-
-	const XMVECTOR vcolor0 = XMVectorMultiply(XMLoadFloat4(&sprite.color[0]), XMLoadFloat4(&anm.color));
-	const XMVECTOR vcolor1 = XMVectorMultiply(XMLoadFloat4(&sprite.color[1]), XMLoadFloat4(&anm.color));
-	const float rot = sprite.rotation + anm.rotation;
-	v[0].position = RotateZ(center, -halfSize.x, halfSize.y, rot);
-	v[0].texcoord.x = cell->uv.x;
-	v[0].texcoord.y = cell->uv.y;
-	XMStoreFloat4(&v[0].color, vcolor0);
-
-	v[1].position = RotateZ(center, halfSize.x, halfSize.y, rot);
-	v[1].texcoord.x = cell->uv.x + cell->tsize.x;
-	v[1].texcoord.y = cell->uv.y;
-	XMStoreFloat4(&v[1].color, vcolor0);
-
-	v[2].position = RotateZ(center, halfSize.x, -halfSize.y, rot);
-	v[2].texcoord.x = cell->uv.x + cell->tsize.x;
-	v[2].texcoord.y = cell->uv.y + cell->tsize.y;
-	XMStoreFloat4(&v[2].color, vcolor1);
-
-	v[3].position = RotateZ(center, -halfSize.x, -halfSize.y, rot);
-	v[3].texcoord.x = cell->uv.x;
-	v[3].texcoord.y = cell->uv.y + cell->tsize.y;
-	XMStoreFloat4(&v[3].color, vcolor1);
-}
-
-} // unnamed namedpace
-
-Sprite::Sprite(const AnimationList* al, DirectX::XMFLOAT3 p, float rot, DirectX::XMFLOAT2 s, DirectX::XMFLOAT4 col) :
-	animeController(al),
-	actController(),
-	collisionId(-1),
-	pos(p),
-	rotation(rot),
-	scale(s),
-	color{ col, col },
-	velocity{ 0, 0 }
-{
-}
-
-Renderer::Renderer() :
-	maxSpriteCount(0),
-	frameBufferCount(0),
-	currentFrameIndex(-1)
-{
-}
-
-/**
-* Renderer.
-*
-* @param device           D3DfoCX.
-* @param frameBufferCount t[obt@̐.
-* @param maxSprite        `łőXvCg.
-*
-* @retval true  .
-* @retval false s.
-*/
-bool Renderer::Init(ComPtr<ID3D12Device> device, int numFrameBuffer, int maxSprite, Resource::ResourceLoader& resourceLoader)
-{
-	maxSpriteCount = maxSprite;
-	frameBufferCount = numFrameBuffer;
-
-	frameResourceList.resize(numFrameBuffer);
-	for (int i = 0; i < frameBufferCount; ++i) {
-		if (FAILED(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&frameResourceList[i].commandAllocator)))) {
-			return false;
-		}
-		if (FAILED(device->CreateCommittedResource(
-			&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
-			D3D12_HEAP_FLAG_NONE,
-			&CD3DX12_RESOURCE_DESC::Buffer(maxSpriteCount * sizeof(Vertex)),
-			D3D12_RESOURCE_STATE_GENERIC_READ,
-			nullptr,
-			IID_PPV_ARGS(&frameResourceList[i].vertexBuffer)
-		))) {
-			return false;
-		}
-		frameResourceList[i].vertexBuffer->SetName(L"Sprite Vertex Buffer");
-		CD3DX12_RANGE range(0, 0);
-		if (FAILED(frameResourceList[i].vertexBuffer->Map(0, &range, &frameResourceList[i].vertexBufferGPUAddress))) {
-			return false;
-		}
-		frameResourceList[i].vertexBufferView.BufferLocation = frameResourceList[i].vertexBuffer->GetGPUVirtualAddress();
-		frameResourceList[i].vertexBufferView.StrideInBytes = sizeof(Vertex);
-		frameResourceList[i].vertexBufferView.SizeInBytes = static_cast<UINT>(maxSpriteCount * sizeof(Vertex));
-	}
-
-	if (FAILED(device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, frameResourceList[0].commandAllocator.Get(), nullptr, IID_PPV_ARGS(&commandList)))) {
-		return false;
-	}
-	if (FAILED(commandList->Close())) {
-		return false;
-	}
-
-	const int indexListSize = static_cast<int>(maxSpriteCount * 6 * sizeof(DWORD));
-#if 1
-	if (FAILED(device->CreateCommittedResource(
-		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
-		D3D12_HEAP_FLAG_NONE,
-		&CD3DX12_RESOURCE_DESC::Buffer(indexListSize),
-		D3D12_RESOURCE_STATE_GENERIC_READ,
-		nullptr,
-		IID_PPV_ARGS(&indexBuffer)
-	))) {
-		return false;
-	}
-	indexBuffer->SetName(L"Sprite Index Buffer");
-	CD3DX12_RANGE range(0, 0);
-	void* tmpIndexBufferAddress;
-	if (FAILED(indexBuffer->Map(0, &range, &tmpIndexBufferAddress))) {
-		return false;
-	}
-	DWORD* pIndexBuffer = static_cast<DWORD*>(tmpIndexBufferAddress);
-	for (size_t i = 0; i < maxSpriteCount; ++i) {
-		pIndexBuffer[i * 6 + 0] = i * 4 + 0;
-		pIndexBuffer[i * 6 + 1] = i * 4 + 1;
-		pIndexBuffer[i * 6 + 2] = i * 4 + 2;
-		pIndexBuffer[i * 6 + 3] = i * 4 + 2;
-		pIndexBuffer[i * 6 + 4] = i * 4 + 3;
-		pIndexBuffer[i * 6 + 5] = i * 4 + 0;
-	}
-	indexBuffer->Unmap(0, nullptr);
-#else
-	std::vector<DWORD> indexList;
-	indexList.resize(maxSpriteCount * 6);
-	for (size_t i = 0; i < maxSpriteCount; ++i) {
-		indexList[i * 6 + 0] = i * 4 + 0;
-		indexList[i * 6 + 1] = i * 4 + 1;
-		indexList[i * 6 + 2] = i * 4 + 2;
-		indexList[i * 6 + 3] = i * 4 + 2;
-		indexList[i * 6 + 4] = i * 4 + 3;
-		indexList[i * 6 + 5] = i * 4 + 0;
-	}
-
-	D3D12_SUBRESOURCE_DATA subresource = { indexList.data(), indexListSize, indexListSize };
-	if (!resourceLoader.Upload(indexBuffer, CD3DX12_RESOURCE_DESC::Buffer(indexListSize), subresource, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, L"Sprite Index Buffer")) {
-		return false;
-	}
-#endif
-	indexBufferView.BufferLocation = indexBuffer->GetGPUVirtualAddress();
-	indexBufferView.SizeInBytes = indexListSize;
-	indexBufferView.Format = DXGI_FORMAT_R32_UINT;
-
-	return true;
-}
-
-/**
-* XvCg̕`Jn.
-*
-* @param frameIndex ݂̃t[obt@̃CfbNX.
-*
-* @retval true `\ȏԂɂȂ.
-* @retval false `\ȏԂւ̑JڂɎs.
-*/
-bool Renderer::Begin(int frameIndex)
-{
-	if (currentFrameIndex >= 0) {
-		return false;
-	}
-
-	currentFrameIndex = frameIndex;
-	FrameResource& fr = frameResourceList[currentFrameIndex];
-
-	if (FAILED(fr.commandAllocator->Reset())) {
-		return false;
-	}
-	if (FAILED(commandList->Reset(fr.commandAllocator.Get(), nullptr))) {
-		return false;
-	}
-	spriteCount = 0;
-	return true;
-}
-
-/**
-* XvCg`.
-*
-* @param spriteList `悷XvCg̃Xg.
-* @param pso        `ɎgpPSO.
-* @param texture    `ɎgpeNX`.
-* @param info       `.
-*
-* @retval true  R}hXg쐬.
-* @retval false R}hXg쐬s.
-*/
-bool Renderer::Draw(const std::vector<Sprite>& spriteList, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, RenderingInfo& info)
-{
-	if (spriteList.empty()) {
-		return true;
-	}
-	return Draw(&*spriteList.begin(), (&*spriteList.begin()) + spriteList.size(), cellList, pso, texture, info);
-}
-
-bool Renderer::Draw(const Sprite* first, const Sprite* last, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, RenderingInfo& info)
-{
-	if (currentFrameIndex < 0) {
-		return false;
-	}
-	if (first == last) {
-		return true;
-	}
-
-	FrameResource& fr = frameResourceList[currentFrameIndex];
-
-	commandList->SetGraphicsRootSignature(pso.rootSignature.Get());
-	commandList->SetPipelineState(pso.pso.Get());
-	ID3D12DescriptorHeap* heapList[] = { info.texDescHeap };
-	commandList->SetDescriptorHeaps(_countof(heapList), heapList);
-	commandList->SetGraphicsRootDescriptorTable(0, texture.handle);
-	commandList->SetGraphicsRoot32BitConstants(1, 16, &info.matViewProjection, 0);
-	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	commandList->IASetVertexBuffers(0, 1, &fr.vertexBufferView);
-	commandList->IASetIndexBuffer(&indexBufferView);
-	commandList->OMSetRenderTargets(1, &info.rtvHandle, FALSE, &info.dsvHandle);
-	commandList->RSSetViewports(1, &info.viewport);
-	commandList->RSSetScissorRects(1, &info.scissorRect);
-
-	const XMFLOAT2 offset(-(info.viewport.Width * 0.5f), info.viewport.Height * 0.5f);
-	const int remainingSprite = (fr.vertexBufferView.SizeInBytes / fr.vertexBufferView.StrideInBytes / 4) - spriteCount;
-	int numSprite = 0;
-	Vertex* v = static_cast<Vertex*>(fr.vertexBufferGPUAddress) + (spriteCount * 4);
-	for (const Sprite* sprite = first; sprite != last; ++sprite) {
-		if (sprite->scale.x == 0 || sprite->scale.y == 0) {
-			continue;
-		}
-		const Cell* cell = cellList + sprite->GetCellIndex();
-		AddVertex(*sprite, cell, sprite->animeController.GetData(), v, offset);
-		++numSprite;
-		if (numSprite >= remainingSprite) {
-			break;
-		}
-		v += 4;
-	}
-	commandList->DrawIndexedInstanced(numSprite * 6, 1, 0, spriteCount * 4, 0);
-	spriteCount += numSprite;
-
-	return true;
-}
-
-/**
-* XvCg̕`I.
-*
-* @retval true  R}hXg쐬.
-* @retval false R}hXg쐬s.
-*/
-bool Renderer::End()
-{
-	currentFrameIndex = -1;
-	if (FAILED(commandList->Close())) {
-		return false;
-	}
-	return true;
-}
-
-/**
-* R}hXg擾.
-*
-* @return ID3D12GraphicsCommandListC^[tFCXւ̃|C^.
-*/
-ID3D12GraphicsCommandList* Renderer::GetCommandList()
-{
-	return commandList.Get();
-}
-
-/**
-* FileC^[tFCX̎NX.
-*/
-class FileImpl : public File
-{
-public:
-	FileImpl() {}
-	virtual ~FileImpl() {}
-	virtual const CellList* Get(uint32_t no) const {
-		if (no >= clList.size()) {
-			return nullptr;
-		}
-		return &clList[no];
-	}
-	virtual size_t Size() const { return clList.size(); }
-
-	std::vector<CellList> clList;
-};
-
-/**
-* t@CZXgǂݍ.
-*
-* @param filename t@C.
-*
-* @return ǂݍ񂾃ZXg.
-*         ǂݍݎs̏ꍇnullptrԂ.
-*
-* JSONtH[}bĝ͎Ƃ:
-* <pre>
-* [
-*   {
-*     "name" : "ZXg",
-*     "texsize" : [w, h],
-*     "list" : [
-*       {
-*         "uv" : [u, v],
-*         "tsize" : [tw, th],
-*         "ssize" : [sw, sh]
-*       },
-*       ...
-*     ]
-*   },
-*   ...
-* ]
-* </pre>
-*/
-FilePtr LoadFromJsonFile(const wchar_t* filename)
-{
-	struct HandleHolder {
-		explicit HandleHolder(HANDLE h) : handle(h) {}
-		~HandleHolder() { if (handle != INVALID_HANDLE_VALUE) { CloseHandle(handle); } }
-		HANDLE handle;
-		operator HANDLE() { return handle; }
-		operator HANDLE() const { return handle; }
-	};
-
-	std::shared_ptr<FileImpl> af(new FileImpl);
-
-	HandleHolder h(CreateFileW(filename, GENERIC_READ, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
-	if (h == INVALID_HANDLE_VALUE) {
-		return af;
-	}
-	LARGE_INTEGER size;
-	if (!GetFileSizeEx(h, &size)) {
-		return af;
-	}
-	if (size.QuadPart > std::numeric_limits<size_t>::max()) {
-		return af;
-	}
-	std::vector<char> buffer;
-	buffer.resize(static_cast<size_t>(size.QuadPart));
-	DWORD readBytes;
-	if (!ReadFile(h, &buffer[0], buffer.size(), &readBytes, nullptr)) {
-		return af;
-	}
-	const Json::Value json = Json::Parse(buffer.data());
-	if (json.type != Json::Type::Array) {
-		return af;
-	}
-
-	for (const Json::Value& e : json.array) {
-		if (e.type != Json::Type::Object) {
-			break;
-		}
-		const Json::Object::const_iterator itrName = e.object.find("name");
-		if (itrName == e.object.end() || itrName->second.type != Json::Type::String) {
-			break;
-		}
-		const Json::Object::const_iterator itrTexSize = e.object.find("texsize");
-		if (itrTexSize == e.object.end() || itrTexSize->second.type != Json::Type::Array || itrTexSize->second.array.size() < 2) {
-			break;
-		}
-		const XMVECTOR texsize = XMVectorReciprocal({ static_cast<float>(itrTexSize->second.array[0].number), static_cast<float>(itrTexSize->second.array[1].number) });
-		CellList al;
-		al.name = itrName->second.string;
-		const Json::Object::const_iterator itrList = e.object.find("list");
-		if (itrList == e.object.end() || itrList->second.type != Json::Type::Array) {
-			break;
-		}
-		for (const Json::Value& data : itrList->second.array) {
-			if (data.type != Json::Type::Object) {
-				return af;
-			}
-			Cell cell;
-			const Json::Array& uv = data.object.find("uv")->second.array;
-			cell.uv.x = uv.size() > 0 ? static_cast<float>(uv[0].number) : 0.0f;
-			cell.uv.y = uv.size() > 1 ? static_cast<float>(uv[1].number) : 0.0f;
-			XMStoreFloat2(&cell.uv, XMVectorMultiply(XMLoadFloat2(&cell.uv), texsize));
-			const Json::Array& tsize = data.object.find("tsize")->second.array;
-			cell.tsize.x = tsize.size() > 0 ? static_cast<float>(tsize[0].number) : 0.0f;
-			cell.tsize.y = tsize.size() > 1 ? static_cast<float>(tsize[1].number) : 0.0f;
-			XMStoreFloat2(&cell.tsize, XMVectorMultiply(XMLoadFloat2(&cell.tsize), texsize));
-			const Json::Array& ssize = data.object.find("ssize")->second.array;
-			cell.ssize.x = ssize.size() > 0 ? static_cast<float>(ssize[0].number) : 0.0f;
-			cell.ssize.y = ssize.size() > 1 ? static_cast<float>(ssize[1].number) : 0.0f;
-			cell.offset = XMFLOAT2(0, 0);
-			cell.xadvance = cell.ssize.x;
-			al.list.push_back(cell);
-		}
-		af->clList.push_back(al);
-	}
-
-	return af;
-}
-
-/**
-* tHgt@Cǂݍ.
-*
-* @param filename tHgt@C.
-*
-* @retval true  ǂݍݐ.
-* @retval false ǂݍݎs.
-*/
-CellList LoadFontFromFile(const wchar_t* filename)
-{
-  std::unique_ptr<std::remove_pointer<HANDLE>::type, decltype(&CloseHandle)> h(
-    CreateFileW(filename, GENERIC_READ, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr),
-    CloseHandle
-  );
-  if (h.get() == INVALID_HANDLE_VALUE) {
-    return {};
-  }
-  LARGE_INTEGER size;
-  if (!GetFileSizeEx(h.get(), &size)) {
-    return {};
-  }
-  std::string buffer;
-  buffer.resize(static_cast<size_t>(size.QuadPart));
-  DWORD readBytes;
-  if (!ReadFile(h.get(), &buffer[0], buffer.size(), &readBytes, nullptr)) {
-    return {};
-  }
-
-  int line = 1;
-  char name[128];
-  size_t nextOffset = 0;
-  int ret = sscanf(&buffer[nextOffset], "info face=%127s size=%*d bold=%*d italic=%*d charset=%*s"
-    " unicode=%*d stretchH=%*d smooth=%*d aa=%*d padding=%*d,%*d,%*d,%*d spacing=%*d,%*d", name);
-  if (ret < 1) {
-	  std::cerr << "ERROR: '" << filename << "'̓ǂݍ݂Ɏs(line=" << line << ")" << std::endl;
-	  return {};
-  }
-  ++line;
-
-  nextOffset = buffer.find('\n', nextOffset) + 1;
-  XMFLOAT2 scale;
-  ret = sscanf(&buffer[nextOffset], " common lineHeight=%*d base=%*d scaleW=%f scaleH=%f pages=%*d packed=%*d", &scale.x, &scale.y);
-  if (ret < 2) {
-    std::cerr << "ERROR: '" << filename << "'̓ǂݍ݂Ɏs(line=" << line << ")" << std::endl;
-    return {};
-  }
-  const XMFLOAT2 reciprocalScale(1.0f / scale.x, 1.0f / scale.y);
-  ++line;
-
-  nextOffset = buffer.find('\n', nextOffset) + 1;
-  ret = sscanf(&buffer[nextOffset], " page id=%*d file=%*s");
-  ++line;
-
-  nextOffset = buffer.find('\n', nextOffset) + 1;
-  int charCount;
-  ret = sscanf(&buffer[nextOffset], " chars count=%d", &charCount);
-  if (ret < 1) {
-    std::cerr << "ERROR: '" << filename << "'̓ǂݍ݂Ɏs(line=" << line << ")" << std::endl;
-    return {};
-  }
-  ++line;
-
-  CellList fontList;
-  fontList.list.resize(256);
-  for (int i = 0; i < charCount; ++i) {
-    nextOffset = buffer.find('\n', nextOffset);
-    if (nextOffset == std::string::npos) {
-      break;
-    }
-    ++nextOffset;
-
-    unsigned int charCode;
-    Cell cell;
-    XMFLOAT2 uv, size, offset;
-	float xadvance;
-    ret = sscanf(&buffer[nextOffset], " char id=%u x=%f y=%f width=%f height=%f xoffset=%f yoffset=%f xadvance=%f page=%*d chnl=%*d", &charCode, &uv.x, &uv.y, &size.x, &size.y, &offset.x, &offset.y, &xadvance);
-    if (ret < 8) {
-      std::cerr << "ERROR: '" << filename << "'̓ǂݍ݂Ɏs(line=" << line << ")" << std::endl;
-      return {};
-    }
-    cell.uv = XMFLOAT2(uv.x * reciprocalScale.x, uv.y * reciprocalScale.y);
-    cell.tsize = XMFLOAT2(size.x * reciprocalScale.x, size.y * reciprocalScale.y);
-    cell.ssize = XMFLOAT2(size.x, size.y);
-	cell.offset = XMFLOAT2(size.x * 0.5f + offset.x, size.y * 0.5f + offset.y);
-	cell.xadvance = xadvance;
-    if (charCode >= 0 && charCode < fontList.list.size()) {
-      fontList.list[charCode] = cell;
-    }
-    ++line;
-  }
-  fontList.name.assign(name + 1);
-  fontList.name.pop_back();
-  return fontList;
-}
-
-/**
-* ̕`͈͂̉擾.
-*
-* @param cellList tHgi[ĂZXg.
-* @param text     .
-*
-* @return ̉.
-*/
-float GetTextWidth(const CellList& cellList, const char* text)
-{
-	float width = 0;
-	while (*text != '\0') {
-		width += cellList.list[*text].xadvance;
-		++text;
-	}
-	return width;
-}
-
-} // namespace Sprite
+/**
+* @file Sprite.cpp
+*/
+#include "Sprite.h"
+#include "SpriteVertex.h"
+#include "Texture.h"
+#include "PSO.h"
+#include "Json.h"
+#include "d3dx12.h"
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+
+using Microsoft::WRL::ComPtr;
+using namespace DirectX;
+
+namespace Sprite {
+
+namespace /* unnamed */ {
+
+/// Renderer::RecordDrawで頂点の書き込みを複数のスレッドで分担する最小のスプライト数. 少ない場合はスレッドを起こす時間の方が長くなる.
+const size_t minParallelSpriteCount = 1024;
+
+/// Renderer::RecordDrawで1つのスレッドが一度に書き込むスプライト数.
+const size_t parallelGrainSize = 256;
+static_assert(parallelGrainSize % batchSize == 0, "parallelGrainSize must be a multiple of batchSize.");
+
+/**
+* 範囲の配列を先頭の位置順に並べ、重なる範囲と隣接する範囲を1つにまとめる.
+*
+* @param rangeList (先頭, 終端)の配列.
+*/
+void MergeRanges(std::vector<std::pair<size_t, size_t>>& rangeList)
+{
+	if (rangeList.empty()) {
+		return;
+	}
+	std::sort(rangeList.begin(), rangeList.end());
+	size_t n = 0;
+	for (size_t i = 1; i < rangeList.size(); ++i) {
+		if (rangeList[i].first <= rangeList[n].second) {
+			rangeList[n].second = std::max(rangeList[n].second, rangeList[i].second);
+		} else {
+			rangeList[++n] = rangeList[i];
+		}
+	}
+	rangeList.resize(n + 1);
+}
+
+/**
+* 頂点データ形式の1頂点のバイト数を取得する.
+*/
+UINT GetVertexStride(VertexFormat format)
+{
+	return format == VertexFormat_Compact ? sizeof(CompactVertex) : sizeof(Vertex);
+}
+
+/**
+* 1文字分のグリフを頂点バッファとインデックスバッファに設定.
+*
+* グリフは回転しないため、AddVertexBatchのようにまとめて計算せず1文字ずつ計算する.
+* 頂点カラーはcolor[0]を上端、color[1]を下端として補間する.
+*
+* @tparam T 頂点データ型. VertexまたはCompactVertex.
+*
+* @param text       グリフを含む文字列.
+* @param glyph      設定するグリフ.
+* @param vertexOut  頂点データの書き込み先.
+* @param indexOut   インデックスデータの書き込み先.
+* @param baseVertex 最初の頂点の頂点バッファ内での番号.
+* @param offset     スクリーン左上座標.
+*
+* @return 設定した頂点数.
+*/
+template<typename T>
+uint32_t AddGlyphVertex(const Text& text, const Text::Glyph& glyph, WriteCombiner& vertexOut, WriteCombiner& indexOut, uint32_t baseVertex, XMFLOAT2 offset)
+{
+	const Cell& cell = *glyph.cell;
+	const XMFLOAT2* mesh = GetMesh(cell);
+	const uint32_t vertexCount = GetMeshVertexCount(cell);
+	const float cx = offset.x + text.pos.x + (glyph.x + cell.offset.x) * text.scale.x;
+	const float cy = offset.y - text.pos.y - cell.offset.y * text.scale.y;
+	const float sx = cell.ssize.x * text.scale.x;
+	const float sy = cell.ssize.y * text.scale.y;
+	const XMVECTOR c0 = Premultiply(XMLoadFloat4(&text.color[0]), text.blendMode);
+	const XMVECTOR dc = XMVectorSubtract(Premultiply(XMLoadFloat4(&text.color[1]), text.blendMode), c0);
+	Vertex tmp[SpriteMesh::maxVertexCount];
+	for (uint32_t i = 0; i < vertexCount; ++i) {
+		const XMFLOAT2& m = mesh[i];
+		tmp[i].position = XMFLOAT3(cx + (m.x - 0.5f) * sx, cy + (0.5f - m.y) * sy, text.pos.z);
+		XMStoreFloat4(&tmp[i].color, XMVectorMultiplyAdd(dc, XMVectorReplicate(m.y), c0));
+		tmp[i].texcoord = XMFLOAT2(cell.uv.x + cell.tsize.x * m.x, cell.uv.y + cell.tsize.y * m.y);
+		tmp[i].palette = static_cast<float>(text.palette);
+	}
+
+	const size_t vertexBytes = vertexCount * sizeof(T);
+	const size_t indexBytes = (vertexCount - 2) * 3 * sizeof(DWORD);
+	StoreVertex(tmp, vertexCount, static_cast<T*>(vertexOut.Reserve(vertexBytes)));
+	DWORD* index = static_cast<DWORD*>(indexOut.Reserve(indexBytes));
+	for (uint32_t n = 1; n < vertexCount - 1; ++n) {
+		index[0] = baseVertex;
+		index[1] = baseVertex + n;
+		index[2] = baseVertex + n + 1;
+		index += 3;
+	}
+	vertexOut.Commit(vertexBytes);
+	indexOut.Commit(indexBytes);
+	return vertexCount;
+}
+
+/// ビューポートの外側で、スプライトを表示対象として残す幅(ピクセル).
+const float cullingMargin = 16.0f;
+
+/**
+* 表示判定に使う矩形を取得する.
+*
+* @param viewport 描画に使用するビューポート.
+*
+* @return スプライトの座標系での(左, 上, 右, 下). ビューポートをcullingMarginだけ広げた範囲.
+*/
+XMVECTOR GetCullingBounds(const D3D12_VIEWPORT& viewport)
+{
+	return XMVectorSet(-cullingMargin, -cullingMargin, viewport.Width + cullingMargin, viewport.Height + cullingMargin);
+}
+
+/**
+* 最大batchSize個のスプライトが表示範囲に入るかどうかを調べる.
+*
+* スプライトを包む矩形を4スプライト分同時に計算して、表示範囲と比較する.
+* 回転しているスプライトは、回転角によらず包み込めるように、対角線の長さを幅と高さに使う.
+* セルの形状はセルの矩形内にあるため、形状を持つセルも矩形で判定してよい.
+*
+* @param spriteList スプライトデータの配列.
+* @param cellList   各スプライトのセルデータの配列.
+* @param count      スプライトの数. 1以上batchSize以下.
+* @param bounds     GetCullingBoundsで取得した表示範囲.
+*
+* @return 表示範囲に入るスプライトのビットを1にした値. ビット0がspriteList[0]に対応する.
+*/
+uint32_t TestVisibility(const Sprite* const* spriteList, const Cell* const* cellList, size_t count, FXMVECTOR bounds)
+{
+	enum {
+		Lane_CenterX, Lane_CenterY,
+		Lane_Width, Lane_Height,
+		Lane_Rotation,
+		countof_Lane
+	};
+	alignas(16) float lane[countof_Lane][batchSize] = {};
+	for (size_t i = 0; i < count; ++i) {
+		const Sprite& sprite = *spriteList[i];
+		const Cell& cell = *cellList[i];
+		const AnimationData& anm = sprite.animeController.GetData();
+		lane[Lane_CenterX][i] = sprite.pos.x + cell.offset.x * sprite.scale.x;
+		lane[Lane_CenterY][i] = sprite.pos.y + cell.offset.y * sprite.scale.y;
+		lane[Lane_Width][i] = cell.ssize.x * sprite.scale.x * anm.scale.x;
+		lane[Lane_Height][i] = cell.ssize.y * sprite.scale.y * anm.scale.y;
+		lane[Lane_Rotation][i] = sprite.rotation + anm.rotation;
+	}
+	const XMVECTOR cx = LoadLane(lane[Lane_CenterX]);
+	const XMVECTOR cy = LoadLane(lane[Lane_CenterY]);
+	const XMVECTOR half = XMVectorReplicate(0.5f);
+	XMVECTOR ex = XMVectorMultiply(XMVectorAbs(LoadLane(lane[Lane_Width])), half);
+	XMVECTOR ey = XMVectorMultiply(XMVectorAbs(LoadLane(lane[Lane_Height])), half);
+	const XMVECTOR rotated = XMVectorNotEqual(LoadLane(lane[Lane_Rotation]), XMVectorZero());
+	const XMVECTOR radius = XMVectorSqrt(XMVectorMultiplyAdd(ex, ex, XMVectorMultiply(ey, ey)));
+	ex = XMVectorSelect(ex, radius, rotated);
+	ey = XMVectorSelect(ey, radius, rotated);
+
+	XMVECTOR visible = XMVectorGreaterOrEqual(XMVectorAdd(cx, ex), XMVectorSplatX(bounds));
+	visible = XMVectorAndInt(visible, XMVectorGreaterOrEqual(XMVectorAdd(cy, ey), XMVectorSplatY(bounds)));
+	visible = XMVectorAndInt(visible, XMVectorLessOrEqual(XMVectorSubtract(cx, ex), XMVectorSplatZ(bounds)));
+	visible = XMVectorAndInt(visible, XMVectorLessOrEqual(XMVectorSubtract(cy, ey), XMVectorSplatW(bounds)));
+	alignas(16) uint32_t result[batchSize];
+	XMStoreInt4(result, visible);
+	uint32_t bits = 0;
+	for (size_t i = 0; i < count; ++i) {
+		if (result[i]) {
+			bits |= 1U << i;
+		}
+	}
+	return bits;
+}
+
+/**
+* 表示するスプライトを順番に処理する.
+*
+* 拡大率が0のスプライトとvisibleMaskの値が0のスプライトを除いてから、batchSize個ずつTestVisibilityで判定する.
+*
+* @param first       スプライト配列の先頭.
+* @param last        スプライト配列の終端.
+* @param visibleMask スプライト毎の表示フラグ. nullptrなら全て表示対象とする.
+* @param cellList    セルデータの配列.
+* @param bounds      GetCullingBoundsで取得した表示範囲.
+* @param stats       除外したスプライトの数を加算する統計情報.
+* @param func        表示するスプライトとそのセルを受け取る関数. falseを返すと処理を中断する.
+*/
+template<typename F>
+void ForEachVisibleSprite(const Sprite* first, const Sprite* last, const uint8_t* visibleMask, const Cell* cellList, FXMVECTOR bounds, RenderingStatistics& stats, F func)
+{
+	const Sprite* spriteList[batchSize];
+	const Cell* batchCellList[batchSize];
+	size_t count = 0;
+	for (const Sprite* sprite = first; sprite != last || count > 0;) {
+		if (sprite != last) {
+			if (visibleMask && !visibleMask[sprite - first]) {
+				++stats.maskedCount;
+			} else if (sprite->scale.x == 0 || sprite->scale.y == 0) {
+				++stats.zeroScaleCount;
+			} else {
+				spriteList[count] = sprite;
+				batchCellList[count] = cellList + sprite->GetCellIndex();
+				++count;
+			}
+			++sprite;
+			if (count < batchSize && sprite != last) {
+				continue;
+			}
+		}
+		const uint32_t visible = count ? TestVisibility(spriteList, batchCellList, count, bounds) : 0;
+		for (size_t i = 0; i < count; ++i) {
+			if (!(visible & (1U << i))) {
+				++stats.culledCount;
+			} else if (!func(*spriteList[i], *batchCellList[i])) {
+				return;
+			}
+		}
+		count = 0;
+	}
+}
+
+/**
+* 表示するグリフを順番に処理する.
+*
+* 拡大率が0の文字列は全てのグリフを除外する. グリフは回転しないため、セルの矩形をそのまま表示範囲と比較する.
+*
+* @param text   グリフを含む文字列.
+* @param bounds GetCullingBoundsで取得した表示範囲.
+* @param stats  除外したグリフの数を加算する統計情報.
+* @param func   表示するグリフを受け取る関数.
+*/
+template<typename F>
+void ForEachVisibleGlyph(const Text& text, FXMVECTOR bounds, RenderingStatistics& stats, F func)
+{
+	const std::vector<Text::Glyph>& glyphList = text.GetGlyphList();
+	if (text.scale.x == 0 || text.scale.y == 0) {
+		stats.zeroScaleCount += static_cast<uint32_t>(glyphList.size());
+		return;
+	}
+	XMFLOAT4 b;
+	XMStoreFloat4(&b, bounds);
+	for (const Text::Glyph& glyph : glyphList) {
+		const Cell& cell = *glyph.cell;
+		const float cx = text.pos.x + (glyph.x + cell.offset.x) * text.scale.x;
+		const float cy = text.pos.y + cell.offset.y * text.scale.y;
+		const float ex = std::abs(cell.ssize.x * text.scale.x) * 0.5f;
+		const float ey = std::abs(cell.ssize.y * text.scale.y) * 0.5f;
+		if (cx + ex < b.x || cy + ey < b.y || cx - ex > b.z || cy - ey > b.w) {
+			++stats.culledCount;
+		} else {
+			func(glyph);
+		}
+	}
+}
+
+/// 頂点、インデックス、インスタンスデータを書き込むアップロードバッファの1ページのバイト数.
+const UINT64 arenaPageSize = 1024 * 1024;
+
+/// 静的バッチのバッファを配置するデフォルトヒープの1つのID3D12Heapのバイト数.
+const UINT64 staticBufferHeapSize = 1024 * 1024;
+
+/**
+* バッファ内のオフセットを、StructuredBufferに必要な境界に揃える.
+*/
+size_t AlignInstanceBufferOffset(size_t offset)
+{
+	const size_t alignment = D3D12_RAW_UAV_SRV_BYTE_ALIGNMENT;
+	return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+* ソートキーに使う番号を取得する.
+*
+* @param list 番号を割り当て済みのポインタの配列. pが含まれていなければ末尾に追加する.
+* @param p    番号を取得するポインタ.
+*
+* @return listにおけるpの位置.
+*/
+template<typename T>
+uint32_t GetSortKeyIndex(std::vector<const T*>& list, const T* p)
+{
+	const auto itr = std::find(list.begin(), list.end(), p);
+	if (itr != list.end()) {
+		return static_cast<uint32_t>(itr - list.begin());
+	}
+	list.push_back(p);
+	return static_cast<uint32_t>(list.size() - 1);
+}
+
+/**
+* 2つの描画情報が同じかどうか調べる.
+*/
+bool IsSameRenderingInfo(const RenderingInfo& lhs, const RenderingInfo& rhs)
+{
+	return lhs.rtvHandle.ptr == rhs.rtvHandle.ptr && lhs.dsvHandle.ptr == rhs.dsvHandle.ptr &&
+		memcmp(&lhs.viewport, &rhs.viewport, sizeof(D3D12_VIEWPORT)) == 0 &&
+		memcmp(&lhs.scissorRect, &rhs.scissorRect, sizeof(D3D12_RECT)) == 0 &&
+		lhs.texDescHeap == rhs.texDescHeap &&
+		memcmp(&lhs.matViewProjection, &rhs.matViewProjection, sizeof(XMFLOAT4X4)) == 0;
+}
+
+/**
+* スプライトを不透明パスで描画できるか調べる.
+*
+* セルが完全に不透明で、アルファ合成かつ頂点カラーのアルファが1なら、合成しなくても同じ結果になる.
+*/
+bool IsOpaqueSprite(const Sprite& sprite, const Cell& cell)
+{
+	if (!cell.opaque || sprite.blendMode != BlendMode_Alpha) {
+		return false;
+	}
+	const float alpha = sprite.animeController.GetData().color.w;
+	return sprite.color[0].w * alpha >= 1.0f && sprite.color[1].w * alpha >= 1.0f;
+}
+
+/**
+* 現在の時刻を取得する.
+*
+* @return 任意の時点からの経過時間(秒).
+*/
+double GetTime()
+{
+	static const double frequency = [] {
+		LARGE_INTEGER i;
+		QueryPerformanceFrequency(&i);
+		return static_cast<double>(i.QuadPart);
+	}();
+	LARGE_INTEGER i;
+	QueryPerformanceCounter(&i);
+	return static_cast<double>(i.QuadPart) / frequency;
+}
+
+/**
+* スコープを抜けるまでの経過時間を加算するクラス.
+*/
+class ScopedTimer
+{
+public:
+	explicit ScopedTimer(double& t) : total(t), startTime(GetTime()) {}
+	~ScopedTimer() { total += GetTime() - startTime; }
+	ScopedTimer(const ScopedTimer&) = delete;
+	ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+	double& total;
+	double startTime;
+};
+
+/**
+* レイヤーの統計情報を加算する.
+*
+* 時間の項目は加算しない.
+*/
+void AddStatistics(RenderingStatistics& total, const RenderingStatistics& stats)
+{
+	total.drawCallCount += stats.drawCallCount;
+	total.spriteCount += stats.spriteCount;
+	total.maskedCount += stats.maskedCount;
+	total.zeroScaleCount += stats.zeroScaleCount;
+	total.culledCount += stats.culledCount;
+	total.drawnCount += stats.drawnCount;
+	total.stateChangeCount += stats.stateChangeCount;
+	total.textureSwitchCount += stats.textureSwitchCount;
+	total.vertexBytes += stats.vertexBytes;
+}
+
+} // unnamed namedpace
+
+Sprite::Sprite(const AnimationList* al, DirectX::XMFLOAT3 p, float rot, DirectX::XMFLOAT2 s, DirectX::XMFLOAT4 col) :
+	animeController(al),
+	actController(),
+	collisionId(-1),
+	pos(p),
+	rotation(rot),
+	scale(s),
+	color{ col, col },
+	blendMode(BlendMode_Alpha),
+	palette(0),
+	velocity{ 0, 0 }
+{
+}
+
+Renderer::Renderer() :
+	frameBufferCount(0),
+	currentFrameIndex(-1),
+	fenceValue(0),
+	layerCount(0),
+	uploadLayer(nullptr),
+	statistics(),
+	statisticsLogCount(0),
+	isUploadStaged(true)
+{
+}
+
+/**
+* Rendererを初期化する.
+*
+* @param device           D3Dデバイス.
+* @param frameBufferCount フレームバッファの数.
+* @param resourceLoader   リソース読み込みオブジェクト.
+* @param bufferHeap       頂点、インデックス、インスタンスデータを書き込むバッファを配置するアップロードヒープ.
+*
+* 頂点、インデックス、インスタンスデータは毎フレームarenaから確保する. arenaのページは描画時に必要な数だけ作成するため、
+* 描画できるスプライトの数に上限はない.
+* 静的バッチのバッファは、Renderer専用のデフォルトヒープに配置する.
+* レイヤーの記録と頂点の書き込みを分担するため、ハードウェアのスレッド数に合わせてワーカースレッドを作成する.
+* レイヤーのコマンドリストとコマンドアロケータは、描画時に必要な数だけ作成する.
+*
+* @retval true  初期化成功.
+* @retval false 初期化失敗.
+*/
+bool Renderer::Init(ComPtr<ID3D12Device> device, int numFrameBuffer, Resource::ResourceLoader& resourceLoader, Resource::ResourceHeap& bufferHeap)
+{
+	this->device = device;
+	frameBufferCount = numFrameBuffer;
+	frameResourceList.resize(numFrameBuffer);
+	if (!arena.Init(device, bufferHeap, arenaPageSize)) {
+		return false;
+	}
+	if (!staticBufferHeap.Init(device, D3D12_HEAP_TYPE_DEFAULT, D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS, staticBufferHeapSize)) {
+		return false;
+	}
+	if (FAILED(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)))) {
+		return false;
+	}
+
+	threadPool.Init();
+
+	return true;
+}
+
+/**
+* スプライトの描画開始.
+*
+* @param frameIndex 現在のフレームバッファのインデックス.
+*
+* @retval true 描画可能な状態になった.
+* @retval false 描画可能な状態への遷移に失敗.
+*/
+bool Renderer::Begin(int frameIndex)
+{
+	if (currentFrameIndex >= 0) {
+		return false;
+	}
+
+	currentFrameIndex = frameIndex;
+	layerCount = 0;
+	uploadLayer = nullptr;
+	statistics = RenderingStatistics();
+	return true;
+}
+
+/**
+* 現在のフレームで使うレイヤーを1つ追加する.
+*
+* レイヤーとコマンドアロケータは足りなければ作成し、以後のフレームで再利用する.
+* コマンドアロケータはフレームバッファ毎に持つため、GPUが他のフレームを実行中でもリセットできる.
+*
+* @return 追加したレイヤー. 作成に失敗した場合はnullptr.
+*/
+Layer* Renderer::AcquireLayer()
+{
+	FrameResource& fr = frameResourceList[currentFrameIndex];
+	if (layerCount >= fr.commandAllocatorList.size()) {
+		ComPtr<ID3D12CommandAllocator> allocator;
+		if (FAILED(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&allocator)))) {
+			return nullptr;
+		}
+		fr.commandAllocatorList.push_back(allocator);
+	}
+	ID3D12CommandAllocator* allocator = fr.commandAllocatorList[layerCount].Get();
+	if (FAILED(allocator->Reset())) {
+		return nullptr;
+	}
+	if (layerCount >= layerList.size()) {
+		std::unique_ptr<Layer> layer(new Layer(*this));
+		if (FAILED(device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, allocator, nullptr, IID_PPV_ARGS(&layer->commandList)))) {
+			return nullptr;
+		}
+		layer->commandList->SetName(L"Sprite Layer Command List");
+		layerList.push_back(std::move(layer));
+	} else if (FAILED(layerList[layerCount]->commandList->Reset(allocator, nullptr))) {
+		return nullptr;
+	}
+	Layer* layer = layerList[layerCount].get();
+	layer->recorder = nullptr;
+	layer->isOpaquePass = false;
+	layer->requestList.clear();
+	layer->stats = RenderingStatistics();
+	layer->boundRootSignature = nullptr;
+	layer->boundPipelineState = nullptr;
+	layer->boundDescriptorHeap = nullptr;
+	layer->boundTexture = nullptr;
+	layer->boundInfo = nullptr;
+	++layerCount;
+	return layer;
+}
+
+/**
+* Draw、DrawInstancedで描画要求を追加するレイヤーを取得する.
+*
+* 最後のレイヤーがAddLayerで追加したものでなければそれを使い、そうでなければ新しく追加する.
+* そのため、AddLayerとDrawを混ぜて呼び出しても、呼び出した順に実行される.
+*
+* @return 描画要求を追加するレイヤー. 作成に失敗した場合はnullptr.
+*/
+Layer* Renderer::GetImmediateLayer()
+{
+	if (layerCount > 0 && !layerList[layerCount - 1]->recorder) {
+		return layerList[layerCount - 1].get();
+	}
+	return AcquireLayer();
+}
+
+/**
+* 文字列を描画.
+*
+* 描画要求を直接追加するレイヤーに追加する. 描画コマンドはEndで記録する.
+* グリフ毎に頂点を直接書き込むため、文字毎にSpriteを用意する必要はない.
+*
+* @param text    描画する文字列. Endまで変更してはならない.
+* @param pso     描画に使用するPSO. インスタンス描画用のPSOは使えない.
+* @param texture 描画に使用するテクスチャ.
+* @param info    描画情報.
+* @param format  頂点データ形式. psoの頂点レイアウトと一致させること.
+*
+* @retval true  描画要求の追加成功.
+* @retval false 描画要求の追加失敗.
+*/
+bool Renderer::Draw(const Text& text, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, VertexFormat format)
+{
+	const ScopedTimer timer(statistics.drawTime);
+	if (currentFrameIndex < 0) {
+		return false;
+	}
+	Layer* layer = GetImmediateLayer();
+	if (!layer) {
+		return false;
+	}
+	return layer->Draw(text, pso, texture, info, format);
+}
+
+/**
+* 静的バッチを描画.
+*
+* 描画要求を直接追加するレイヤーに追加する. 描画コマンドはEndで記録する.
+* 変更を知らされたスプライトの頂点は、Endで作り直してバッチのバッファに転送する.
+*
+* @param batch   描画する静的バッチ. Endまで変更してはならない.
+* @param pso     描画に使用するPSO. 頂点レイアウトがbatchの頂点データ形式と一致すること.
+* @param texture 描画に使用するテクスチャ.
+* @param info    描画情報.
+*
+* @retval true  描画要求の追加成功.
+* @retval false 描画要求の追加失敗.
+*/
+bool Renderer::Draw(const StaticBatch& batch, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info)
+{
+	const ScopedTimer timer(statistics.drawTime);
+	if (currentFrameIndex < 0) {
+		return false;
+	}
+	Layer* layer = GetImmediateLayer();
+	if (!layer) {
+		return false;
+	}
+	return layer->Draw(batch, pso, texture, info);
+}
+
+/**
+* 転送が必要な静的バッチを全てのレイヤーから集め、転送コマンドを記録したレイヤーを追加する.
+*
+* 転送用のレイヤーは描画要求を持たない. Endで全てのレイヤーより先に実行されるように並べる.
+* 同じバッチを複数回描画する場合も、1フレームで転送するのは1回だけ.
+* 転送できなかったバッチにはisUploadFailedを設定し、そのフレームでは描画しない.
+*
+* @return 転送用のレイヤー. 転送が必要な静的バッチがない場合や、作成に失敗した場合はnullptr.
+*/
+Layer* Renderer::AcquireUploadLayer()
+{
+	const size_t count = layerCount;
+	Layer* layer = nullptr;
+	bool isLayerFailed = false;
+	uploadBatchList.clear();
+	for (size_t i = 0; i < count; ++i) {
+		for (const Layer::Request& r : layerList[i]->requestList) {
+			if (!r.batch || std::find(uploadBatchList.begin(), uploadBatchList.end(), r.batch) != uploadBatchList.end()) {
+				continue;
+			}
+			const StaticBatch& batch = *r.batch;
+			uploadBatchList.push_back(&batch);
+			batch.isUploadFailed = false;
+			if (!batch.IsUploadRequired()) {
+				continue;
+			}
+			if (!layer && !isLayerFailed) {
+				layer = AcquireLayer();
+				isLayerFailed = !layer;
+			}
+			if (!layer || !RecordUpload(*layer, batch)) {
+				batch.isUploadFailed = true;
+			}
+		}
+	}
+	return layer;
+}
+
+/**
+* レイヤーを追加する.
+*
+* funcはEndで呼び出され、複数のレイヤーのfuncは複数のスレッドで同時に実行される.
+* そのため、funcは引数のレイヤー以外の状態を変更してはならない. また、funcが参照するデータはEndまで変更してはならない.
+*
+* @param func レイヤーに描画要求を追加する関数.
+*
+* @retval true  追加成功.
+* @retval false 追加失敗.
+*/
+bool Renderer::AddLayer(LayerFunc func)
+{
+	const ScopedTimer timer(statistics.drawTime);
+	if (currentFrameIndex < 0 || !func) {
+		return false;
+	}
+	Layer* layer = AcquireLayer();
+	if (!layer) {
+		return false;
+	}
+	layer->recorder = std::move(func);
+	return true;
+}
+
+/**
+* 描画するスプライトの頂点とインデックスを書き込む.
+*
+* batchSize個ずつAddVertexBatchで書き込む. スプライトが多い場合は、parallelGrainSize個ずつに分けて複数のスレッドで書き込む.
+* 分け方はbatchSizeの倍数なので、スレッド数によらず書き込む内容は同じになる.
+*
+* @tparam T 頂点データ型. VertexまたはCompactVertex.
+*
+* @param layer       描画するスプライトを格納したレイヤー.
+* @param spriteCount 書き込むスプライトの数.
+* @param v           最初のスプライトの頂点データを書き込むアドレス.
+* @param index       最初のスプライトのインデックスデータを書き込むアドレス.
+* @param baseVertex  vの頂点バッファ内での番号.
+* @param offset      スクリーン左上座標.
+*/
+template<typename T>
+void Renderer::FillVertex(Layer& layer, size_t spriteCount, T* v, DWORD* index, uint32_t baseVertex, XMFLOAT2 offset)
+{
+	const bool isStaged = isUploadStaged;
+	const auto fill = [&layer, v, index, baseVertex, offset, isStaged](size_t begin, size_t end) {
+		// 分担する範囲の頂点とインデックスはそれぞれ連続しているため、範囲毎に1つのWriteCombinerで書き込む.
+		WriteCombiner vertexOut(v + layer.drawVertexOffsetList[begin], isStaged);
+		WriteCombiner indexOut(index + layer.drawIndexOffsetList[begin], isStaged);
+		for (size_t i = begin; i < end; i += batchSize) {
+			const size_t count = std::min(batchSize, end - i);
+			AddVertexBatch<T>(&layer.drawSpriteList[i], &layer.drawCellList[i], count, vertexOut, indexOut, baseVertex + layer.drawVertexOffsetList[i], offset);
+		}
+		vertexOut.Flush();
+		indexOut.Flush();
+	};
+	if (spriteCount < minParallelSpriteCount) {
+		fill(0, spriteCount);
+	} else {
+		threadPool.ParallelFor(spriteCount, parallelGrainSize, fill);
+	}
+}
+
+/**
+* スプライトを描画.
+*
+* 描画要求を直接追加するレイヤーに追加する. 描画コマンドはEndで記録する.
+*
+* @param spriteList  描画するスプライトのリスト. Endまで変更してはならない.
+* @param pso         描画に使用するPSO.
+* @param texture     描画に使用するテクスチャ.
+* @param info        描画情報.
+* @param format      頂点データ形式. psoの頂点レイアウトと一致させること.
+* @param visibleMask スプライト毎の表示フラグ. 0のスプライトは描画しない. nullptrなら全て描画する. Endまで変更してはならない.
+*
+* @retval true  描画要求の追加成功.
+* @retval false 描画要求の追加失敗.
+*/
+bool Renderer::Draw(const std::vector<Sprite>& spriteList, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, VertexFormat format, const uint8_t* visibleMask)
+{
+	if (spriteList.empty()) {
+		return true;
+	}
+	return Draw(&*spriteList.begin(), (&*spriteList.begin()) + spriteList.size(), cellList, pso, texture, info, format, visibleMask);
+}
+
+bool Renderer::Draw(const Sprite* first, const Sprite* last, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, VertexFormat format, const uint8_t* visibleMask)
+{
+	const ScopedTimer timer(statistics.drawTime);
+	if (currentFrameIndex < 0) {
+		return false;
+	}
+	if (first == last) {
+		return true;
+	}
+	Layer* layer = GetImmediateLayer();
+	if (!layer) {
+		return false;
+	}
+	layer->AddRequest(first, last, cellList, pso, texture, info, format, false, visibleMask);
+	return true;
+}
+
+/**
+* インスタンス描画でスプライトを描画.
+*
+* 描画要求を直接追加するレイヤーに追加する. 描画コマンドはEndで記録する.
+* スプライト1つにつきSpriteInstance::Instanceを1つ書き込み、頂点シェーダで頂点を作成する.
+* 描画に使うセルだけをセルテーブルに書き込むため、セルの数が多いリストでも書き込み量は増えない.
+* psoにはインスタンス描画用のPSO(PSOType_InstancedSpriteなど)を指定すること.
+*
+* @param spriteList  描画するスプライトのリスト. Endまで変更してはならない.
+* @param cellList    描画に使用するセルデータのリスト.
+* @param pso         描画に使用するPSO.
+* @param texture     描画に使用するテクスチャ.
+* @param info        描画情報.
+* @param visibleMask スプライト毎の表示フラグ. 0のスプライトは描画しない. nullptrなら全て描画する. Endまで変更してはならない.
+*
+* @retval true  描画要求の追加成功.
+* @retval false 描画要求の追加失敗.
+*/
+bool Renderer::DrawInstanced(const std::vector<Sprite>& spriteList, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, const uint8_t* visibleMask)
+{
+	if (spriteList.empty()) {
+		return true;
+	}
+	return DrawInstanced(&*spriteList.begin(), (&*spriteList.begin()) + spriteList.size(), cellList, pso, texture, info, visibleMask);
+}
+
+bool Renderer::DrawInstanced(const Sprite* first, const Sprite* last, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, const uint8_t* visibleMask)
+{
+	const ScopedTimer timer(statistics.drawTime);
+	if (currentFrameIndex < 0) {
+		return false;
+	}
+	if (first == last) {
+		return true;
+	}
+	Layer* layer = GetImmediateLayer();
+	if (!layer) {
+		return false;
+	}
+	layer->AddRequest(first, last, cellList, pso, texture, info, VertexFormat_Float, true, visibleMask);
+	return true;
+}
+
+/**
+* レイヤーの描画要求を記録する.
+*
+* 不透明パスを使う描画要求があれば、まず不透明パスとして不透明なスプライトだけを記録し、続けて残りのスプライトを記録する.
+* どちらも同じレイヤーのコマンドリストに積むため、レイヤーの実行順序は変わらない.
+*
+* @param layer 記録するレイヤー.
+*/
+void Renderer::RecordLayer(Layer& layer)
+{
+	const bool hasOpaquePass = std::any_of(layer.requestList.begin(), layer.requestList.end(), [](const Layer::Request& r) { return r.HasOpaquePass(); });
+	if (hasOpaquePass) {
+		layer.isOpaquePass = true;
+		RecordPass(layer);
+		layer.isOpaquePass = false;
+	}
+	RecordPass(layer);
+}
+
+/**
+* レイヤーの描画要求をソートし、まとめて描画コマンドを記録する.
+*
+* 不透明パスでは、不透明パスを使う描画要求だけを対象とする.
+* ソートキーは上位からPSO、テクスチャ、深度(奥から手前. 不透明パスでは手前から奥). PSOとテクスチャの番号はレイヤー内で最初に使われた順に付ける.
+* 基数ソートは安定なので、キーが同じ要求は要求した順に描画される.
+* ソート後に隣り合う要求の状態が同じなら、頂点を連続して書き込んで1回の描画コマンドにまとめる.
+*
+* @param layer 記録するレイヤー.
+*/
+void Renderer::RecordPass(Layer& layer)
+{
+	layer.sortList.clear();
+	layer.psoKeyList.clear();
+	layer.textureKeyList.clear();
+	for (size_t i = 0; i < layer.requestList.size(); ++i) {
+		const Layer::Request& r = layer.requestList[i];
+		if (layer.isOpaquePass && !r.HasOpaquePass()) {
+			continue;
+		}
+		const uint64_t psoKey = std::min<uint32_t>(GetSortKeyIndex(layer.psoKeyList, r.pso), 0xff);
+		const uint64_t textureKey = std::min<uint32_t>(GetSortKeyIndex(layer.textureKeyList, r.texture), 0xffffff);
+		const uint64_t depthKey = layer.isOpaquePass ? FloatToSortKey(r.nearDepth) : ~FloatToSortKey(r.depth);
+		layer.sortList.push_back({ (psoKey << 56) | (textureKey << 32) | (depthKey & 0xffffffff), static_cast<uint32_t>(i) });
+	}
+	RadixSort(layer.sortList, layer.sortWork);
+
+	const size_t requestCount = layer.sortList.size();
+	const auto canMerge = [](const Layer::Request& lhs, const Layer::Request& rhs) {
+		return !lhs.isInstanced && !rhs.isInstanced && !lhs.batch && !rhs.batch && (lhs.text != nullptr) == (rhs.text != nullptr) &&
+			lhs.pso == rhs.pso && lhs.texture == rhs.texture && lhs.format == rhs.format && IsSameRenderingInfo(lhs.info, rhs.info);
+	};
+	for (size_t i = 0; i < requestCount;) {
+		const Layer::Request& r = layer.requestList[layer.sortList[i].value];
+		if (r.isInstanced) {
+			RecordDrawInstanced(layer, r);
+			++i;
+			continue;
+		}
+		if (r.batch) {
+			RecordDrawStaticBatch(layer, r);
+			++i;
+			continue;
+		}
+		size_t end = i + 1;
+		while (end < requestCount && canMerge(r, layer.requestList[layer.sortList[end].value])) {
+			++end;
+		}
+		if (r.text) {
+			RecordDrawText(layer, i, end);
+		} else {
+			RecordDraw(layer, i, end);
+		}
+		i = end;
+	}
+}
+
+/**
+* 状態が同じ描画要求をまとめて、1回の描画コマンドを記録する.
+*
+* 描画するスプライトの頂点の書き込み位置を決めてから、頂点とインデックスを書き込み、最後に描画コマンドを積む.
+* 頂点とインデックスの領域は排他制御してarenaから確保するため、異なるレイヤーなら同時に呼び出せる.
+* 不透明パスを使う描画要求では、不透明パスは不透明なスプライトだけを手前から順に、その後の通常の記録は残りのスプライトを描画する.
+*
+* @param layer 記録先のレイヤー.
+* @param first まとめる描画要求の、ソート結果の配列における先頭の位置.
+* @param last  まとめる描画要求の、ソート結果の配列における終端の位置.
+*/
+void Renderer::RecordDraw(Layer& layer, size_t first, size_t last)
+{
+	const Layer::Request& front = layer.requestList[layer.sortList[first].value];
+	const bool isCompact = front.format == VertexFormat_Compact;
+
+	// 描画するスプライトと、その頂点とインデックスの書き込み位置を先に決める.
+	// 書き込み位置は頂点数とインデックス数の累積和なので、スプライト毎の書き込み先は重ならない.
+	// 除外したスプライトは通常の記録で数えるため、不透明パスでは統計に加えない.
+	layer.drawSpriteList.clear();
+	layer.drawCellList.clear();
+	RenderingStatistics opaquePassStats = {};
+	RenderingStatistics& cullingStats = layer.isOpaquePass ? opaquePassStats : layer.stats;
+	const XMVECTOR bounds = GetCullingBounds(front.info.viewport);
+	for (size_t n = first; n < last; ++n) {
+		const Layer::Request& r = layer.requestList[layer.sortList[n].value];
+		const bool isSplit = r.HasOpaquePass();
+		ForEachVisibleSprite(r.first, r.last, r.visibleMask, r.cellList, bounds, cullingStats, [&](const Sprite& sprite, const Cell& cell) {
+			if (!isSplit || IsOpaqueSprite(sprite, cell) == layer.isOpaquePass) {
+				layer.drawSpriteList.push_back(&sprite);
+				layer.drawCellList.push_back(&cell);
+			}
+			return true;
+		});
+	}
+	const size_t spriteCount = layer.drawSpriteList.size();
+	if (spriteCount == 0) {
+		return;
+	}
+
+	// 不透明パスでは手前のスプライトから描画し、奥のピクセルを深度テストで省く. Z座標が同じなら要求した順に描画する.
+	if (layer.isOpaquePass) {
+		layer.drawSortList.clear();
+		for (size_t i = 0; i < spriteCount; ++i) {
+			layer.drawSortList.push_back({ FloatToSortKey(layer.drawSpriteList[i]->pos.z), static_cast<uint32_t>(i) });
+		}
+		RadixSort(layer.drawSortList, layer.sortWork);
+		layer.drawSpriteList.reserve(spriteCount * 2);
+		layer.drawCellList.reserve(spriteCount * 2);
+		for (const SortItem& e : layer.drawSortList) {
+			const Sprite* sprite = layer.drawSpriteList[e.value];
+			const Cell* cell = layer.drawCellList[e.value];
+			layer.drawSpriteList.push_back(sprite);
+			layer.drawCellList.push_back(cell);
+		}
+		layer.drawSpriteList.erase(layer.drawSpriteList.begin(), layer.drawSpriteList.begin() + spriteCount);
+		layer.drawCellList.erase(layer.drawCellList.begin(), layer.drawCellList.begin() + spriteCount);
+	}
+
+	layer.drawVertexOffsetList.clear();
+	layer.drawIndexOffsetList.clear();
+	uint32_t drawVertexCount = 0;
+	uint32_t drawIndexCount = 0;
+	for (const Cell* cell : layer.drawCellList) {
+		const uint32_t meshVertexCount = GetMeshVertexCount(*cell);
+		layer.drawVertexOffsetList.push_back(drawVertexCount);
+		layer.drawIndexOffsetList.push_back(drawIndexCount);
+		drawVertexCount += meshVertexCount;
+		drawIndexCount += (meshVertexCount - 2) * 3;
+	}
+	layer.drawVertexOffsetList.push_back(drawVertexCount);
+	layer.drawIndexOffsetList.push_back(drawIndexCount);
+
+	// 頂点とインデックスの領域を確保する. 描画毎に頂点バッファビューを設定するため、インデックスは確保した領域の先頭からの番号にする.
+	const UINT vertexStride = isCompact ? sizeof(CompactVertex) : sizeof(Vertex);
+	Resource::UploadArena::Allocation vertexAllocation;
+	Resource::UploadArena::Allocation indexAllocation;
+	{
+		std::lock_guard<std::mutex> lock(allocationMutex);
+		if (!arena.Allocate(drawVertexCount * vertexStride, 16, vertexAllocation) || !arena.Allocate(drawIndexCount * sizeof(DWORD), 16, indexAllocation)) {
+			return;
+		}
+	}
+
+	const XMFLOAT2 offset(-(front.info.viewport.Width * 0.5f), front.info.viewport.Height * 0.5f);
+	DWORD* index = reinterpret_cast<DWORD*>(indexAllocation.cpuAddress);
+	if (isCompact) {
+		FillVertex(layer, spriteCount, reinterpret_cast<CompactVertex*>(vertexAllocation.cpuAddress), index, 0, offset);
+	} else {
+		FillVertex(layer, spriteCount, reinterpret_cast<Vertex*>(vertexAllocation.cpuAddress), index, 0, offset);
+	}
+
+	// 全ての頂点を書き込んでから描画コマンドを積む.
+	SetRenderingState(layer, layer.isOpaquePass ? *front.pso->opaque : *front.pso, *front.texture, front.info);
+	const D3D12_VERTEX_BUFFER_VIEW vertexBufferView = { vertexAllocation.gpuAddress, drawVertexCount * vertexStride, vertexStride };
+	const D3D12_INDEX_BUFFER_VIEW indexBufferView = { indexAllocation.gpuAddress, static_cast<UINT>(drawIndexCount * sizeof(DWORD)), DXGI_FORMAT_R32_UINT };
+	layer.commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
+	layer.commandList->IASetIndexBuffer(&indexBufferView);
+	layer.commandList->DrawIndexedInstanced(drawIndexCount, 1, 0, 0, 0);
+	layer.stats.drawnCount += static_cast<uint32_t>(spriteCount);
+	layer.stats.vertexBytes += drawVertexCount * vertexStride + drawIndexCount * sizeof(DWORD);
+	++layer.stats.drawCallCount;
+}
+
+/**
+* 状態が同じ文字列の描画要求をまとめて、1回の描画コマンドを記録する.
+*
+* 表示するグリフの頂点数を数えてから領域を確保し、グリフの頂点とインデックスを順に書き込む.
+* 文字列は数十文字程度なので、RecordDrawと異なり頂点の書き込みはスレッドで分担しない.
+*
+* @param layer 記録先のレイヤー.
+* @param first まとめる描画要求の、ソート結果の配列における先頭の位置.
+* @param last  まとめる描画要求の、ソート結果の配列における終端の位置.
+*/
+void Renderer::RecordDrawText(Layer& layer, size_t first, size_t last)
+{
+	const Layer::Request& front = layer.requestList[layer.sortList[first].value];
+	const bool isCompact = front.format == VertexFormat_Compact;
+	const XMVECTOR bounds = GetCullingBounds(front.info.viewport);
+
+	uint32_t glyphCount = 0;
+	uint32_t drawVertexCount = 0;
+	for (size_t n = first; n < last; ++n) {
+		const Layer::Request& r = layer.requestList[layer.sortList[n].value];
+		ForEachVisibleGlyph(*r.text, bounds, layer.stats, [&](const Text::Glyph& glyph) {
+			++glyphCount;
+			drawVertexCount += GetMeshVertexCount(*glyph.cell);
+		});
+	}
+	if (glyphCount == 0) {
+		return;
+	}
+	const uint32_t drawIndexCount = (drawVertexCount - glyphCount * 2) * 3;
+
+	const UINT vertexStride = isCompact ? sizeof(CompactVertex) : sizeof(Vertex);
+	Resource::UploadArena::Allocation vertexAllocation;
+	Resource::UploadArena::Allocation indexAllocation;
+	{
+		std::lock_guard<std::mutex> lock(allocationMutex);
+		if (!arena.Allocate(drawVertexCount * vertexStride, 16, vertexAllocation) || !arena.Allocate(drawIndexCount * sizeof(DWORD), 16, indexAllocation)) {
+			return;
+		}
+	}
+
+	// 除外したグリフは数え終えているので、2回目の走査では統計に加えない.
+	const XMFLOAT2 offset(-(front.info.viewport.Width * 0.5f), front.info.viewport.Height * 0.5f);
+	WriteCombiner vertexOut(vertexAllocation.cpuAddress, isUploadStaged);
+	WriteCombiner indexOut(indexAllocation.cpuAddress, isUploadStaged);
+	RenderingStatistics ignoredStats = {};
+	uint32_t baseVertex = 0;
+	for (size_t n = first; n < last; ++n) {
+		const Text& text = *layer.requestList[layer.sortList[n].value].text;
+		ForEachVisibleGlyph(text, bounds, ignoredStats, [&](const Text::Glyph& glyph) {
+			if (isCompact) {
+				baseVertex += AddGlyphVertex<CompactVertex>(text, glyph, vertexOut, indexOut, baseVertex, offset);
+			} else {
+				baseVertex += AddGlyphVertex<Vertex>(text, glyph, vertexOut, indexOut, baseVertex, offset);
+			}
+		});
+	}
+	vertexOut.Flush();
+	indexOut.Flush();
+
+	SetRenderingState(layer, *front.pso, *front.texture, front.info);
+	const D3D12_VERTEX_BUFFER_VIEW vertexBufferView = { vertexAllocation.gpuAddress, drawVertexCount * vertexStride, vertexStride };
+	const D3D12_INDEX_BUFFER_VIEW indexBufferView = { indexAllocation.gpuAddress, static_cast<UINT>(drawIndexCount * sizeof(DWORD)), DXGI_FORMAT_R32_UINT };
+	layer.commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
+	layer.commandList->IASetIndexBuffer(&indexBufferView);
+	layer.commandList->DrawIndexedInstanced(drawIndexCount, 1, 0, 0, 0);
+	layer.stats.drawnCount += glyphCount;
+	layer.stats.vertexBytes += drawVertexCount * vertexStride + drawIndexCount * sizeof(DWORD);
+	++layer.stats.drawCallCount;
+}
+
+/**
+* インスタンス描画の描画コマンドを記録する.
+*
+* インスタンスデータとセルテーブルをレイヤー内で作成してから、arenaから領域を確保して書き込む.
+* 領域は排他制御して確保するため、異なるレイヤーなら同時に呼び出せる.
+*
+* @param layer   記録先のレイヤー.
+* @param request 描画要求.
+*/
+void Renderer::RecordDrawInstanced(Layer& layer, const Layer::Request& request)
+{
+	// インスタンスデータを作成しながら、使用するセルにテーブルの番号を割り当てる.
+	const XMFLOAT2 offset(-(request.info.viewport.Width * 0.5f), request.info.viewport.Height * 0.5f);
+	layer.instanceList.clear();
+	layer.cellIndexList.clear();
+	ForEachVisibleSprite(request.first, request.last, request.visibleMask, request.cellList, GetCullingBounds(request.info.viewport), layer.stats, [&](const Sprite& sprite, const Cell& cell) {
+		const uint32_t cellIndex = sprite.GetCellIndex();
+		if (cellIndex >= layer.cellSlotList.size()) {
+			layer.cellSlotList.resize(cellIndex + 1, 0);
+		}
+		if (!layer.cellSlotList[cellIndex]) {
+			if (layer.cellIndexList.size() >= 0xffff) {
+				return false;
+			}
+			layer.cellIndexList.push_back(cellIndex);
+			layer.cellSlotList[cellIndex] = static_cast<uint32_t>(layer.cellIndexList.size());
+		}
+
+		SpriteInstance::Instance instance;
+		MakeInstance(sprite, cell, layer.cellSlotList[cellIndex] - 1, offset, instance);
+		layer.instanceList.push_back(instance);
+		return true;
+	});
+	// 変換表を次の描画のために空に戻す.
+	for (uint32_t cellIndex : layer.cellIndexList) {
+		layer.cellSlotList[cellIndex] = 0;
+	}
+
+	const size_t instanceCount = layer.instanceList.size();
+	if (instanceCount == 0) {
+		return;
+	}
+
+	// インスタンスデータとセルテーブルを1つの領域に続けて配置する.
+	const size_t cellCount = layer.cellIndexList.size();
+	const size_t cellOffset = AlignInstanceBufferOffset(instanceCount * sizeof(SpriteInstance::Instance));
+	Resource::UploadArena::Allocation allocation;
+	{
+		std::lock_guard<std::mutex> lock(allocationMutex);
+		if (!arena.Allocate(cellOffset + cellCount * sizeof(SpriteInstance::CellData), D3D12_RAW_UAV_SRV_BYTE_ALIGNMENT, allocation)) {
+			return;
+		}
+	}
+
+	// インスタンスデータとセルテーブルを書き込む. セルテーブルの前の隙間も埋めて、1つの連続した書き込みにする.
+	WriteCombiner out(allocation.cpuAddress, isUploadStaged);
+	out.Write(layer.instanceList.data(), instanceCount * sizeof(SpriteInstance::Instance));
+	const size_t padding = cellOffset - instanceCount * sizeof(SpriteInstance::Instance);
+	memset(out.Reserve(padding), 0, padding);
+	out.Commit(padding);
+	uint32_t maxMeshVertexCount = 0;
+	for (size_t i = 0; i < cellCount; ++i) {
+		const Cell& cell = request.cellList[layer.cellIndexList[i]];
+		SpriteInstance::CellData& data = *static_cast<SpriteInstance::CellData*>(out.Reserve(sizeof(SpriteInstance::CellData)));
+		MakeCellData(cell, data);
+		maxMeshVertexCount = std::max(maxMeshVertexCount, data.vertexCount);
+		out.Commit(sizeof(SpriteInstance::CellData));
+	}
+	out.Flush();
+
+	SetRenderingState(layer, *request.pso, *request.texture, request.info);
+	layer.commandList->SetGraphicsRootShaderResourceView(3, allocation.gpuAddress);
+	layer.commandList->SetGraphicsRootShaderResourceView(4, allocation.gpuAddress + cellOffset);
+	layer.commandList->DrawInstanced(SpriteInstance::GetVertexCountPerInstance(maxMeshVertexCount), static_cast<UINT>(instanceCount), 0, 0);
+	layer.stats.drawnCount += static_cast<uint32_t>(instanceCount);
+	layer.stats.vertexBytes += cellOffset + cellCount * sizeof(SpriteInstance::CellData);
+	++layer.stats.drawCallCount;
+}
+
+/**
+* 静的バッチの描画コマンドを記録する.
+*
+* 頂点とインデックスはバッチのバッファに転送済みなので、状態を設定して描画コマンドを積むだけで済む.
+* スクリーン左上座標とバッチの移動量は、描画要求を追加したときに描画情報の座標変換行列に加えてある.
+*
+* @param layer   記録先のレイヤー.
+* @param request 描画要求.
+*/
+void Renderer::RecordDrawStaticBatch(Layer& layer, const Layer::Request& request)
+{
+	// このフレームで転送できなかったバッチは、内容が不定か古いままなので描画しない.
+	const StaticBatch& batch = *request.batch;
+	if (batch.isUploadFailed) {
+		return;
+	}
+	const size_t spriteCount = batch.GetSpriteCount();
+	const UINT vertexStride = GetVertexStride(batch.format);
+	const UINT vertexBytes = static_cast<UINT>(spriteCount * SpriteMesh::maxVertexCount * vertexStride);
+	const UINT indexCount = static_cast<UINT>(spriteCount * staticIndexCountPerSprite);
+	SetRenderingState(layer, *request.pso, *request.texture, request.info);
+	const D3D12_GPU_VIRTUAL_ADDRESS address = batch.buffer->GetGPUVirtualAddress();
+	const D3D12_VERTEX_BUFFER_VIEW vertexBufferView = { address, vertexBytes, vertexStride };
+	const D3D12_INDEX_BUFFER_VIEW indexBufferView = { address + vertexBytes, static_cast<UINT>(indexCount * sizeof(DWORD)), DXGI_FORMAT_R32_UINT };
+	layer.commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
+	layer.commandList->IASetIndexBuffer(&indexBufferView);
+	layer.commandList->DrawIndexedInstanced(indexCount, 1, 0, 0, 0);
+	layer.stats.drawnCount += static_cast<uint32_t>(spriteCount);
+	++layer.stats.drawCallCount;
+}
+
+/**
+* 静的バッチの変更された範囲の頂点を作り直し、バッチのバッファへ転送するコマンドを記録する.
+*
+* 頂点はarenaに書き込み、まとめた範囲毎にCopyBufferRegionで転送する. 最初の転送ではインデックスも転送する.
+* バッファはバッファの暗黙の状態遷移により、コピーでCOPY_DESTになり、ExecuteCommandListsを終えるとCOMMONに戻る.
+* そのため、転送後に頂点とインデックスとして読める状態へ遷移させるだけでよい.
+* 1つのコマンドリストで同じバッファに2回転送すると遷移後の状態からコピーすることになるため、AcquireUploadLayerで1フレーム1回に制限している.
+* 頂点はスクリーン左上座標を原点として作るため、ビューポートが変わっても作り直す必要はない.
+*
+* @param layer 記録先のレイヤー.
+* @param batch 転送する静的バッチ.
+*
+* @retval true  転送コマンドを記録した.
+* @retval false 領域を確保できなかった. 変更された範囲は残しておき、次のフレームで転送する.
+*/
+bool Renderer::RecordUpload(Layer& layer, const StaticBatch& batch)
+{
+	const size_t spriteCount = batch.GetSpriteCount();
+	const XMFLOAT2 offset(0, 0);
+	MergeRanges(batch.dirtyRangeList);
+	size_t dirtyCount = 0;
+	for (const auto& e : batch.dirtyRangeList) {
+		dirtyCount += e.second - e.first;
+	}
+
+	const UINT vertexStride = GetVertexStride(batch.format);
+	const UINT64 slotBytes = SpriteMesh::maxVertexCount * vertexStride;
+	const UINT64 vertexBytes = dirtyCount * slotBytes;
+	const UINT64 indexBytes = batch.hasIndex ? 0 : spriteCount * staticIndexCountPerSprite * sizeof(DWORD);
+	Resource::UploadArena::Allocation allocation;
+	{
+		std::lock_guard<std::mutex> lock(allocationMutex);
+		if (!arena.Allocate(vertexBytes + indexBytes, 16, allocation)) {
+			return false;
+		}
+	}
+
+	// 変更された範囲の頂点を続けて書き込み、最初の転送ならその後ろにインデックスを書き込む.
+	WriteCombiner out(allocation.cpuAddress, isUploadStaged);
+	const Sprite* spriteList[batchSize];
+	const Cell* cellList[batchSize];
+	for (const auto& e : batch.dirtyRangeList) {
+		for (size_t i = e.first; i < e.second; i += batchSize) {
+			const size_t count = std::min(batchSize, e.second - i);
+			for (size_t n = 0; n < count; ++n) {
+				spriteList[n] = batch.first + i + n;
+				cellList[n] = batch.cellList + spriteList[n]->GetCellIndex();
+			}
+			if (batch.format == VertexFormat_Compact) {
+				AddStaticVertexBatch<CompactVertex>(spriteList, cellList, count, out, offset);
+			} else {
+				AddStaticVertexBatch<Vertex>(spriteList, cellList, count, out, offset);
+			}
+		}
+	}
+	if (indexBytes) {
+		for (size_t i = 0; i < spriteCount; ++i) {
+			const uint32_t baseVertex = static_cast<uint32_t>(i * SpriteMesh::maxVertexCount);
+			DWORD* index = static_cast<DWORD*>(out.Reserve(staticIndexCountPerSprite * sizeof(DWORD)));
+			for (uint32_t n = 1; n < SpriteMesh::maxVertexCount - 1; ++n) {
+				index[0] = baseVertex;
+				index[1] = baseVertex + n;
+				index[2] = baseVertex + n + 1;
+				index += 3;
+			}
+			out.Commit(staticIndexCountPerSprite * sizeof(DWORD));
+		}
+	}
+	out.Flush();
+
+	ID3D12GraphicsCommandList* commandList = layer.commandList.Get();
+	UINT64 srcOffset = allocation.offset;
+	for (const auto& e : batch.dirtyRangeList) {
+		const UINT64 size = (e.second - e.first) * slotBytes;
+		commandList->CopyBufferRegion(batch.buffer.Get(), e.first * slotBytes, allocation.resource, srcOffset, size);
+		srcOffset += size;
+	}
+	if (indexBytes) {
+		commandList->CopyBufferRegion(batch.buffer.Get(), spriteCount * slotBytes, allocation.resource, srcOffset, indexBytes);
+	}
+	const D3D12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(batch.buffer.Get(),
+		D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER | D3D12_RESOURCE_STATE_INDEX_BUFFER);
+	commandList->ResourceBarrier(1, &barrier);
+
+	batch.dirtyRangeList.clear();
+	batch.hasIndex = true;
+	layer.stats.vertexBytes += vertexBytes + indexBytes;
+	return true;
+}
+
+/**
+* 静的バッチのバッファを、GPUが使い終えた後で解放するように登録する.
+*
+* 次のSignalで送るフェンスをGPUが通過した時点で解放する.
+*
+* @param buffer     解放するバッファ. 登録後は空になる.
+* @param allocation バッファの配置情報. 登録後は空になる.
+*/
+void Renderer::ReleaseStaticBuffer(ComPtr<ID3D12Resource>& buffer, Resource::ResourceHeap::Allocation& allocation)
+{
+	pendingBufferList.push_back({ std::move(buffer), allocation, 0 });
+	allocation = Resource::ResourceHeap::Allocation();
+}
+
+/**
+* 描画に必要なパイプラインの状態を設定する.
+*
+* レイヤーのコマンドリストに設定済みの状態と同じものは設定を省く.
+*
+* @param layer   記録先のレイヤー.
+* @param pso     描画に使用するPSO.
+* @param texture 描画に使用するテクスチャ. Resolve済みであること.
+* @param info    描画情報.
+*/
+void Renderer::SetRenderingState(Layer& layer, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info)
+{
+	ID3D12GraphicsCommandList* commandList = layer.commandList.Get();
+	// ルートシグネチャを変更すると、ルート引数の設定は全て無効になる.
+	if (layer.boundRootSignature != pso.rootSignature.Get()) {
+		commandList->SetGraphicsRootSignature(pso.rootSignature.Get());
+		layer.boundRootSignature = pso.rootSignature.Get();
+		++layer.stats.stateChangeCount;
+		layer.boundTexture = nullptr;
+		layer.boundInfo = nullptr;
+	}
+	if (layer.boundPipelineState != pso.pso.Get()) {
+		commandList->SetPipelineState(pso.pso.Get());
+		layer.boundPipelineState = pso.pso.Get();
+		++layer.stats.stateChangeCount;
+	}
+	// 追加ページに作られたテクスチャは、そのページのヒープを設定しなければならない.
+	// ヒープを変更したら、デスクリプタテーブルも設定し直す.
+	ID3D12DescriptorHeap* heap = texture.heap ? texture.heap : info.texDescHeap;
+	if (layer.boundDescriptorHeap != heap) {
+		ID3D12DescriptorHeap* heapList[] = { heap };
+		commandList->SetDescriptorHeaps(_countof(heapList), heapList);
+		layer.boundDescriptorHeap = heap;
+		layer.boundTexture = nullptr;
+		++layer.stats.stateChangeCount;
+	}
+	if (layer.boundTexture != &texture) {
+		commandList->SetGraphicsRootDescriptorTable(0, texture.handle);
+		layer.boundTexture = &texture;
+		++layer.stats.textureSwitchCount;
+	}
+	if (!layer.boundInfo || !IsSameRenderingInfo(*layer.boundInfo, info)) {
+		commandList->SetGraphicsRoot32BitConstants(1, 16, &info.matViewProjection, 0);
+		commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		commandList->OMSetRenderTargets(1, &info.rtvHandle, FALSE, &info.dsvHandle);
+		commandList->RSSetViewports(1, &info.viewport);
+		commandList->RSSetScissorRects(1, &info.scissorRect);
+		layer.boundInfo = &info;
+		++layer.stats.stateChangeCount;
+	}
+}
+
+/**
+* スプライトの描画終了.
+*
+* AddLayerで追加したレイヤーの記録関数を呼び出してから、全てのレイヤーの描画要求を記録してコマンドリストを閉じる.
+* 記録の前に静的バッチの転送用のレイヤーを作成し、他のレイヤーより先に実行されるように並べる.
+* 不透明パスはレイヤー毎に、そのレイヤーのコマンドリストの先頭に記録する.
+* レイヤー毎の処理は複数のスレッドで分担する. 閉じたコマンドリストはGetCommandListsで取得できる.
+*
+* @retval true  コマンドリスト作成成功.
+* @retval false コマンドリスト作成失敗.
+*/
+bool Renderer::End()
+{
+	if (currentFrameIndex < 0) {
+		return false;
+	}
+	const double startTime = GetTime();
+	threadPool.ParallelFor(layerCount, 1, [this](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			Layer& layer = *layerList[i];
+			if (layer.recorder) {
+				layer.recorder(layer);
+			}
+		}
+	});
+	// 転送する静的バッチは、全てのレイヤーの描画要求が揃ってから決まる.
+	uploadLayer = AcquireUploadLayer();
+	threadPool.ParallelFor(layerCount, 1, [this](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			RecordLayer(*layerList[i]);
+		}
+	});
+	currentFrameIndex = -1;
+
+	submitList.clear();
+	for (size_t i = 0; i < layerCount; ++i) {
+		Layer& layer = *layerList[i];
+		layer.recorder = nullptr;
+		AddStatistics(statistics, layer.stats);
+		if (FAILED(layer.commandList->Close())) {
+			submitList.clear();
+			return false;
+		}
+		if (&layer == uploadLayer) {
+			submitList.insert(submitList.begin(), layer.commandList.Get());
+		} else {
+			statistics.requestCount += static_cast<uint32_t>(layer.requestList.size());
+			submitList.push_back(layer.commandList.Get());
+		}
+	}
+	statistics.truncatedCount = statistics.spriteCount - statistics.maskedCount - statistics.zeroScaleCount - statistics.culledCount - statistics.drawnCount;
+	statistics.endTime = GetTime() - startTime;
+	if (!statisticsLog.empty()) {
+		statisticsLog[statisticsLogCount % statisticsLog.size()] = statistics;
+		++statisticsLogCount;
+	}
+	return true;
+}
+
+/**
+* 実行するコマンドリストの配列を取得する.
+*
+* @return Endで閉じたコマンドリストの配列. GPUで実行する順に並ぶ.
+*/
+const std::vector<ID3D12CommandList*>& Renderer::GetCommandLists() const
+{
+	return submitList;
+}
+
+/**
+* 現在のフレームで書き込んだ頂点などの使用完了を示すフェンスをコマンドキューに積む.
+*
+* GetCommandListsで取得したコマンドリストをコマンドキューに積んだ後で呼び出すこと.
+*
+* @param commandQueue コマンドキュー.
+*
+* @retval true  成功.
+* @retval false 失敗.
+*/
+bool Renderer::Signal(ID3D12CommandQueue* commandQueue)
+{
+	if (!arena.Signal(commandQueue)) {
+		return false;
+	}
+
+	// 破棄された静的バッチのバッファは、GPUが使い終えてから配置領域を解放する.
+	const bool hasNewBuffer = std::any_of(pendingBufferList.begin(), pendingBufferList.end(), [](const PendingBuffer& e) { return e.fenceValue == 0; });
+	if (hasNewBuffer) {
+		++fenceValue;
+		if (FAILED(commandQueue->Signal(fence.Get(), fenceValue))) {
+			return false;
+		}
+		for (PendingBuffer& e : pendingBufferList) {
+			if (e.fenceValue == 0) {
+				e.fenceValue = fenceValue;
+			}
+		}
+	}
+	const UINT64 completedValue = fence->GetCompletedValue();
+	pendingBufferList.erase(std::remove_if(pendingBufferList.begin(), pendingBufferList.end(), [this, completedValue](PendingBuffer& e) {
+		if (e.fenceValue > completedValue) {
+			return false;
+		}
+		e.buffer.Reset();
+		staticBufferHeap.Free(e.allocation);
+		return true;
+	}), pendingBufferList.end());
+	return true;
+}
+
+/**
+* フレーム毎の統計情報を記録するフレーム数を設定する.
+*
+* 記録はEndで行い、frameCountを超えると古いものから上書きする. 設定すると以前の記録は消去される.
+*
+* @param frameCount 記録するフレーム数. 0なら記録しない.
+*/
+void Renderer::SetStatisticsLogSize(size_t frameCount)
+{
+	statisticsLog.assign(frameCount, RenderingStatistics());
+	statisticsLogCount = 0;
+}
+
+/**
+* 記録した統計情報をCSV形式で書き出す.
+*
+* 1行目は項目名で、2行目以降に古いフレームから順に1フレーム1行で書き出す. 時間の単位はマイクロ秒.
+*
+* @param filename 書き出すファイル名.
+*
+* @retval true  書き出し成功.
+* @retval false 書き出し失敗.
+*/
+bool Renderer::WriteStatisticsLog(const wchar_t* filename) const
+{
+	std::string csv = "frame,requests,drawCalls,sprites,masked,zeroScale,culled,drawn,truncated,stateChanges,textureSwitches,vertexBytes,drawUs,endUs\n";
+	const size_t count = std::min(statisticsLogCount, statisticsLog.size());
+	for (size_t i = statisticsLogCount - count; i < statisticsLogCount; ++i) {
+		const RenderingStatistics& s = statisticsLog[i % statisticsLog.size()];
+		char line[256];
+		snprintf(line, sizeof(line), "%zu,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%llu,%.1f,%.1f\n",
+			i, s.requestCount, s.drawCallCount, s.spriteCount, s.maskedCount, s.zeroScaleCount, s.culledCount, s.drawnCount, s.truncatedCount,
+			s.stateChangeCount, s.textureSwitchCount, static_cast<unsigned long long>(s.vertexBytes),
+			s.drawTime * 1000000.0, s.endTime * 1000000.0);
+		csv += line;
+	}
+
+	std::unique_ptr<std::remove_pointer<HANDLE>::type, decltype(&CloseHandle)> h(
+		CreateFileW(filename, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr),
+		CloseHandle
+	);
+	if (h.get() == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	DWORD writtenBytes;
+	return WriteFile(h.get(), csv.data(), static_cast<DWORD>(csv.size()), &writtenBytes, nullptr) && writtenBytes == csv.size();
+}
+
+/**
+* スプライトを描画.
+*
+* 引数と戻り値はRenderer::Drawと同じ.
+*/
+bool Layer::Draw(const std::vector<Sprite>& spriteList, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, VertexFormat format, const uint8_t* visibleMask)
+{
+	if (spriteList.empty()) {
+		return true;
+	}
+	return Draw(&*spriteList.begin(), (&*spriteList.begin()) + spriteList.size(), cellList, pso, texture, info, format, visibleMask);
+}
+
+bool Layer::Draw(const Sprite* first, const Sprite* last, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, VertexFormat format, const uint8_t* visibleMask)
+{
+	if (first != last) {
+		AddRequest(first, last, cellList, pso, texture, info, format, false, visibleMask);
+	}
+	return true;
+}
+
+/**
+* インスタンス描画でスプライトを描画.
+*
+* 引数と戻り値はRenderer::DrawInstancedと同じ.
+*/
+bool Layer::DrawInstanced(const std::vector<Sprite>& spriteList, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, const uint8_t* visibleMask)
+{
+	if (spriteList.empty()) {
+		return true;
+	}
+	return DrawInstanced(&*spriteList.begin(), (&*spriteList.begin()) + spriteList.size(), cellList, pso, texture, info, visibleMask);
+}
+
+bool Layer::DrawInstanced(const Sprite* first, const Sprite* last, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, const uint8_t* visibleMask)
+{
+	if (first != last) {
+		AddRequest(first, last, cellList, pso, texture, info, VertexFormat_Float, true, visibleMask);
+	}
+	return true;
+}
+
+/**
+* 文字列を描画.
+*
+* 引数と戻り値はRenderer::Drawと同じ.
+*/
+bool Layer::Draw(const Text& text, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, VertexFormat format)
+{
+	const size_t glyphCount = text.GetGlyphList().size();
+	if (glyphCount > 0) {
+		requestList.push_back({ nullptr, nullptr, nullptr, &pso, &texture.Resolve(), info, format, false, nullptr, text.pos.z, text.pos.z, &text, nullptr });
+		stats.spriteCount += static_cast<uint32_t>(glyphCount);
+	}
+	return true;
+}
+
+/**
+* 静的バッチを描画.
+*
+* バッチの頂点はスクリーン左上座標を原点として作ってあるため、スクリーン左上座標とバッチの移動量を座標変換行列に加える.
+* 行列はシェーダで列優先として読まれるため、転置した平行移動行列を右から掛ける.
+* 頂点のY軸はスクリーン座標と逆向きなので、移動量のYは符号を反転する.
+*
+* 引数と戻り値はRenderer::Drawと同じ.
+*/
+bool Layer::Draw(const StaticBatch& batch, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info)
+{
+	if (!batch.buffer) {
+		return true;
+	}
+	RenderingInfo batchInfo = info;
+	const XMFLOAT2 offset(-(info.viewport.Width * 0.5f), info.viewport.Height * 0.5f);
+	const XMMATRIX translation = XMMatrixTranspose(XMMatrixTranslation(offset.x + batch.translation.x, offset.y - batch.translation.y, 0));
+	XMStoreFloat4x4(&batchInfo.matViewProjection, XMMatrixMultiply(XMLoadFloat4x4(&info.matViewProjection), translation));
+	float depth = batch.first->pos.z;
+	float nearDepth = batch.first->pos.z;
+	for (const Sprite* sprite = batch.first + 1; sprite != batch.last; ++sprite) {
+		depth = std::max(depth, sprite->pos.z);
+		nearDepth = std::min(nearDepth, sprite->pos.z);
+	}
+	requestList.push_back({ batch.first, batch.last, batch.cellList, &pso, &texture.Resolve(), batchInfo, batch.format, false, nullptr, depth, nearDepth, nullptr, &batch });
+	stats.spriteCount += static_cast<uint32_t>(batch.GetSpriteCount());
+	return true;
+}
+
+/**
+* 描画要求を追加する.
+*
+* テクスチャはここでResolveし、ソートキーの深度にはスプライトのZ座標の最大値(不透明パスでは最小値)を使う.
+*/
+void Layer::AddRequest(const Sprite* first, const Sprite* last, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, VertexFormat format, bool isInstanced, const uint8_t* visibleMask)
+{
+	float depth = first->pos.z;
+	float nearDepth = first->pos.z;
+	for (const Sprite* sprite = first + 1; sprite != last; ++sprite) {
+		depth = std::max(depth, sprite->pos.z);
+		nearDepth = std::min(nearDepth, sprite->pos.z);
+	}
+	requestList.push_back({ first, last, cellList, &pso, &texture.Resolve(), info, format, isInstanced, visibleMask, depth, nearDepth, nullptr, nullptr });
+	stats.spriteCount += static_cast<uint32_t>(last - first);
+}
+
+/**
+* 描画要求が不透明パスを使うか調べる.
+*
+* 不透明パス用のPSOを持つPSOで描画する要求が対象. インスタンス描画、文字列、静的バッチは対象外.
+*/
+bool Layer::Request::HasOpaquePass() const
+{
+	return !isInstanced && !text && !batch && pso->opaque;
+}
+
+/**
+* Fileインターフェイスの実装クラス.
+*/
+class FileImpl : public File
+{
+public:
+	FileImpl() {}
+	virtual ~FileImpl() {}
+	virtual const CellList* Get(uint32_t no) const {
+		if (no >= clList.size()) {
+			return nullptr;
+		}
+		return &clList[no];
+	}
+	virtual size_t Size() const { return clList.size(); }
+
+	std::vector<CellList> clList;
+};
+
+/**
+* ファイルからセルリストを読み込む.
+*
+* @param filename      ファイル名.
+* @param imageFilename セルが参照する画像ファイル名. 指定すると、画像のアルファ値から各セルの形状を作成する.
+*                      nullptrの場合、全てのセルを矩形で描画する.
+*
+* @return 読み込んだセルリスト.
+*         読み込み失敗の場合はnullptrを返す.
+*
+* JSONフォーマットは次のとおり:
+* <pre>
+* [
+*   {
+*     "name" : "セルリスト名",
+*     "texsize" : [w, h],
+*     "list" : [
+*       {
+*         "uv" : [u, v],
+*         "tsize" : [tw, th],
+*         "ssize" : [sw, sh]
+*       },
+*       ...
+*     ]
+*   },
+*   ...
+* ]
+* </pre>
+*/
+FilePtr LoadFromJsonFile(const wchar_t* filename, const wchar_t* imageFilename)
+{
+	struct HandleHolder {
+		explicit HandleHolder(HANDLE h) : handle(h) {}
+		~HandleHolder() { if (handle != INVALID_HANDLE_VALUE) { CloseHandle(handle); } }
+		HANDLE handle;
+		operator HANDLE() { return handle; }
+		operator HANDLE() const { return handle; }
+	};
+
+	std::shared_ptr<FileImpl> af(new FileImpl);
+
+	HandleHolder h(CreateFileW(filename, GENERIC_READ, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+	if (h == INVALID_HANDLE_VALUE) {
+		return af;
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(h, &size)) {
+		return af;
+	}
+	if (size.QuadPart > std::numeric_limits<size_t>::max()) {
+		return af;
+	}
+	std::vector<char> buffer;
+	buffer.resize(static_cast<size_t>(size.QuadPart));
+	DWORD readBytes;
+	if (!ReadFile(h, &buffer[0], buffer.size(), &readBytes, nullptr)) {
+		return af;
+	}
+	const Json::Value json = Json::Parse(buffer.data());
+	if (json.type != Json::Type::Array) {
+		return af;
+	}
+
+	// 画像が指定されていれば、セルの形状を作成するためにアルファ値を読み込む.
+	// 読み込めなかった場合は、全てのセルを矩形で描画する.
+	std::vector<uint8_t> alpha;
+	UINT imageWidth = 0;
+	UINT imageHeight = 0;
+	if (imageFilename && !Resource::LoadAlphaMap(imageFilename, alpha, imageWidth, imageHeight)) {
+		alpha.clear();
+	}
+
+	for (const Json::Value& e : json.array) {
+		if (e.type != Json::Type::Object) {
+			break;
+		}
+		const Json::Object::const_iterator itrName = e.object.find("name");
+		if (itrName == e.object.end() || itrName->second.type != Json::Type::String) {
+			break;
+		}
+		const Json::Object::const_iterator itrTexSize = e.object.find("texsize");
+		if (itrTexSize == e.object.end() || itrTexSize->second.type != Json::Type::Array || itrTexSize->second.array.size() < 2) {
+			break;
+		}
+		const XMVECTOR texsize = XMVectorReciprocal({ static_cast<float>(itrTexSize->second.array[0].number), static_cast<float>(itrTexSize->second.array[1].number) });
+		CellList al;
+		al.name = itrName->second.string;
+		const Json::Object::const_iterator itrList = e.object.find("list");
+		if (itrList == e.object.end() || itrList->second.type != Json::Type::Array) {
+			break;
+		}
+		for (const Json::Value& data : itrList->second.array) {
+			if (data.type != Json::Type::Object) {
+				return af;
+			}
+			Cell cell;
+			const Json::Array& uv = data.object.find("uv")->second.array;
+			cell.uv.x = uv.size() > 0 ? static_cast<float>(uv[0].number) : 0.0f;
+			cell.uv.y = uv.size() > 1 ? static_cast<float>(uv[1].number) : 0.0f;
+			XMStoreFloat2(&cell.uv, XMVectorMultiply(XMLoadFloat2(&cell.uv), texsize));
+			const Json::Array& tsize = data.object.find("tsize")->second.array;
+			cell.tsize.x = tsize.size() > 0 ? static_cast<float>(tsize[0].number) : 0.0f;
+			cell.tsize.y = tsize.size() > 1 ? static_cast<float>(tsize[1].number) : 0.0f;
+			XMStoreFloat2(&cell.tsize, XMVectorMultiply(XMLoadFloat2(&cell.tsize), texsize));
+			const Json::Array& ssize = data.object.find("ssize")->second.array;
+			cell.ssize.x = ssize.size() > 0 ? static_cast<float>(ssize[0].number) : 0.0f;
+			cell.ssize.y = ssize.size() > 1 ? static_cast<float>(ssize[1].number) : 0.0f;
+			cell.offset = XMFLOAT2(0, 0);
+			cell.xadvance = cell.ssize.x;
+			cell.meshVertexCount = 0;
+			cell.opaque = false;
+			if (!alpha.empty()) {
+				BuildCellMesh(cell, alpha.data(), imageWidth, imageHeight);
+			}
+			al.list.push_back(cell);
+		}
+		af->clList.push_back(al);
+	}
+
+	return af;
+}
+
+/**
+* セルの不透明部分を囲む形状を作成し、セルが完全に不透明かどうかを調べる.
+*
+* セルに不透明なピクセルがない場合、形状は作成されず矩形で描画される.
+* テクスチャの補間では周囲のピクセルも参照されるため、周囲1ピクセルまで完全に不透明な場合にopaqueをtrueにする.
+*
+* @param cell   形状を作成するセル. uvとtsizeが設定されていること.
+* @param alpha  セルが参照する画像のアルファ値. 1ピクセル1バイトで、1行はwidthバイト.
+* @param width  画像の幅.
+* @param height 画像の高さ.
+*/
+void BuildCellMesh(Cell& cell, const uint8_t* alpha, uint32_t width, uint32_t height)
+{
+	cell.meshVertexCount = 0;
+	cell.opaque = false;
+	const float w = static_cast<float>(width);
+	const float h = static_cast<float>(height);
+	const uint32_t left = static_cast<uint32_t>(std::min(std::max(cell.uv.x * w + 0.5f, 0.0f), w));
+	const uint32_t top = static_cast<uint32_t>(std::min(std::max(cell.uv.y * h + 0.5f, 0.0f), h));
+	const uint32_t right = static_cast<uint32_t>(std::min(std::max((cell.uv.x + cell.tsize.x) * w + 0.5f, 0.0f), w));
+	const uint32_t bottom = static_cast<uint32_t>(std::min(std::max((cell.uv.y + cell.tsize.y) * h + 0.5f, 0.0f), h));
+	if (right <= left || bottom <= top) {
+		return;
+	}
+	const uint32_t outerLeft = left > 0 ? left - 1 : 0;
+	const uint32_t outerTop = top > 0 ? top - 1 : 0;
+	const uint32_t outerRight = std::min(right + 1, width);
+	const uint32_t outerBottom = std::min(bottom + 1, height);
+	cell.opaque = SpriteMesh::IsOpaque(alpha, width, outerLeft, outerTop, outerRight - outerLeft, outerBottom - outerTop);
+	SpriteMesh::Polygon polygon;
+	if (!SpriteMesh::Build(alpha, width, left, top, right - left, bottom - top, polygon)) {
+		return;
+	}
+	cell.meshVertexCount = polygon.count;
+	for (uint32_t i = 0; i < polygon.count; ++i) {
+		cell.mesh[i] = XMFLOAT2(polygon.vertexList[i][0], polygon.vertexList[i][1]);
+	}
+}
+
+/**
+* 画像ファイルのアルファ値から、セルの形状と不透明かどうかを設定する.
+*
+* @param first         セル配列の先頭. uvとtsizeが設定されていること.
+* @param last          セル配列の終端.
+* @param imageFilename セルが参照する画像ファイル名.
+*
+* @retval true  設定成功.
+* @retval false 画像を読み込めなかった. セルは変更されない.
+*/
+bool BuildCellMeshFromFile(Cell* first, Cell* last, const wchar_t* imageFilename)
+{
+	std::vector<uint8_t> alpha;
+	UINT width, height;
+	if (!Resource::LoadAlphaMap(imageFilename, alpha, width, height)) {
+		return false;
+	}
+	for (; first != last; ++first) {
+		BuildCellMesh(*first, alpha.data(), width, height);
+	}
+	return true;
+}
+
+/**
+* フォントファイルを読み込む.
+*
+* @param filename フォントファイル名.
+*
+* @retval true  読み込み成功.
+* @retval false 読み込み失敗.
+*/
+CellList LoadFontFromFile(const wchar_t* filename)
+{
+  std::unique_ptr<std::remove_pointer<HANDLE>::type, decltype(&CloseHandle)> h(
+    CreateFileW(filename, GENERIC_READ, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr),
+    CloseHandle
+  );
+  if (h.get() == INVALID_HANDLE_VALUE) {
+    return {};
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(h.get(), &size)) {
+    return {};
+  }
+  std::string buffer;
+  buffer.resize(static_cast<size_t>(size.QuadPart));
+  DWORD readBytes;
+  if (!ReadFile(h.get(), &buffer[0], buffer.size(), &readBytes, nullptr)) {
+    return {};
+  }
+
+  int line = 1;
+  char name[128];
+  size_t nextOffset = 0;
+  int ret = sscanf(&buffer[nextOffset], "info face=%127s size=%*d bold=%*d italic=%*d charset=%*s"
+    " unicode=%*d stretchH=%*d smooth=%*d aa=%*d padding=%*d,%*d,%*d,%*d spacing=%*d,%*d", name);
+  if (ret < 1) {
+	  std::cerr << "ERROR: '" << filename << "'の読み込みに失敗(line=" << line << ")" << std::endl;
+	  return {};
+  }
+  ++line;
+
+  nextOffset = buffer.find('\n', nextOffset) + 1;
+  XMFLOAT2 scale;
+  ret = sscanf(&buffer[nextOffset], " common lineHeight=%*d base=%*d scaleW=%f scaleH=%f pages=%*d packed=%*d", &scale.x, &scale.y);
+  if (ret < 2) {
+    std::cerr << "ERROR: '" << filename << "'の読み込みに失敗(line=" << line << ")" << std::endl;
+    return {};
+  }
+  const XMFLOAT2 reciprocalScale(1.0f / scale.x, 1.0f / scale.y);
+  ++line;
+
+  nextOffset = buffer.find('\n', nextOffset) + 1;
+  ret = sscanf(&buffer[nextOffset], " page id=%*d file=%*s");
+  ++line;
+
+  nextOffset = buffer.find('\n', nextOffset) + 1;
+  int charCount;
+  ret = sscanf(&buffer[nextOffset], " chars count=%d", &charCount);
+  if (ret < 1) {
+    std::cerr << "ERROR: '" << filename << "'の読み込みに失敗(line=" << line << ")" << std::endl;
+    return {};
+  }
+  ++line;
+
+  CellList fontList;
+  fontList.list.resize(256);
+  for (int i = 0; i < charCount; ++i) {
+    nextOffset = buffer.find('\n', nextOffset);
+    if (nextOffset == std::string::npos) {
+      break;
+    }
+    ++nextOffset;
+
+    unsigned int charCode;
+    Cell cell;
+    XMFLOAT2 uv, size, offset;
+	float xadvance;
+    ret = sscanf(&buffer[nextOffset], " char id=%u x=%f y=%f width=%f height=%f xoffset=%f yoffset=%f xadvance=%f page=%*d chnl=%*d", &charCode, &uv.x, &uv.y, &size.x, &size.y, &offset.x, &offset.y, &xadvance);
+    if (ret < 8) {
+      std::cerr << "ERROR: '" << filename << "'の読み込みに失敗(line=" << line << ")" << std::endl;
+      return {};
+    }
+    cell.uv = XMFLOAT2(uv.x * reciprocalScale.x, uv.y * reciprocalScale.y);
+    cell.tsize = XMFLOAT2(size.x * reciprocalScale.x, size.y * reciprocalScale.y);
+    cell.ssize = XMFLOAT2(size.x, size.y);
+	cell.offset = XMFLOAT2(size.x * 0.5f + offset.x, size.y * 0.5f + offset.y);
+	cell.xadvance = xadvance;
+	cell.meshVertexCount = 0;
+	cell.opaque = false;
+    if (charCode >= 0 && charCode < fontList.list.size()) {
+      fontList.list[charCode] = cell;
+    }
+    ++line;
+  }
+  fontList.name.assign(name + 1);
+  fontList.name.pop_back();
+  return fontList;
+}
+
+/**
+* フォント画像から距離場フォントを作成する.
+*
+* 各グリフの距離場を1枚の画像にまとめ、セルのテクスチャ座標と表示サイズを距離場の画像に合わせて更新する.
+* 距離場にはグリフの周囲にspreadピクセルの余白が付くため、表示サイズも余白の分だけ大きくなる.
+* 余白を含めた中心位置が変わらないように、offsetも補正する.
+*
+* @param fontList      LoadFontFromFileで読み込んだフォント. セル情報が距離場用に更新される.
+* @param imageFilename fontListが参照するフォント画像ファイル名.
+* @param atlas         作成した距離場の画像を格納するオブジェクト.
+*
+* @retval true  作成成功.
+* @retval false 作成失敗. fontListは変更されない.
+*/
+bool CreateDistanceFieldFont(CellList& fontList, const wchar_t* imageFilename, DistanceField::Atlas& atlas)
+{
+	static const uint32_t scale = 2;
+	static const uint32_t spread = 8;
+	static const uint32_t atlasWidth = 256;
+
+	std::vector<uint8_t> alpha;
+	UINT width, height;
+	if (!Resource::LoadAlphaMap(imageFilename, alpha, width, height)) {
+		return false;
+	}
+	const float w = static_cast<float>(width);
+	const float h = static_cast<float>(height);
+	std::vector<DistanceField::Rect> glyphList;
+	glyphList.reserve(fontList.list.size());
+	for (const Cell& cell : fontList.list) {
+		const uint32_t left = static_cast<uint32_t>(std::min(std::max(cell.uv.x * w + 0.5f, 0.0f), w));
+		const uint32_t top = static_cast<uint32_t>(std::min(std::max(cell.uv.y * h + 0.5f, 0.0f), h));
+		const uint32_t right = static_cast<uint32_t>(std::min(std::max((cell.uv.x + cell.tsize.x) * w + 0.5f, 0.0f), w));
+		const uint32_t bottom = static_cast<uint32_t>(std::min(std::max((cell.uv.y + cell.tsize.y) * h + 0.5f, 0.0f), h));
+		if (right <= left || bottom <= top) {
+			glyphList.push_back({ 0, 0, 0, 0 });
+		} else {
+			glyphList.push_back({ left, top, right - left, bottom - top });
+		}
+	}
+	if (!DistanceField::BuildAtlas(alpha.data(), width, glyphList.data(), glyphList.size(), scale, spread, atlasWidth, atlas)) {
+		return false;
+	}
+
+	const XMFLOAT2 reciprocalSize(1.0f / static_cast<float>(atlas.width), 1.0f / static_cast<float>(atlas.height));
+	for (size_t i = 0; i < fontList.list.size(); ++i) {
+		Cell& cell = fontList.list[i];
+		const DistanceField::Rect& r = atlas.rectList[i];
+		if (r.width == 0 || r.height == 0) {
+			cell.tsize = XMFLOAT2(0, 0);
+			continue;
+		}
+		// 距離場の左上は元のグリフの左上から(-spread, -spread)の位置にある.
+		const XMFLOAT2 ssize(static_cast<float>(r.width * scale), static_cast<float>(r.height * scale));
+		cell.offset.x += ssize.x * 0.5f - cell.ssize.x * 0.5f - static_cast<float>(spread);
+		cell.offset.y += ssize.y * 0.5f - cell.ssize.y * 0.5f - static_cast<float>(spread);
+		cell.ssize = ssize;
+		cell.uv = XMFLOAT2(static_cast<float>(r.x) * reciprocalSize.x, static_cast<float>(r.y) * reciprocalSize.y);
+		cell.tsize = XMFLOAT2(static_cast<float>(r.width) * reciprocalSize.x, static_cast<float>(r.height) * reciprocalSize.y);
+		cell.meshVertexCount = 0;
+	}
+	return true;
+}
+
+/**
+* 空の文字列を作成する.
+*
+* SetFontでフォントを設定するまで、SetTextで設定した文字列は配置されない.
+*/
+Text::Text() :
+	pos(0, 0, 0),
+	scale(1, 1),
+	color{ XMFLOAT4(1, 1, 1, 1), XMFLOAT4(1, 1, 1, 1) },
+	blendMode(BlendMode_Alpha),
+	palette(0),
+	font(nullptr),
+	codeOffset(0),
+	width(0)
+{
+}
+
+/**
+* フォントを指定して空の文字列を作成する.
+*
+* @param f      文字のセルの配列.
+* @param offset 文字コードからセル番号への変換で引く値.
+* @param p      最初の文字の位置.
+* @param s      文字の拡大率.
+* @param col    文字の色.
+*/
+Text::Text(const CellList& f, uint32_t offset, XMFLOAT3 p, XMFLOAT2 s, XMFLOAT4 col) :
+	pos(p),
+	scale(s),
+	color{ col, col },
+	blendMode(BlendMode_Alpha),
+	palette(0),
+	font(&f),
+	codeOffset(offset),
+	width(0)
+{
+}
+
+/**
+* フォントを設定し、文字列を配置し直す.
+*
+* @param f      文字のセルの配列.
+* @param offset 文字コードからセル番号への変換で引く値.
+*/
+void Text::SetFont(const CellList& f, uint32_t offset)
+{
+	font = &f;
+	codeOffset = offset;
+	Layout();
+}
+
+/**
+* 文字列を設定する.
+*
+* 現在の文字列と同じなら何もしない.
+*
+* @param str 設定する文字列.
+*/
+void Text::SetText(const char* str)
+{
+	SetText(str, strlen(str));
+}
+
+/**
+* 文字列を設定する.
+*
+* 現在の文字列と同じなら何もしない.
+*
+* @param str    設定する文字列.
+* @param length 設定する文字数.
+*/
+void Text::SetText(const char* str, size_t length)
+{
+	if (text.size() == length && text.compare(0, length, str, length) == 0) {
+		return;
+	}
+	text.assign(str, length);
+	Layout();
+}
+
+/**
+* 文字列のグリフを配置する.
+*/
+void Text::Layout()
+{
+	glyphList.clear();
+	width = 0;
+	if (!font) {
+		return;
+	}
+	for (const char c : text) {
+		const uint32_t cellIndex = static_cast<uint8_t>(c) - codeOffset;
+		if (cellIndex >= font->list.size()) {
+			continue;
+		}
+		const Cell& cell = font->list[cellIndex];
+		if (cell.ssize.x != 0 && cell.ssize.y != 0) {
+			glyphList.push_back({ &cell, width });
+		}
+		width += cell.xadvance;
+	}
+}
+
+StaticBatch::StaticBatch() :
+	translation(0, 0),
+	renderer(nullptr),
+	first(nullptr),
+	last(nullptr),
+	cellList(nullptr),
+	format(VertexFormat_Float),
+	hasIndex(false),
+	isUploadFailed(false)
+{
+}
+
+/**
+* デストラクタ.
+*
+* バッファはGPUが使い終えた後でRendererが解放する.
+*/
+StaticBatch::~StaticBatch()
+{
+	Release();
+}
+
+/**
+* 静的バッチを初期化する.
+*
+* 全てのスプライトの頂点とインデックスを格納できるバッファを作成する. 頂点は最初に描画するRenderer::Endで作成して転送する.
+* 初期化済みの場合は、以前のバッファを解放してから作り直す.
+*
+* @param renderer   描画に使うRenderer.
+* @param spriteList スプライトのリスト.
+* @param cellList   描画に使用するセルデータのリスト.
+* @param format     頂点データ形式. 描画に使うPSOの頂点レイアウトと一致させること.
+*
+* @retval true  初期化成功.
+* @retval false 初期化失敗.
+*/
+bool StaticBatch::Init(Renderer& renderer, const std::vector<Sprite>& spriteList, const Cell* cellList, VertexFormat format)
+{
+	if (spriteList.empty()) {
+		return Init(renderer, nullptr, nullptr, cellList, format);
+	}
+	return Init(renderer, &*spriteList.begin(), (&*spriteList.begin()) + spriteList.size(), cellList, format);
+}
+
+bool StaticBatch::Init(Renderer& renderer, const Sprite* first, const Sprite* last, const Cell* cellList, VertexFormat format)
+{
+	Release();
+	this->renderer = &renderer;
+	this->first = first;
+	this->last = last;
+	this->cellList = cellList;
+	this->format = format;
+	const size_t spriteCount = GetSpriteCount();
+	if (spriteCount == 0) {
+		return true;
+	}
+	const UINT64 size = spriteCount * (SpriteMesh::maxVertexCount * GetVertexStride(format) + staticIndexCountPerSprite * sizeof(DWORD));
+	if (!renderer.staticBufferHeap.CreateResource(CD3DX12_RESOURCE_DESC::Buffer(size), D3D12_RESOURCE_STATE_COMMON, nullptr, buffer, allocation)) {
+		return false;
+	}
+	buffer->SetName(L"Sprite Static Batch");
+	MarkDirty();
+	return true;
+}
+
+/**
+* スプライトを変更したことを知らせる.
+*
+* 範囲内のスプライトの頂点は、次に描画するRenderer::Endで作り直して転送する.
+*
+* @param first 変更したスプライトの範囲の先頭. Initで渡したスプライトの先頭を0とする番号.
+* @param last  変更したスプライトの範囲の終端.
+*/
+void StaticBatch::MarkDirty(size_t first, size_t last)
+{
+	last = std::min(last, GetSpriteCount());
+	if (first < last) {
+		dirtyRangeList.push_back(std::make_pair(first, last));
+	}
+}
+
+/**
+* 全てのスプライトを変更したことを知らせる.
+*/
+void StaticBatch::MarkDirty()
+{
+	dirtyRangeList.clear();
+	MarkDirty(0, GetSpriteCount());
+}
+
+/**
+* バッファを解放する.
+*/
+void StaticBatch::Release()
+{
+	if (renderer && buffer) {
+		renderer->ReleaseStaticBuffer(buffer, allocation);
+	}
+	buffer.Reset();
+	allocation = Resource::ResourceHeap::Allocation();
+	dirtyRangeList.clear();
+	hasIndex = false;
+}
+
+/**
+* 描画前に転送が必要か調べる.
+*
+* @retval true  変更されたスプライトがある. または、まだ転送していない.
+* @retval false 転送済みの頂点をそのまま描画できる.
+*/
+bool StaticBatch::IsUploadRequired() const
+{
+	return !hasIndex || !dirtyRangeList.empty();
+}
+
+/**
+* 文字列の描画範囲の横幅を取得する.
+*
+* @param cellList 文字フォント情報を格納しているセルリスト.
+* @param text     文字列.
+*
+* @return 文字列の横幅.
+*/
+float GetTextWidth(const CellList& cellList, const char* text)
+{
+	float width = 0;
+	while (*text != '\0') {
+		width += cellList.list[*text].xadvance;
+		++text;
+	}
+	return width;
+}
+
+} // namespace Sprite
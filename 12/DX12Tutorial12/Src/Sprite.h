@@ -1,145 +1,464 @@
-/**
-* @file Sprite.h
-*/
-#pragma once
-#include "Animation.h"
-#include "Action.h"
-#include <d3d12.h>
-#include <DirectXMath.h>
-#include <wrl/client.h>
-#include <vector>
-
-#include "Collision.h"
-
-namespace Resource {
-struct Texture;
-class ResourceLoader;
-}
-struct PSO;
-
-namespace Sprite {
-
-/**
-* Zf[^^.
-*/
-struct Cell {
-	DirectX::XMFLOAT2 uv; ///< eNX`̍W.
-	DirectX::XMFLOAT2 tsize; ///< eNX`̏cTCY.
-	DirectX::XMFLOAT2 ssize; ///< XN[W̏cTCY.
-	DirectX::XMFLOAT2 offset; ///< XN[W̕\ʒu␳.
-	float xadvance; ///< ̃ZXW.
-};
-
-/**
-* XvCg.
-*/
-struct Sprite
-{
-	Sprite() = delete;
-	Sprite(const AnimationList* al, DirectX::XMFLOAT3 p, float rot = 0, DirectX::XMFLOAT2 s = DirectX::XMFLOAT2(1, 1), DirectX::XMFLOAT4 col = DirectX::XMFLOAT4(1, 1, 1, 1));
-	void SetSeqIndex(uint32_t no) { animeController.SetSeqIndex(no); }
-	void SetCellIndex(uint32_t no) { animeController.SetCellIndex(no); }
-	void SetActionList(const Action::List* al) { actController.SetList(al); }
-	void SetAction(uint32_t no) { actController.SetSeqIndex(no); }
-	void SetCollisionId(int32_t id) { collisionId = id; }
-	int32_t GetCollisionId() const { return collisionId; }
-	void Update(double delta) {
-		animeController.Update(delta);
-		actController.Update(static_cast<float>(delta), this);
-	}
-	uint32_t GetCellIndex() const { return animeController.GetData().cellIndex; }
-	size_t GetSeqCount() const { return animeController.GetSeqCount(); }
-
-	AnimationController animeController;
-	Action::Controller actController;
-	int32_t hp;
-	int32_t collisionId;
-	DirectX::XMFLOAT3 pos; ///< XN[W̃XvCg̈ʒu.
-	float rotation; ///< 摜̉]p(WA).
-	DirectX::XMFLOAT2 scale; ///< 摜̊g嗦.
-	DirectX::XMFLOAT4 color[2]; ///< 摜̐F.
-	DirectX::XMFLOAT2 velocity;
-	int param[4];
-	Collision::Shape collisionShape;
-};
-
-/**
-* XvCg`.
-*/
-struct RenderingInfo
-{
-	D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle; ///< `惌_[^[Qbg.
-	D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle; ///< `[xobt@.
-	D3D12_VIEWPORT viewport; ///< `pr[|[g.
-	D3D12_RECT scissorRect; ///< `pVUO`.
-	ID3D12DescriptorHeap* texDescHeap; ///< eNX`p̃fXNv^q[v.
-	DirectX::XMFLOAT4X4 matViewProjection; ///< `ɎgpWϊs.
-};
-
-/**
-* XvCg`NX.
-*/
-class Renderer
-{
-public:
-	Renderer();
-	bool Init(Microsoft::WRL::ComPtr<ID3D12Device> device, int numFrameBuffer, int maxSprite, Resource::ResourceLoader& resourceLoader);
-	bool Begin(int frameIndex);
-	bool Draw(const std::vector<Sprite>& spriteList, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, RenderingInfo& info);
-	bool Draw(const Sprite* first, const Sprite* last, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, RenderingInfo& info);
-	bool End();
-	ID3D12GraphicsCommandList* GetCommandList();
-
-private:
-	size_t maxSpriteCount;
-	int frameBufferCount;
-
-	struct FrameResource
-	{
-		Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
-		Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer;
-		D3D12_VERTEX_BUFFER_VIEW vertexBufferView;
-		void* vertexBufferGPUAddress;
-	};
-	std::vector<FrameResource> frameResourceList;
-	int currentFrameIndex;
-	int spriteCount;
-
-	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList;
-	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer;
-	D3D12_INDEX_BUFFER_VIEW indexBufferView;
-};
-
-/**
-* Zf[^̔z.
-*/
-struct CellList
-{
-	std::string name; ///< Xg.
-	std::vector<Cell> list; ///< Zf[^̔z.
-};
-
-/**
-* CellList܂Ƃ߂IuWFNg𑀍삷邽߂̃C^[tFCXNX.
-*
-* LoadFromJsonFile()֐găC^[tFCXɑΉIuWFNg擾AGet()
-* XCellListANZX.
-*/
-class File
-{
-public:
-	File() = default;
-	File(const File&) = delete;
-	File& operator=(const File&) = delete;
-	virtual ~File() {}
-
-	virtual const CellList* Get(uint32_t no) const = 0;
-	virtual size_t Size() const = 0;
-};
-typedef std::shared_ptr<File> FilePtr;
-
-FilePtr LoadFromJsonFile(const wchar_t*);
-CellList LoadFontFromFile(const wchar_t*);
-float GetTextWidth(const CellList& cellList, const char* text);
-
-} // namespace Sprite
+/**
+* @file Sprite.h
+*/
+#pragma once
+#include "Animation.h"
+#include "Action.h"
+#include "ResourceHeap.h"
+#include "UploadArena.h"
+#include "SpriteMesh.h"
+#include "DistanceField.h"
+#include "SpriteInstance.h"
+#include "ThreadPool.h"
+#include "RadixSort.h"
+#include <d3d12.h>
+#include <DirectXMath.h>
+#include <wrl/client.h>
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+#include "Collision.h"
+
+namespace Resource {
+struct Texture;
+class ResourceLoader;
+}
+struct PSO;
+
+namespace Sprite {
+
+/**
+* セルデータ型.
+*
+* meshVertexCountが0の場合、セル全体の矩形を描画する.
+* 0以外の場合、meshの凸多角形を描画して透明部分の描画を省く.
+* opaqueがtrueのセルは、Rendererの不透明パスで描画できる.
+*/
+struct Cell {
+	DirectX::XMFLOAT2 uv; ///< テクスチャ上の左上座標.
+	DirectX::XMFLOAT2 tsize; ///< テクスチャ上の縦横サイズ.
+	DirectX::XMFLOAT2 ssize; ///< スクリーン座標上の縦横サイズ.
+	DirectX::XMFLOAT2 offset; ///< スクリーン座標上の表示位置補正.
+	float xadvance; ///< 次のセルのX座標.
+	uint32_t meshVertexCount; ///< 形状の頂点数.
+	DirectX::XMFLOAT2 mesh[SpriteMesh::maxVertexCount]; ///< 形状の頂点. セルの左上を(0, 0)、右下を(1, 1)とする.
+	bool opaque; ///< セルの全てのピクセルが完全に不透明ならtrue.
+};
+
+/**
+* スプライトの合成方法.
+*
+* テクスチャと頂点カラーは乗算済みアルファで合成されるため、合成方法が異なるスプライトも同じPSOでまとめて描画できる.
+*/
+enum BlendMode
+{
+	BlendMode_Alpha, ///< アルファ合成.
+	BlendMode_Add, ///< 加算合成.
+};
+
+/**
+* スプライトの頂点データ形式.
+*
+* 描画に使うPSOの頂点レイアウトと一致させること.
+*/
+enum VertexFormat
+{
+	VertexFormat_Float, ///< 1頂点40バイト. PSOType_Sprite, PSOType_IndexedSprite, PSOType_DistanceFieldSpriteで描画する.
+	VertexFormat_Compact, ///< 1頂点16バイト. PSOType_CompactSprite, PSOType_CompactIndexedSpriteで描画する.
+};
+
+/**
+* スプライト.
+*/
+struct Sprite
+{
+	Sprite() = delete;
+	Sprite(const AnimationList* al, DirectX::XMFLOAT3 p, float rot = 0, DirectX::XMFLOAT2 s = DirectX::XMFLOAT2(1, 1), DirectX::XMFLOAT4 col = DirectX::XMFLOAT4(1, 1, 1, 1));
+	void SetSeqIndex(uint32_t no) { animeController.SetSeqIndex(no); }
+	void SetCellIndex(uint32_t no) { animeController.SetCellIndex(no); }
+	void SetActionList(const Action::List* al) { actController.SetList(al); }
+	void SetAction(uint32_t no) { actController.SetSeqIndex(no); }
+	void SetCollisionId(int32_t id) { collisionId = id; }
+	int32_t GetCollisionId() const { return collisionId; }
+	void Update(double delta) {
+		animeController.Update(delta);
+		actController.Update(static_cast<float>(delta), this);
+	}
+	uint32_t GetCellIndex() const { return animeController.GetData().cellIndex; }
+	size_t GetSeqCount() const { return animeController.GetSeqCount(); }
+
+	AnimationController animeController;
+	Action::Controller actController;
+	int32_t hp;
+	int32_t collisionId;
+	DirectX::XMFLOAT3 pos; ///< スクリーン座標上のスプライトの位置.
+	float rotation; ///< 画像の回転角(ラジアン).
+	DirectX::XMFLOAT2 scale; ///< 画像の拡大率.
+	DirectX::XMFLOAT4 color[2]; ///< 画像の色.
+	BlendMode blendMode; ///< 合成方法.
+	uint32_t palette; ///< パレット番号(Palette::Variant). パレット画像テクスチャで描画する場合のみ有効.
+	DirectX::XMFLOAT2 velocity;
+	int param[4];
+	Collision::Shape collisionShape;
+};
+
+/**
+* スプライト描画情報.
+*/
+struct RenderingInfo
+{
+	D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle; ///< 描画先レンダーターゲット.
+	D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle; ///< 描画先深度バッファ.
+	D3D12_VIEWPORT viewport; ///< 描画用ビューポート.
+	D3D12_RECT scissorRect; ///< 描画用シザリング矩形.
+	ID3D12DescriptorHeap* texDescHeap; ///< テクスチャ用のデスクリプタヒープ.
+	DirectX::XMFLOAT4X4 matViewProjection; ///< 描画に使用する座標変換行列.
+};
+
+class Renderer;
+class Text;
+class StaticBatch;
+
+/**
+* スプライト描画の統計情報.
+*
+* spriteCountは、maskedCount、zeroScaleCount、culledCount、drawnCount、truncatedCountの合計と等しい.
+*/
+struct RenderingStatistics
+{
+	uint32_t requestCount; ///< 描画要求の数.
+	uint32_t drawCallCount; ///< コマンドリストに積んだ描画コマンドの数.
+	uint32_t spriteCount; ///< 描画要求に含まれるスプライトの数. 文字列はグリフ毎に数える.
+	uint32_t maskedCount; ///< visibleMaskで除外したスプライトの数.
+	uint32_t zeroScaleCount; ///< 拡大率が0のため除外したスプライトの数.
+	uint32_t culledCount; ///< ビューポートの外にあるため除外したスプライトの数.
+	uint32_t drawnCount; ///< 描画したスプライトの数.
+	uint32_t truncatedCount; ///< 領域を確保できなかったなどの理由で描画できなかったスプライトの数.
+	uint32_t stateChangeCount; ///< ルートシグネチャ、PSO、デスクリプタヒープ、描画情報を設定した回数.
+	uint32_t textureSwitchCount; ///< テクスチャを設定した回数.
+	uint64_t vertexBytes; ///< 頂点、インデックス、インスタンスデータとして書き込んだバイト数.
+	double drawTime; ///< Draw、DrawInstanced、AddLayerの処理時間の合計(秒).
+	double endTime; ///< Endの処理時間(秒). レイヤーの記録を含む.
+};
+
+/**
+* スプライトの描画コマンドを記録するレイヤー.
+*
+* レイヤー毎にコマンドリストを持つため、異なるレイヤーは別々のスレッドで同時に記録できる.
+* レイヤーはRendererが作成し、作成された順にGPUで実行される.
+*
+* Draw、DrawInstancedは描画要求を溜めるだけで、Renderer::EndでPSO、テクスチャ、深度(奥から手前)の順にソートしてから記録する.
+* 同じ状態で描画する要求は1回の描画コマンドにまとめる. そのため、レイヤー内では描画の順序が入れ替わることがある.
+* 重なりの順序を保証したい場合はレイヤーを分けること.
+* スプライトの配列はRenderer::Endまで変更してはならない.
+*
+* PSOにopaqueが設定されていれば、不透明なセルをアルファ1で描画するスプライトはレイヤー内の不透明パスに移し、
+* そのレイヤーの他のスプライトより先に手前から奥の順で深度を書き込みながら描画する.
+* そのため、同じレイヤー内では不透明パスを使うスプライトと他のスプライトの重なりはZ座標で決まる.
+* レイヤー間の順序は保たれるが、書き込んだ深度は後のレイヤーにも残る. 後のレイヤーのスプライトを前のレイヤーの不透明なスプライトより
+* 奥のZ座標に置くと、深度テストで隠れるので注意すること.
+*
+* 拡大率が0のスプライト、visibleMaskの値が0のスプライト、ビューポートから外れたスプライトは頂点を作成しない.
+* visibleMaskはスプライトと同じ数の要素を持つ配列で、nullptrなら全てのスプライトを表示対象とする.
+* ビューポートとの判定は、matViewProjectionがビューポートをそのまま写す正射影であることを前提とする.
+*
+* Textを渡すDrawは、配置済みのグリフの頂点を直接書き込む. 文字列同士は同じ状態ならまとめて描画するが、スプライトとはまとめない.
+* StaticBatchを渡すDrawは頂点を書き込まず、バッチが保持するバッファを1回の描画コマンドで描画する. 他の描画要求とはまとめない.
+*/
+class Layer
+{
+public:
+	Layer(const Layer&) = delete;
+	Layer& operator=(const Layer&) = delete;
+
+	bool Draw(const std::vector<Sprite>& spriteList, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, VertexFormat format = VertexFormat_Float, const uint8_t* visibleMask = nullptr);
+	bool Draw(const Sprite* first, const Sprite* last, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, VertexFormat format = VertexFormat_Float, const uint8_t* visibleMask = nullptr);
+	bool DrawInstanced(const std::vector<Sprite>& spriteList, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, const uint8_t* visibleMask = nullptr);
+	bool DrawInstanced(const Sprite* first, const Sprite* last, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, const uint8_t* visibleMask = nullptr);
+	bool Draw(const Text& text, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, VertexFormat format = VertexFormat_Float);
+	bool Draw(const StaticBatch& batch, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info);
+
+private:
+	friend class Renderer;
+	explicit Layer(Renderer& r) : renderer(r) {}
+
+	/// 描画要求.
+	struct Request
+	{
+		const Sprite* first;
+		const Sprite* last;
+		const Cell* cellList;
+		const PSO* pso;
+		const Resource::Texture* texture; ///< Resolve済みのテクスチャ.
+		RenderingInfo info;
+		VertexFormat format;
+		bool isInstanced; ///< インスタンス描画ならtrue.
+		const uint8_t* visibleMask; ///< スプライト毎の表示フラグ. nullptrなら全て表示.
+		float depth; ///< スプライトのZ座標の最大値.
+		float nearDepth; ///< スプライトのZ座標の最小値. 不透明パスのソートに使う.
+		const Text* text; ///< 描画する文字列. スプライトの描画要求ならnullptr.
+		const StaticBatch* batch; ///< 描画する静的バッチ. 静的バッチの描画要求でなければnullptr.
+
+		bool HasOpaquePass() const;
+	};
+
+	void AddRequest(const Sprite* first, const Sprite* last, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, VertexFormat format, bool isInstanced, const uint8_t* visibleMask);
+
+	Renderer& renderer;
+	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList;
+	std::function<void(Layer&)> recorder; ///< Renderer::Endで呼び出す記録関数. 空ならRenderer::Drawなどで直接追加するレイヤー.
+	bool isOpaquePass; ///< 不透明パスを記録中ならtrue.
+
+	std::vector<Request> requestList; ///< 現在のフレームの描画要求.
+	std::vector<SortItem> sortList; ///< 描画要求のソート用配列.
+	std::vector<SortItem> sortWork; ///< RadixSortの作業用配列.
+	std::vector<const PSO*> psoKeyList; ///< ソートキーに使うPSOの番号表.
+	std::vector<const Resource::Texture*> textureKeyList; ///< ソートキーに使うテクスチャの番号表.
+	RenderingStatistics stats; ///< このレイヤーの統計情報. 時間以外の項目を使う.
+
+	// コマンドリストに設定済みの状態. 同じ状態の設定を省くために使う.
+	ID3D12RootSignature* boundRootSignature;
+	ID3D12PipelineState* boundPipelineState;
+	ID3D12DescriptorHeap* boundDescriptorHeap;
+	const Resource::Texture* boundTexture;
+	const RenderingInfo* boundInfo;
+
+	// 描画毎に使う作業用配列. レイヤー毎に持つことで、スレッド間で共有しないようにする.
+	std::vector<const Sprite*> drawSpriteList; ///< 描画するスプライト.
+	std::vector<const Cell*> drawCellList; ///< 各スプライトのセル.
+	std::vector<uint32_t> drawVertexOffsetList; ///< 各スプライトの頂点の書き込み位置. 描画の最初の頂点からの相対値. 末尾に総数を置く.
+	std::vector<uint32_t> drawIndexOffsetList; ///< 各スプライトのインデックスの書き込み位置. 描画の最初のインデックスからの相対値. 末尾に総数を置く.
+	std::vector<SortItem> drawSortList; ///< 不透明パスでスプライトを手前から並べるためのソート用配列.
+	std::vector<SpriteInstance::Instance> instanceList; ///< インスタンスバッファに書き込むインスタンスデータ.
+	std::vector<uint32_t> cellSlotList; ///< セル番号からセルテーブルの番号+1への変換表. 0はテーブルにないことを示す.
+	std::vector<uint32_t> cellIndexList; ///< セルテーブルに書き込むセル番号.
+};
+
+/**
+* スプライト描画クラス.
+*
+* 描画要求はLayerに追加する. AddLayerで追加したレイヤーの記録関数はEndでまとめて複数のスレッドで呼び出し、
+* Draw、DrawInstancedは呼び出したスレッドで直接レイヤーに追加する. レイヤーはGPUでは追加した順に実行される.
+* 描画コマンドはEndで記録する. レイヤー内の描画要求はソートされ、状態が同じものは1回の描画コマンドにまとめられる.
+* 静的バッチの頂点の転送もEndで記録し、全てのレイヤーより先に実行されるように並べる.
+*/
+class Renderer
+{
+public:
+	/// レイヤーの記録関数の型.
+	typedef std::function<void(Layer&)> LayerFunc;
+
+	Renderer();
+	bool Init(Microsoft::WRL::ComPtr<ID3D12Device> device, int numFrameBuffer, Resource::ResourceLoader& resourceLoader, Resource::ResourceHeap& bufferHeap);
+	bool Begin(int frameIndex);
+	bool AddLayer(LayerFunc func);
+	bool Draw(const std::vector<Sprite>& spriteList, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, VertexFormat format = VertexFormat_Float, const uint8_t* visibleMask = nullptr);
+	bool Draw(const Sprite* first, const Sprite* last, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, VertexFormat format = VertexFormat_Float, const uint8_t* visibleMask = nullptr);
+	bool DrawInstanced(const std::vector<Sprite>& spriteList, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, const uint8_t* visibleMask = nullptr);
+	bool DrawInstanced(const Sprite* first, const Sprite* last, const Cell* cellList, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, const uint8_t* visibleMask = nullptr);
+	bool Draw(const Text& text, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info, VertexFormat format = VertexFormat_Float);
+	bool Draw(const StaticBatch& batch, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info);
+	bool End();
+	const std::vector<ID3D12CommandList*>& GetCommandLists() const;
+	bool Signal(ID3D12CommandQueue* commandQueue);
+	void GetArenaStatistics(Resource::UploadArena::Statistics& stats) const { arena.GetStatistics(stats); }
+
+	const RenderingStatistics& GetStatistics() const { return statistics; }
+	void SetUploadStaged(bool staged) { isUploadStaged = staged; }
+	bool IsUploadStaged() const { return isUploadStaged; }
+	void SetStatisticsLogSize(size_t frameCount);
+	bool WriteStatisticsLog(const wchar_t* filename) const;
+
+private:
+	friend class Layer;
+	friend class StaticBatch;
+
+	Layer* AcquireLayer();
+	Layer* GetImmediateLayer();
+	Layer* AcquireUploadLayer();
+	void RecordLayer(Layer& layer);
+	void RecordPass(Layer& layer);
+	void RecordDraw(Layer& layer, size_t first, size_t last);
+	void RecordDrawInstanced(Layer& layer, const Layer::Request& request);
+	void RecordDrawText(Layer& layer, size_t first, size_t last);
+	void RecordDrawStaticBatch(Layer& layer, const Layer::Request& request);
+	bool RecordUpload(Layer& layer, const StaticBatch& batch);
+	void ReleaseStaticBuffer(Microsoft::WRL::ComPtr<ID3D12Resource>& buffer, Resource::ResourceHeap::Allocation& allocation);
+	void SetRenderingState(Layer& layer, const PSO& pso, const Resource::Texture& texture, const RenderingInfo& info);
+	template<typename T>
+	void FillVertex(Layer& layer, size_t spriteCount, T* v, DWORD* index, uint32_t baseVertex, DirectX::XMFLOAT2 offset);
+
+	Microsoft::WRL::ComPtr<ID3D12Device> device;
+	int frameBufferCount;
+
+	struct FrameResource
+	{
+		std::vector<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> commandAllocatorList; ///< レイヤー毎のコマンドアロケータ. 必要に応じて増やす.
+	};
+	std::vector<FrameResource> frameResourceList;
+	int currentFrameIndex;
+
+	// 頂点、インデックス、インスタンスデータの書き込み先. 複数のレイヤーから同時に確保するため、allocationMutexで保護する.
+	std::mutex allocationMutex;
+	Resource::UploadArena arena;
+
+	// 静的バッチのバッファ. 破棄されたバッファは、GPUが使い終えたことをfenceで確認してから解放する.
+	struct PendingBuffer
+	{
+		Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+		Resource::ResourceHeap::Allocation allocation;
+		UINT64 fenceValue; ///< 使用完了を示すフェンス値. 0ならまだSignalしていない.
+	};
+	Resource::ResourceHeap staticBufferHeap; ///< 静的バッチのバッファを配置するデフォルトヒープ.
+	Microsoft::WRL::ComPtr<ID3D12Fence> fence;
+	UINT64 fenceValue;
+	std::vector<PendingBuffer> pendingBufferList; ///< GPUの使用完了を待っているバッファ.
+
+	std::vector<std::unique_ptr<Layer>> layerList; ///< 作成済みのレイヤー. 先頭からlayerCount個を現在のフレームで使用する.
+	size_t layerCount; ///< 現在のフレームで使用しているレイヤーの数.
+	Layer* uploadLayer; ///< 現在のフレームの静的バッチの転送を記録したレイヤー. 転送がない場合はnullptr.
+	std::vector<const StaticBatch*> uploadBatchList; ///< 現在のフレームで転送を判定済みの静的バッチ.
+	std::vector<ID3D12CommandList*> submitList; ///< Endで作成する、実行順に並べたコマンドリストの配列.
+	RenderingStatistics statistics; ///< 現在または最後に描画したフレームの統計情報.
+	std::vector<RenderingStatistics> statisticsLog; ///< フレーム毎の統計情報のリングバッファ. 空なら記録しない.
+	size_t statisticsLogCount; ///< statisticsLogに記録したフレームの総数.
+	bool isUploadStaged; ///< 頂点、インデックス、インスタンスデータをWriteCombinerの作業領域を経由して書き込むならtrue. 既定はtrue.
+	ThreadPool threadPool; ///< レイヤーの記録と頂点の書き込みを分担するスレッド.
+};
+
+/**
+* セルデータの配列.
+*/
+struct CellList
+{
+	std::string name; ///< リスト名.
+	std::vector<Cell> list; ///< セルデータの配列.
+};
+
+/**
+* 文字列の描画データ.
+*
+* 1文字毎にSpriteを作らずに、フォントのセルから配置したグリフをLayer::Drawで直接頂点として書き込む.
+* グリフの配置は文字列かフォントが変わったときだけ計算し直すため、同じ文字列を毎フレーム設定してもよい.
+* 位置、拡大率、色は配置に影響しないので、いつでも変更できる.
+* 文字のセルは文字コードからcodeOffsetを引いた番号で参照する. セルのない文字は無視し、大きさが0のセルは送り幅だけ進める.
+* フォントのCellListはTextより長く存在し、変更しないこと.
+*/
+class Text
+{
+public:
+	/// 配置済みのグリフ.
+	struct Glyph
+	{
+		const Cell* cell; ///< 文字のセル.
+		float x; ///< 最初の文字からのX座標. 拡大率を掛ける前の値.
+	};
+
+	Text();
+	Text(const CellList& f, uint32_t offset, DirectX::XMFLOAT3 p, DirectX::XMFLOAT2 s = DirectX::XMFLOAT2(1, 1), DirectX::XMFLOAT4 col = DirectX::XMFLOAT4(1, 1, 1, 1));
+	void SetFont(const CellList& f, uint32_t offset = 0);
+	void SetText(const char* str);
+	void SetText(const char* str, size_t length);
+	const std::string& GetText() const { return text; }
+	const std::vector<Glyph>& GetGlyphList() const { return glyphList; }
+	float GetWidth() const { return width * scale.x; }
+
+	DirectX::XMFLOAT3 pos; ///< スクリーン座標上の最初の文字の位置. Spriteのposと同じく、セルのoffsetで補正して描画する.
+	DirectX::XMFLOAT2 scale; ///< 文字の拡大率.
+	DirectX::XMFLOAT4 color[2]; ///< 文字の色. color[0]が上端、color[1]が下端.
+	BlendMode blendMode; ///< 合成方法.
+	uint32_t palette; ///< パレット番号(Palette::Variant). パレット画像テクスチャで描画する場合のみ有効.
+
+private:
+	void Layout();
+
+	const CellList* font; ///< 文字のセルの配列.
+	uint32_t codeOffset; ///< 文字コードからセル番号への変換で引く値.
+	std::string text; ///< 配置済みの文字列.
+	std::vector<Glyph> glyphList; ///< 配置済みのグリフ.
+	float width; ///< 文字列の幅. 拡大率を掛ける前の値.
+};
+
+/**
+* 動かないスプライトの頂点を保持する静的バッチ.
+*
+* 背景やロゴのように毎フレーム同じ形で表示するスプライトの頂点を、デフォルトヒープのバッファに作成しておく.
+* Layer::Drawでは頂点を書き込まずに、保持しているバッファをそのまま描画する.
+* スプライトを変更したらMarkDirtyで知らせること. 知らせた範囲の頂点だけを、次のRenderer::Endで作り直して転送する.
+* 全体の移動はtranslationで指定する. translationは座標変換行列に加えるため、頂点を作り直す必要はない.
+*
+* セルが変わってもバッファ内の位置が変わらないように、1スプライトにSpriteMesh::maxVertexCount個の頂点を割り当てる.
+* 表示判定、visibleMask、不透明パスは使わない. 描画するPSOの頂点レイアウトはInitで指定した頂点データ形式と一致させること.
+* スプライトとセルの配列はStaticBatchより長く存在し、要素数を変えないこと. StaticBatchはRendererより先に破棄すること.
+* 頂点はスクリーン左上座標を原点として作り、描画時に座標変換行列でビューポートに合わせる. そのため、異なるビューポートに描画してもよい.
+* VertexFormat_Compactの場合、スプライトの座標はスクリーン左上から±2047ピクセルに収めること.
+* 転送用の領域を確保できなかったフレームでは、そのバッチは描画されない.
+*/
+class StaticBatch
+{
+public:
+	StaticBatch();
+	StaticBatch(const StaticBatch&) = delete;
+	StaticBatch& operator=(const StaticBatch&) = delete;
+	~StaticBatch();
+
+	bool Init(Renderer& renderer, const std::vector<Sprite>& spriteList, const Cell* cellList, VertexFormat format = VertexFormat_Float);
+	bool Init(Renderer& renderer, const Sprite* first, const Sprite* last, const Cell* cellList, VertexFormat format = VertexFormat_Float);
+	void MarkDirty(size_t first, size_t last);
+	void MarkDirty();
+	size_t GetSpriteCount() const { return static_cast<size_t>(last - first); }
+
+	DirectX::XMFLOAT2 translation; ///< スプライト全体の移動量. スプライトと同じスクリーン座標系で指定する.
+
+private:
+	friend class Renderer;
+	friend class Layer;
+
+	void Release();
+	bool IsUploadRequired() const;
+
+	Renderer* renderer;
+	const Sprite* first;
+	const Sprite* last;
+	const Cell* cellList;
+	VertexFormat format;
+	Microsoft::WRL::ComPtr<ID3D12Resource> buffer; ///< 頂点の後ろにインデックスを続けて配置したバッファ.
+	Resource::ResourceHeap::Allocation allocation;
+
+	// Renderer::Endで転送したときに更新する. 描画にはconstなオブジェクトを渡すため、mutableにする.
+	mutable std::vector<std::pair<size_t, size_t>> dirtyRangeList; ///< 頂点を作り直すスプライトの範囲(先頭, 終端).
+	mutable bool hasIndex; ///< インデックスを転送済みならtrue.
+	mutable bool isUploadFailed; ///< 現在のフレームで転送できなかったならtrue. Renderer::Endで更新する.
+};
+
+/**
+* 複数のCellListをまとめたオブジェクトを操作するためのインターフェイスクラス.
+*
+* LoadFromJsonFile()関数を使ってインターフェイスに対応したオブジェクトを取得し、Get()で
+* 個々のCellListアクセスする.
+*/
+class File
+{
+public:
+	File() = default;
+	File(const File&) = delete;
+	File& operator=(const File&) = delete;
+	virtual ~File() {}
+
+	virtual const CellList* Get(uint32_t no) const = 0;
+	virtual size_t Size() const = 0;
+};
+typedef std::shared_ptr<File> FilePtr;
+
+FilePtr LoadFromJsonFile(const wchar_t* filename, const wchar_t* imageFilename = nullptr);
+void BuildCellMesh(Cell& cell, const uint8_t* alpha, uint32_t width, uint32_t height);
+bool BuildCellMeshFromFile(Cell* first, Cell* last, const wchar_t* imageFilename);
+CellList LoadFontFromFile(const wchar_t*);
+bool CreateDistanceFieldFont(CellList& fontList, const wchar_t* imageFilename, DistanceField::Atlas& atlas);
+float GetTextWidth(const CellList& cellList, const char* text);
+
+} // namespace Sprite
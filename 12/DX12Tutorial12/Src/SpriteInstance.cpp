@@ -0,0 +1,91 @@
+/**
+* @file SpriteInstance.cpp
+*/
+#include "SpriteInstance.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SpriteInstance {
+
+/**
+* 色をRGBA8に変換する.
+*
+* @param rgba 0.0～1.0の範囲の色. 範囲外の値は範囲内に収められる.
+*
+* @return 下位バイトから順にR, G, B, Aを格納した値.
+*/
+uint32_t PackColor(const float* rgba)
+{
+	uint32_t color = 0;
+	for (int i = 0; i < 4; ++i) {
+		const float v = std::min(std::max(rgba[i], 0.0f), 1.0f);
+		color |= static_cast<uint32_t>(v * 255.0f + 0.5f) << (i * 8);
+	}
+	return color;
+}
+
+/**
+* RGBA8の色を0.0～1.0の範囲の色に変換する.
+*
+* @param color PackColorで変換した色.
+* @param rgba  変換した色を格納する配列.
+*/
+void UnpackColor(uint32_t color, float* rgba)
+{
+	for (int i = 0; i < 4; ++i) {
+		rgba[i] = static_cast<float>((color >> (i * 8)) & 0xff) / 255.0f;
+	}
+}
+
+/**
+* インスタンス1つあたりの頂点数を取得する.
+*
+* 形状は頂点0を中心とする扇形の三角形リストで描画する.
+* 頂点数が少ないセルは、余った三角形を面積0にして描画を省く.
+*
+* @param maxMeshVertexCount 描画するセルの形状の最大頂点数.
+*
+* @return DrawInstancedに指定する頂点数.
+*/
+uint32_t GetVertexCountPerInstance(uint32_t maxMeshVertexCount)
+{
+	return (std::max(maxMeshVertexCount, 3U) - 2) * 3;
+}
+
+/**
+* インスタンスから頂点を作成する.
+*
+* InstancedSpriteVertexShader.hlslと同じ計算を行う. テストおよびシェーダの確認用.
+*
+* @param instance  インスタンスデータ.
+* @param cellTable セルテーブル.
+* @param vertexId  インスタンス内の頂点番号(SV_VertexID).
+* @param corner    作成した頂点を格納するオブジェクト.
+*/
+void Expand(const Instance& instance, const CellData* cellTable, uint32_t vertexId, Corner& corner)
+{
+	const CellData& cell = cellTable[instance.cellAndPalette & 0xffff];
+	const uint32_t triangle = vertexId / 3;
+	const uint32_t n = triangle + 2 < cell.vertexCount && vertexId % 3 ? triangle + vertexId % 3 : 0;
+	const float* p = cell.mesh[n];
+
+	const float lx = (p[0] - 0.5f) * instance.size[0];
+	const float ly = (0.5f - p[1]) * instance.size[1];
+	const float s = std::sin(instance.rotation);
+	const float c = std::cos(instance.rotation);
+	corner.position[0] = instance.center[0] + (c * lx + s * ly);
+	corner.position[1] = instance.center[1] + (c * ly - s * lx);
+	corner.position[2] = instance.center[2];
+
+	float color0[4], color1[4];
+	UnpackColor(instance.color[0], color0);
+	UnpackColor(instance.color[1], color1);
+	for (int i = 0; i < 4; ++i) {
+		corner.color[i] = color0[i] + (color1[i] - color0[i]) * p[1];
+	}
+	corner.texcoord[0] = cell.uv[0] + cell.tsize[0] * p[0];
+	corner.texcoord[1] = cell.uv[1] + cell.tsize[1] * p[1];
+	corner.palette = static_cast<float>(instance.cellAndPalette >> 16);
+}
+
+} // namespace SpriteInstance
@@ -0,0 +1,64 @@
+/**
+* @file SpriteInstance.h
+*/
+#ifndef DX12TUTORIAL_SRC_SPRITEINSTANCE_H_
+#define DX12TUTORIAL_SRC_SPRITEINSTANCE_H_
+#include "SpriteMesh.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+* インスタンス描画用スプライトデータの名前空間.
+*
+* スプライト1つにつきInstanceを1つだけアップロードし、頂点シェーダでSV_VertexIDから頂点を作成する.
+* Expand関数は頂点シェーダ(InstancedSpriteVertexShader.hlsl)と同じ計算をCPUで行う.
+* Test/SpriteVertexTest.cppで、Expandの作る三角形がAddVertexBatchの頂点とインデックスに一致することを確かめている.
+*/
+namespace SpriteInstance {
+
+/**
+* スプライト1つ分の描画データ.
+*
+* HLSLのStructuredBufferから読み込むため、メンバの並びはシェーダの定義と一致させること.
+*/
+struct Instance
+{
+	float center[3]; ///< スクリーン座標上の中心位置とZ値.
+	float rotation; ///< 回転角(ラジアン).
+	float size[2]; ///< スクリーン座標上の縦横サイズ.
+	uint32_t cellAndPalette; ///< 下位16ビットがセルテーブルの番号、上位16ビットがパレット番号.
+	uint32_t color[2]; ///< 上端と下端の色. 乗算済みアルファのRGBA8.
+};
+
+/**
+* セルテーブルの要素.
+*
+* HLSLのStructuredBufferから読み込むため、メンバの並びはシェーダの定義と一致させること.
+*/
+struct CellData
+{
+	float uv[2]; ///< テクスチャ上の左上座標.
+	float tsize[2]; ///< テクスチャ上の縦横サイズ.
+	uint32_t vertexCount; ///< 形状の頂点数. 3以上SpriteMesh::maxVertexCount以下.
+	float mesh[SpriteMesh::maxVertexCount][2]; ///< 形状の頂点. セルの左上を(0, 0)、右下を(1, 1)とする.
+};
+
+/**
+* 頂点シェーダが作成する頂点.
+*/
+struct Corner
+{
+	float position[3];
+	float color[4];
+	float texcoord[2];
+	float palette;
+};
+
+uint32_t PackColor(const float* rgba);
+void UnpackColor(uint32_t color, float* rgba);
+uint32_t GetVertexCountPerInstance(uint32_t maxMeshVertexCount);
+void Expand(const Instance& instance, const CellData* cellTable, uint32_t vertexId, Corner& corner);
+
+} // namespace SpriteInstance
+
+#endif // DX12TUTORIAL_SRC_SPRITEINSTANCE_H_
@@ -0,0 +1,254 @@
+/**
+* @file SpriteMesh.cpp
+*/
+#include "SpriteMesh.h"
+#include <algorithm>
+#include <vector>
+
+namespace SpriteMesh {
+
+namespace /* unnamed */ {
+
+/// 2次元の点.
+struct Point
+{
+	float x;
+	float y;
+};
+
+/**
+* 外積を計算する.
+*/
+float Cross(const Point& a, const Point& b)
+{
+	return a.x * b.y - a.y * b.x;
+}
+
+/**
+* ベクトルb - aを計算する.
+*/
+Point Sub(const Point& a, const Point& b)
+{
+	return { b.x - a.x, b.y - a.y };
+}
+
+/**
+* 点の集合の凸包を計算する(Andrewのアルゴリズム).
+*
+* @param pointList 点の集合. 並べ替えられる.
+*
+* @return 凸包の頂点. 符号付き面積が正になる順(画面上で時計回り)に並ぶ.
+*/
+std::vector<Point> ConvexHull(std::vector<Point>& pointList)
+{
+	std::sort(pointList.begin(), pointList.end(), [](const Point& lhs, const Point& rhs) {
+		return lhs.x < rhs.x || (lhs.x == rhs.x && lhs.y < rhs.y);
+	});
+	pointList.erase(std::unique(pointList.begin(), pointList.end(), [](const Point& lhs, const Point& rhs) {
+		return lhs.x == rhs.x && lhs.y == rhs.y;
+	}), pointList.end());
+	if (pointList.size() < 3) {
+		return pointList;
+	}
+	std::vector<Point> hull(pointList.size() * 2);
+	size_t k = 0;
+	for (size_t i = 0; i < pointList.size(); ++i) {
+		while (k >= 2 && Cross(Sub(hull[k - 2], hull[k - 1]), Sub(hull[k - 2], pointList[i])) <= 0) {
+			--k;
+		}
+		hull[k++] = pointList[i];
+	}
+	for (size_t i = pointList.size() - 1, lower = k + 1; i > 0; --i) {
+		while (k >= lower && Cross(Sub(hull[k - 2], hull[k - 1]), Sub(hull[k - 2], pointList[i - 1])) <= 0) {
+			--k;
+		}
+		hull[k++] = pointList[i - 1];
+	}
+	hull.resize(k - 1);
+	return hull;
+}
+
+/**
+* 凸多角形の1辺を取り除いたときに追加される頂点を計算する.
+*
+* 辺iの前後の辺を延長し、その交点を新しい頂点とする.
+*
+* @param hull   凸多角形.
+* @param i      取り除く辺の始点.
+* @param point  新しい頂点を格納する変数.
+* @param area   増加する面積を格納する変数.
+*
+* @retval true  取り除ける.
+* @retval false 前後の辺が交わらないため取り除けない.
+*/
+bool RemoveEdge(const std::vector<Point>& hull, size_t i, Point& point, float& area)
+{
+	const size_t n = hull.size();
+	const Point& p0 = hull[(i + n - 1) % n];
+	const Point& p1 = hull[i];
+	const Point& p2 = hull[(i + 1) % n];
+	const Point& p3 = hull[(i + 2) % n];
+	const Point d1 = Sub(p0, p1);
+	const Point d2 = Sub(p2, p3);
+	const float denom = Cross(d1, d2);
+	if (denom <= 1e-6f) {
+		return false;
+	}
+	const float t = Cross(Sub(p1, p2), d2) / denom;
+	point = { p1.x + d1.x * t, p1.y + d1.y * t };
+	area = Cross(Sub(p1, point), Sub(p1, p2)) * 0.5f;
+	return area >= 0;
+}
+
+} // unnamed namespace
+
+/**
+* セルの不透明部分を囲む凸多角形を作成する.
+*
+* 不透明なピクセルを含む各行の左右端から凸包を求め、辺を延長して頂点数をmaxVertexCount以下に減らす.
+* テクスチャの補間で不透明部分がにじむ範囲を含めるため、ピクセルの外側に0.5ピクセルの余白を設ける.
+* 多角形はセルの範囲からはみ出さない. 頂点数を減らせない場合や、面積があまり減らない場合は
+* 不透明部分を囲む矩形を返す.
+*
+* @param alpha    画像のアルファ値の配列. 1ピクセル1バイト.
+* @param rowPitch alphaの1行のバイト数.
+* @param left     セルの左端のピクセル座標.
+* @param top      セルの上端のピクセル座標.
+* @param width    セルの幅.
+* @param height   セルの高さ.
+* @param polygon  作成した多角形を格納するオブジェクト.
+*
+* @retval true  作成成功.
+* @retval false セルに不透明なピクセルがない.
+*/
+bool Build(const uint8_t* alpha, size_t rowPitch, uint32_t left, uint32_t top, uint32_t width, uint32_t height, Polygon& polygon)
+{
+	static const float padding = 0.5f;
+	const float w = static_cast<float>(width);
+	const float h = static_cast<float>(height);
+
+	std::vector<Point> pointList;
+	pointList.reserve(height * 4);
+	Point minPoint = { w, h };
+	Point maxPoint = { 0, 0 };
+	for (uint32_t y = 0; y < height; ++y) {
+		const uint8_t* row = alpha + rowPitch * (top + y) + left;
+		uint32_t x0 = 0;
+		while (x0 < width && row[x0] == 0) {
+			++x0;
+		}
+		if (x0 >= width) {
+			continue;
+		}
+		uint32_t x1 = width - 1;
+		while (row[x1] == 0) {
+			--x1;
+		}
+		const float l = std::max(static_cast<float>(x0) - padding, 0.0f);
+		const float r = std::min(static_cast<float>(x1 + 1) + padding, w);
+		const float t = std::max(static_cast<float>(y) - padding, 0.0f);
+		const float b = std::min(static_cast<float>(y + 1) + padding, h);
+		pointList.push_back({ l, t });
+		pointList.push_back({ r, t });
+		pointList.push_back({ l, b });
+		pointList.push_back({ r, b });
+		minPoint = { std::min(minPoint.x, l), std::min(minPoint.y, t) };
+		maxPoint = { std::max(maxPoint.x, r), std::max(maxPoint.y, b) };
+	}
+	if (pointList.empty()) {
+		return false;
+	}
+
+	// 不透明部分を囲む矩形. 凸多角形が作れない場合はこれを使う.
+	const Point rect[] = { minPoint, { maxPoint.x, minPoint.y }, maxPoint, { minPoint.x, maxPoint.y } };
+	std::vector<Point> hull = ConvexHull(pointList);
+	while (hull.size() > maxVertexCount) {
+		size_t bestIndex = hull.size();
+		Point bestPoint = {};
+		float bestArea = 0;
+		for (size_t i = 0; i < hull.size(); ++i) {
+			Point point;
+			float area;
+			if (!RemoveEdge(hull, i, point, area)) {
+				continue;
+			}
+			if (point.x < 0 || point.x > w || point.y < 0 || point.y > h) {
+				continue;
+			}
+			if (bestIndex == hull.size() || area < bestArea) {
+				bestIndex = i;
+				bestPoint = point;
+				bestArea = area;
+			}
+		}
+		if (bestIndex == hull.size()) {
+			hull.assign(rect, rect + 4);
+			break;
+		}
+		hull[bestIndex] = bestPoint;
+		hull.erase(hull.begin() + (bestIndex + 1) % hull.size());
+	}
+
+	// 矩形より頂点が多い割に面積が減らない場合は、矩形のほうが安く描画できる.
+	polygon.count = static_cast<uint32_t>(hull.size());
+	for (uint32_t i = 0; i < polygon.count; ++i) {
+		polygon.vertexList[i][0] = hull[i].x / w;
+		polygon.vertexList[i][1] = hull[i].y / h;
+	}
+	const float rectArea = (maxPoint.x - minPoint.x) * (maxPoint.y - minPoint.y) / (w * h);
+	if (polygon.count > 4 && GetArea(polygon) > rectArea * 0.9f) {
+		polygon.count = 4;
+		for (uint32_t i = 0; i < 4; ++i) {
+			polygon.vertexList[i][0] = rect[i].x / w;
+			polygon.vertexList[i][1] = rect[i].y / h;
+		}
+	}
+	return true;
+}
+
+/**
+* 範囲内の全てのピクセルが完全に不透明か調べる.
+*
+* @param alpha    画像のアルファ値の配列. 1ピクセル1バイト.
+* @param rowPitch alphaの1行のバイト数.
+* @param left     範囲の左端のピクセル座標.
+* @param top      範囲の上端のピクセル座標.
+* @param width    範囲の幅.
+* @param height   範囲の高さ.
+*
+* @retval true  全てのピクセルのアルファ値が255.
+* @retval false 不透明でないピクセルがある. または範囲が空.
+*/
+bool IsOpaque(const uint8_t* alpha, size_t rowPitch, uint32_t left, uint32_t top, uint32_t width, uint32_t height)
+{
+	if (width == 0 || height == 0) {
+		return false;
+	}
+	for (uint32_t y = top; y < top + height; ++y) {
+		const uint8_t* row = alpha + y * rowPitch + left;
+		if (std::find_if(row, row + width, [](uint8_t a) { return a != 255; }) != row + width) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+* 多角形の面積を計算する.
+*
+* @param polygon 多角形.
+*
+* @return 面積. セル全体を1とする.
+*/
+float GetArea(const Polygon& polygon)
+{
+	float area = 0;
+	for (uint32_t i = 0; i < polygon.count; ++i) {
+		const float* p0 = polygon.vertexList[i];
+		const float* p1 = polygon.vertexList[(i + 1) % polygon.count];
+		area += p0[0] * p1[1] - p1[0] * p0[1];
+	}
+	return area * 0.5f;
+}
+
+} // namespace SpriteMesh
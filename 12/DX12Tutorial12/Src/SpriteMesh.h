@@ -0,0 +1,38 @@
+/**
+* @file SpriteMesh.h
+*/
+#ifndef DX12TUTORIAL_SRC_SPRITEMESH_H_
+#define DX12TUTORIAL_SRC_SPRITEMESH_H_
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+* スプライトの形状用名前空間.
+*
+* セルの不透明部分を囲む凸多角形を作成する.
+* 矩形の代わりにこの多角形を描画することで、完全に透明なピクセルの描画を減らす.
+* 多角形が凸で、不透明なピクセルを1つも削らないことはTest/SpriteMeshTest.cppで確かめている.
+*/
+namespace SpriteMesh {
+
+static const uint32_t maxVertexCount = 8; ///< 多角形の最大頂点数.
+
+/**
+* セルの形状を表す凸多角形.
+*
+* 頂点座標はセルの左上を(0, 0)、右下を(1, 1)とする座標系で表す.
+* 頂点は画面上で時計回りに並ぶ. 頂点0を中心とする扇形に分割すると三角形リストになる.
+*/
+struct Polygon
+{
+	uint32_t count; ///< 頂点数. 3以上maxVertexCount以下.
+	float vertexList[maxVertexCount][2];
+};
+
+bool Build(const uint8_t* alpha, size_t rowPitch, uint32_t left, uint32_t top, uint32_t width, uint32_t height, Polygon& polygon);
+bool IsOpaque(const uint8_t* alpha, size_t rowPitch, uint32_t left, uint32_t top, uint32_t width, uint32_t height);
+float GetArea(const Polygon& polygon);
+
+} // namespace SpriteMesh
+
+#endif // DX12TUTORIAL_SRC_SPRITEMESH_H_
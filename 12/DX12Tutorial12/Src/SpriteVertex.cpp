@@ -0,0 +1,338 @@
+/**
+* @file SpriteVertex.cpp
+*/
+#include "SpriteVertex.h"
+
+using namespace DirectX;
+
+namespace Sprite {
+
+namespace /* unnamed */ {
+
+/// 形状を持たないセルで使う矩形.
+const XMFLOAT2 quadMesh[] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+
+} // unnamed namespace
+
+/**
+* 頂点カラーを乗算済みアルファに変換する.
+*
+* 加算合成ではアルファを0にする. 合成式は「src + dest * (1 - srcAlpha)」なので、アルファが0なら加算になる.
+*
+* @param color     変換する色.
+* @param blendMode 合成方法.
+*
+* @return 乗算済みアルファの色.
+*/
+XMVECTOR Premultiply(FXMVECTOR color, BlendMode blendMode)
+{
+	const XMVECTOR alpha = XMVectorSplatW(color);
+	const XMVECTOR premultiplied = XMVectorSelect(alpha, XMVectorMultiply(color, alpha), g_XMSelect1110);
+	return blendMode == BlendMode_Add ? XMVectorSetW(premultiplied, 0.0f) : premultiplied;
+}
+
+/**
+* セルの形状の頂点配列を取得する.
+*
+* @return 形状を持たないセルならquadMesh.
+*/
+const XMFLOAT2* GetMesh(const Cell& cell)
+{
+	return cell.meshVertexCount ? cell.mesh : quadMesh;
+}
+
+/**
+* セルの形状の頂点数を取得する.
+*/
+uint32_t GetMeshVertexCount(const Cell& cell)
+{
+	return cell.meshVertexCount ? cell.meshVertexCount : static_cast<uint32_t>(_countof(quadMesh));
+}
+
+/**
+* 頂点データを頂点バッファに書き込む.
+*
+* @param src   書き込む頂点データ.
+* @param count 頂点数.
+* @param dst   書き込み先.
+*/
+void StoreVertex(const Vertex* src, uint32_t count, Vertex* dst)
+{
+	std::copy(src, src + count, dst);
+}
+
+/**
+* 頂点データをVertexFormat_Compact形式に変換して頂点バッファに書き込む.
+*
+* 各要素を整数単位に拡大して丸めてから格納する. 丸めた値は整数なので、格納時の変換で誤差は生じない.
+* 元の値との差は、位置が1/32ピクセル、色が1/510、テクスチャ座標が約1/131070以下になる.
+* 範囲外の値は表せる範囲に収められる.
+*
+* @param src   書き込む頂点データ.
+* @param count 頂点数.
+* @param dst   書き込み先.
+*/
+void StoreVertex(const Vertex* src, uint32_t count, CompactVertex* dst)
+{
+	const XMVECTORF32 positionScale = { compactPositionScale, compactPositionScale, compactDepthScale, 1.0f };
+	const XMVECTOR colorScale = XMVectorReplicate(255.0f);
+	const XMVECTOR texcoordScale = XMVectorReplicate(65535.0f);
+	for (uint32_t i = 0; i < count; ++i) {
+		const XMVECTOR position = XMVectorSetW(XMLoadFloat3(&src[i].position), src[i].palette);
+		CompactVertex v;
+		PackedVector::XMStoreShort4(&v.position, XMVectorRound(XMVectorMultiply(position, positionScale)));
+		PackedVector::XMStoreUByte4(&v.color, XMVectorRound(XMVectorMultiply(XMVectorSaturate(XMLoadFloat4(&src[i].color)), colorScale)));
+		PackedVector::XMStoreUShort2(&v.texcoord, XMVectorRound(XMVectorMultiply(XMVectorSaturate(XMLoadFloat2(&src[i].texcoord)), texcoordScale)));
+		dst[i] = v;
+	}
+}
+
+/**
+* 最大batchSize個のスプライトの頂点データを計算する.
+*
+* スプライトの位置、大きさ、回転、色、テクスチャ座標をSoA形式(要素毎に4スプライト分を1つのXMVECTORにまとめた形式)に集め、
+* セルの形状の頂点を4スプライト分同時に計算する. 回転の三角関数も4スプライト分を1回で計算し、
+* 全てのスプライトが回転していない場合は回転の計算を省く.
+* 頂点カラーはcolor[0]を上端、color[1]を下端として補間する.
+*
+* @param spriteList      スプライトデータの配列.
+* @param cellList        各スプライトのセルデータの配列.
+* @param count           スプライトの数. 1以上batchSize以下.
+* @param offset          スクリーン左上座標.
+* @param vertexList      スプライト毎の頂点データの格納先. 頂点数が最大のスプライトより少ないスプライトは、
+*                        最後の頂点を最大の頂点数まで繰り返して格納する.
+* @param vertexCountList スプライト毎の頂点数の格納先.
+*/
+void ComputeVertexBatch(const Sprite* const* spriteList, const Cell* const* cellList, size_t count, XMFLOAT2 offset, Vertex (*vertexList)[SpriteMesh::maxVertexCount], uint32_t* vertexCountList)
+{
+	// スプライト毎のデータを集める. 使わない要素は0のままにする.
+	enum {
+		Lane_CenterX, Lane_CenterY, Lane_CenterZ,
+		Lane_Width, Lane_Height,
+		Lane_Rotation,
+		Lane_U, Lane_V, Lane_TexWidth, Lane_TexHeight,
+		Lane_Palette,
+		countof_Lane
+	};
+	alignas(16) float lane[countof_Lane][batchSize] = {};
+	XMMATRIX color0 = XMMatrixIdentity();
+	XMMATRIX color1 = XMMatrixIdentity();
+	const XMFLOAT2* meshList[batchSize] = {};
+	uint32_t maxCount = 0;
+	for (size_t i = 0; i < count; ++i) {
+		const Sprite& sprite = *spriteList[i];
+		const Cell& cell = *cellList[i];
+		const AnimationData& anm = sprite.animeController.GetData();
+		lane[Lane_CenterX][i] = offset.x + sprite.pos.x + cell.offset.x * sprite.scale.x;
+		lane[Lane_CenterY][i] = offset.y - sprite.pos.y - cell.offset.y * sprite.scale.y;
+		lane[Lane_CenterZ][i] = sprite.pos.z;
+		lane[Lane_Width][i] = cell.ssize.x * sprite.scale.x * anm.scale.x;
+		lane[Lane_Height][i] = cell.ssize.y * sprite.scale.y * anm.scale.y;
+		lane[Lane_Rotation][i] = sprite.rotation + anm.rotation;
+		lane[Lane_U][i] = cell.uv.x;
+		lane[Lane_V][i] = cell.uv.y;
+		lane[Lane_TexWidth][i] = cell.tsize.x;
+		lane[Lane_TexHeight][i] = cell.tsize.y;
+		lane[Lane_Palette][i] = static_cast<float>(sprite.palette);
+		const XMVECTOR anmColor = XMLoadFloat4(&anm.color);
+		color0.r[i] = Premultiply(XMVectorMultiply(XMLoadFloat4(&sprite.color[0]), anmColor), sprite.blendMode);
+		color1.r[i] = Premultiply(XMVectorMultiply(XMLoadFloat4(&sprite.color[1]), anmColor), sprite.blendMode);
+		meshList[i] = GetMesh(cell);
+		vertexCountList[i] = GetMeshVertexCount(cell);
+		maxCount = std::max(maxCount, vertexCountList[i]);
+	}
+	const XMVECTOR cx = LoadLane(lane[Lane_CenterX]);
+	const XMVECTOR cy = LoadLane(lane[Lane_CenterY]);
+	const XMVECTOR cz = LoadLane(lane[Lane_CenterZ]);
+	const XMVECTOR sx = LoadLane(lane[Lane_Width]);
+	const XMVECTOR sy = LoadLane(lane[Lane_Height]);
+	const XMVECTOR u0 = LoadLane(lane[Lane_U]);
+	const XMVECTOR v0 = LoadLane(lane[Lane_V]);
+	const XMVECTOR tu = LoadLane(lane[Lane_TexWidth]);
+	const XMVECTOR tv = LoadLane(lane[Lane_TexHeight]);
+	const XMVECTOR pal = LoadLane(lane[Lane_Palette]);
+	const XMVECTOR rot = LoadLane(lane[Lane_Rotation]);
+	const bool rotated = !XMVector4Equal(rot, XMVectorZero());
+	XMVECTOR sinRot = XMVectorZero();
+	XMVECTOR cosRot = XMVectorSplatOne();
+	if (rotated) {
+		XMVectorSinCos(&sinRot, &cosRot, rot);
+	}
+	// 色をチャネル毎にまとめる. 補間はc0 + (c1 - c0) * tで計算する.
+	const XMMATRIX c0 = XMMatrixTranspose(color0);
+	const XMMATRIX dc = XMMatrixTranspose(color1) - c0;
+	const XMVECTOR half = XMVectorReplicate(0.5f);
+
+	for (uint32_t n = 0; n < maxCount; ++n) {
+		// 頂点数が少ないスプライトは最後の頂点を繰り返す.
+		alignas(16) float px[batchSize];
+		alignas(16) float py[batchSize];
+		for (size_t i = 0; i < batchSize; ++i) {
+			const XMFLOAT2& p = i < count ? meshList[i][std::min(n, vertexCountList[i] - 1)] : quadMesh[0];
+			px[i] = p.x;
+			py[i] = p.y;
+		}
+		const XMVECTOR mx = LoadLane(px);
+		const XMVECTOR my = LoadLane(py);
+		const XMVECTOR lx = XMVectorMultiply(XMVectorSubtract(mx, half), sx);
+		const XMVECTOR ly = XMVectorMultiply(XMVectorSubtract(half, my), sy);
+		XMVECTOR x, y;
+		if (rotated) {
+			x = XMVectorAdd(cx, XMVectorMultiplyAdd(cosRot, lx, XMVectorMultiply(sinRot, ly)));
+			y = XMVectorAdd(cy, XMVectorNegativeMultiplySubtract(sinRot, lx, XMVectorMultiply(cosRot, ly)));
+		} else {
+			x = XMVectorAdd(cx, lx);
+			y = XMVectorAdd(cy, ly);
+		}
+		// Vertexのメンバの並び順(x, y, z, r), (g, b, a, u), (v, palette)に合わせて、スプライト毎に並べ替える.
+		const XMMATRIX m0 = XMMatrixTranspose(XMMATRIX(x, y, cz, XMVectorMultiplyAdd(dc.r[0], my, c0.r[0])));
+		const XMMATRIX m1 = XMMatrixTranspose(XMMATRIX(XMVectorMultiplyAdd(dc.r[1], my, c0.r[1]), XMVectorMultiplyAdd(dc.r[2], my, c0.r[2]), XMVectorMultiplyAdd(dc.r[3], my, c0.r[3]), XMVectorMultiplyAdd(tu, mx, u0)));
+		const XMMATRIX m2 = XMMatrixTranspose(XMMATRIX(XMVectorMultiplyAdd(tv, my, v0), pal, XMVectorZero(), XMVectorZero()));
+		for (size_t i = 0; i < count; ++i) {
+			float* p = &vertexList[i][n].position.x;
+			XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(p), m0.r[i]);
+			XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(p + 4), m1.r[i]);
+			XMStoreFloat2(reinterpret_cast<XMFLOAT2*>(p + 8), m2.r[i]);
+		}
+	}
+}
+
+/**
+* 最大batchSize個のスプライトデータを頂点バッファとインデックスバッファに設定.
+*
+* ComputeVertexBatchで計算した頂点のうち、繰り返した頂点を除いて書き込む.
+* セルの形状(形状がなければ矩形)は、頂点0を中心とする扇形の三角形に分割して設定する.
+*
+* 計算結果は一旦スタックに置き、全スプライト分を連続した形でWriteCombinerへ渡す.
+* アップロードヒープは書き込み結合メモリのため、飛び飛びのアドレスやキャッシュラインの一部だけに書き込むと遅くなる.
+*
+* @tparam T 頂点データ型. VertexまたはCompactVertex.
+*
+* @param spriteList スプライトデータの配列.
+* @param cellList   各スプライトのセルデータの配列.
+* @param count      スプライトの数. 1以上batchSize以下.
+* @param vertexOut  頂点データの書き込み先.
+* @param indexOut   インデックスデータの書き込み先.
+* @param baseVertex 最初の頂点の頂点バッファ内での番号.
+* @param offset     スクリーン左上座標.
+*/
+template<typename T>
+void AddVertexBatch(const Sprite* const* spriteList, const Cell* const* cellList, size_t count, WriteCombiner& vertexOut, WriteCombiner& indexOut, uint32_t baseVertex, XMFLOAT2 offset)
+{
+	Vertex tmp[batchSize][SpriteMesh::maxVertexCount];
+	uint32_t vertexCountList[batchSize];
+	ComputeVertexBatch(spriteList, cellList, count, offset, tmp, vertexCountList);
+
+	uint32_t totalVertexCount = 0;
+	for (size_t i = 0; i < count; ++i) {
+		totalVertexCount += vertexCountList[i];
+	}
+	const size_t vertexBytes = totalVertexCount * sizeof(T);
+	const size_t indexBytes = (totalVertexCount - count * 2) * 3 * sizeof(DWORD);
+	T* v = static_cast<T*>(vertexOut.Reserve(vertexBytes));
+	DWORD* index = static_cast<DWORD*>(indexOut.Reserve(indexBytes));
+	for (size_t i = 0; i < count; ++i) {
+		const uint32_t vertexCount = vertexCountList[i];
+		StoreVertex(tmp[i], vertexCount, v);
+		v += vertexCount;
+		for (uint32_t n = 1; n < vertexCount - 1; ++n) {
+			index[0] = baseVertex;
+			index[1] = baseVertex + n;
+			index[2] = baseVertex + n + 1;
+			index += 3;
+		}
+		baseVertex += vertexCount;
+	}
+	vertexOut.Commit(vertexBytes);
+	indexOut.Commit(indexBytes);
+}
+
+/**
+* 最大batchSize個のスプライトの頂点データを静的バッチの形式で設定.
+*
+* 全てのスプライトにSpriteMesh::maxVertexCount個の頂点を割り当て、形状の頂点数を超える部分は最後の頂点で埋める.
+* 埋めた頂点を使う三角形は面積が0になるため、描画されない.
+*
+* @tparam T 頂点データ型. VertexまたはCompactVertex.
+*
+* @param spriteList スプライトデータの配列.
+* @param cellList   各スプライトのセルデータの配列.
+* @param count      スプライトの数. 1以上batchSize以下.
+* @param vertexOut  頂点データの書き込み先.
+* @param offset     スクリーン左上座標.
+*/
+template<typename T>
+void AddStaticVertexBatch(const Sprite* const* spriteList, const Cell* const* cellList, size_t count, WriteCombiner& vertexOut, XMFLOAT2 offset)
+{
+	Vertex tmp[batchSize][SpriteMesh::maxVertexCount];
+	uint32_t vertexCountList[batchSize];
+	ComputeVertexBatch(spriteList, cellList, count, offset, tmp, vertexCountList);
+
+	const size_t vertexBytes = count * SpriteMesh::maxVertexCount * sizeof(T);
+	T* v = static_cast<T*>(vertexOut.Reserve(vertexBytes));
+	for (size_t i = 0; i < count; ++i) {
+		std::fill(tmp[i] + vertexCountList[i], tmp[i] + SpriteMesh::maxVertexCount, tmp[i][vertexCountList[i] - 1]);
+		StoreVertex(tmp[i], SpriteMesh::maxVertexCount, v);
+		v += SpriteMesh::maxVertexCount;
+	}
+	vertexOut.Commit(vertexBytes);
+}
+
+/**
+* インスタンス描画用のスプライトデータを作成する.
+*
+* 位置、大きさ、回転、色はComputeVertexBatchと同じ式で求める. 色は乗算済みアルファにしてからRGBA8に詰める.
+*
+* @param sprite   スプライトデータ.
+* @param cell     スプライトのセルデータ.
+* @param cellSlot セルテーブル内でのセルの番号.
+* @param offset   スクリーン左上座標.
+* @param instance 作成したデータの格納先.
+*/
+void MakeInstance(const Sprite& sprite, const Cell& cell, uint32_t cellSlot, XMFLOAT2 offset, SpriteInstance::Instance& instance)
+{
+	const AnimationData& anm = sprite.animeController.GetData();
+	instance.center[0] = offset.x + sprite.pos.x + cell.offset.x * sprite.scale.x;
+	instance.center[1] = offset.y - sprite.pos.y - cell.offset.y * sprite.scale.y;
+	instance.center[2] = sprite.pos.z;
+	instance.rotation = sprite.rotation + anm.rotation;
+	instance.size[0] = cell.ssize.x * sprite.scale.x * anm.scale.x;
+	instance.size[1] = cell.ssize.y * sprite.scale.y * anm.scale.y;
+	instance.cellAndPalette = cellSlot | (sprite.palette << 16);
+	const XMVECTOR anmColor = XMLoadFloat4(&anm.color);
+	for (int i = 0; i < 2; ++i) {
+		XMFLOAT4 color;
+		XMStoreFloat4(&color, Premultiply(XMVectorMultiply(XMLoadFloat4(&sprite.color[i]), anmColor), sprite.blendMode));
+		instance.color[i] = SpriteInstance::PackColor(&color.x);
+	}
+}
+
+/**
+* セルテーブルの要素を作成する.
+*
+* 形状を持たないセルには矩形を設定する. 使わない頂点は0で埋める.
+*
+* @param cell セルデータ.
+* @param data 作成したデータの格納先.
+*/
+void MakeCellData(const Cell& cell, SpriteInstance::CellData& data)
+{
+	const XMFLOAT2* mesh = GetMesh(cell);
+	data = {};
+	data.uv[0] = cell.uv.x;
+	data.uv[1] = cell.uv.y;
+	data.tsize[0] = cell.tsize.x;
+	data.tsize[1] = cell.tsize.y;
+	data.vertexCount = GetMeshVertexCount(cell);
+	for (uint32_t n = 0; n < data.vertexCount; ++n) {
+		data.mesh[n][0] = mesh[n].x;
+		data.mesh[n][1] = mesh[n].y;
+	}
+}
+
+template void AddVertexBatch<Vertex>(const Sprite* const*, const Cell* const*, size_t, WriteCombiner&, WriteCombiner&, uint32_t, XMFLOAT2);
+template void AddVertexBatch<CompactVertex>(const Sprite* const*, const Cell* const*, size_t, WriteCombiner&, WriteCombiner&, uint32_t, XMFLOAT2);
+template void AddStaticVertexBatch<Vertex>(const Sprite* const*, const Cell* const*, size_t, WriteCombiner&, XMFLOAT2);
+template void AddStaticVertexBatch<CompactVertex>(const Sprite* const*, const Cell* const*, size_t, WriteCombiner&, XMFLOAT2);
+
+} // namespace Sprite
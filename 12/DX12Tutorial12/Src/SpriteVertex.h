@@ -0,0 +1,213 @@
+/**
+* @file SpriteVertex.h
+*/
+#ifndef DX12TUTORIAL_SRC_SPRITEVERTEX_H_
+#define DX12TUTORIAL_SRC_SPRITEVERTEX_H_
+#include "Sprite.h"
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+#include <algorithm>
+#include <string.h>
+#include <stdint.h>
+
+namespace Sprite {
+
+/**
+* スプライト描画用頂点データ型.
+*/
+struct Vertex {
+	DirectX::XMFLOAT3 position;
+	DirectX::XMFLOAT4 color;
+	DirectX::XMFLOAT2 texcoord;
+	float palette; ///< パレット番号. パレット画像テクスチャのパレットテクスチャの行を示す.
+};
+
+/**
+* VertexFormat_Compact形式の頂点データ型.
+*
+* 位置は整数で表し、CompactSpriteVertexShader.hlslで元の値に戻す.
+* 色とテクスチャ座標は、PSOの頂点レイアウトでUNORMとして読み込まれる.
+*/
+struct CompactVertex {
+	DirectX::PackedVector::XMSHORT4 position; ///< X, YはcompactPositionScale倍、ZはcompactDepthScale倍した値. Wはパレット番号.
+	DirectX::PackedVector::XMUBYTE4 color; ///< 255倍した色.
+	DirectX::PackedVector::XMUSHORT2 texcoord; ///< 65535倍したテクスチャ座標.
+};
+
+const float compactPositionScale = 16.0f; ///< CompactVertexのX, Yの単位(1/16ピクセル). 表せる範囲は±2047ピクセル.
+const float compactDepthScale = 32767.0f; ///< CompactVertexのZの単位.
+
+/// AddVertexBatchで一度に処理するスプライト数. XMVECTORの要素数と同じ.
+const size_t batchSize = 4;
+
+/// 静的バッチで1スプライトに割り当てるインデックス数. 頂点0を中心とする扇形に分割する.
+const uint32_t staticIndexCountPerSprite = (SpriteMesh::maxVertexCount - 2) * 3;
+
+static_assert(sizeof(Vertex) == sizeof(float) * 10, "AddVertexBatch assumes Vertex is 10 packed floats.");
+static_assert(sizeof(CompactVertex) == 16, "CompactVertex must match compactSpriteVertexLayout in PSO.cpp.");
+
+/**
+* 書き込み結合メモリへ連続したデータを書き込むクラス.
+*
+* アップロードヒープは書き込み結合メモリのため、キャッシュラインの一部だけを書き込むと遅くなる.
+* そこで、書き込むデータをキャッシュ上の作業領域に貯めておき、キャッシュラインが埋まった分だけを
+* 先頭から順に非テンポラルストアで書き出す. 書き込み先の最初と最後の端数のラインだけは通常のストアで書き込む.
+* 非テンポラルストアは他のストアとの順序が保証されないため、書き込みを終えたスレッドでFlushを呼ぶこと.
+*
+* 通常のストアでも連続して書き込めば十分速い環境では、作業領域を経由するコピーの分だけ遅くなる.
+* isStagedをfalseにすると作業領域を使わず、Reserveは書き込み先のアドレスをそのまま返す.
+* Rendererでの使い方はRenderer::SetUploadStagedで指定する. どちらが速いかは、テストプロジェクトの
+* BenchSpriteVertexがアップロードヒープに書き込んで計測する.
+*/
+class WriteCombiner
+{
+public:
+	static const size_t lineSize = 64; ///< 書き込み単位となるキャッシュラインのバイト数.
+	static const size_t bufferSize = 4096; ///< 作業領域のバイト数.
+	static const size_t maxReserveSize = bufferSize - lineSize; ///< 一度にReserveできる最大バイト数.
+
+	/**
+	* コンストラクタ.
+	*
+	* @param p      書き込み先の先頭アドレス.
+	* @param staged trueなら作業領域に貯めてから書き出す. falseなら書き込み先へ直接書き込む.
+	*/
+	explicit WriteCombiner(void* p, bool staged = true) :
+		dst(static_cast<uint8_t*>(p) - (reinterpret_cast<uintptr_t>(p) & (lineSize - 1))),
+		head(reinterpret_cast<uintptr_t>(p) & (lineSize - 1)),
+		size(head),
+		isStaged(staged)
+	{
+	}
+	WriteCombiner(const WriteCombiner&) = delete;
+	WriteCombiner& operator=(const WriteCombiner&) = delete;
+
+	/**
+	* 書き込むデータを置く領域を取得する.
+	*
+	* @param n 書き込むバイト数. maxReserveSize以下であること.
+	*
+	* @return データを置くアドレス. 置いたらCommitを呼ぶこと.
+	*/
+	void* Reserve(size_t n)
+	{
+		if (!isStaged) {
+			return dst + size;
+		}
+		if (size + n > bufferSize) {
+			Drain();
+		}
+		return buffer + size;
+	}
+
+	/**
+	* Reserveで取得した領域に置いたデータを確定する.
+	*
+	* @param n 置いたバイト数.
+	*/
+	void Commit(size_t n) { size += n; }
+
+	/**
+	* データを書き込む.
+	*
+	* @param src 書き込むデータ.
+	* @param n   書き込むバイト数.
+	*/
+	void Write(const void* src, size_t n)
+	{
+		const uint8_t* p = static_cast<const uint8_t*>(src);
+		while (n > 0) {
+			const size_t chunk = std::min(n, maxReserveSize);
+			memcpy(Reserve(chunk), p, chunk);
+			Commit(chunk);
+			p += chunk;
+			n -= chunk;
+		}
+	}
+
+	/**
+	* 作業領域に残っているデータを書き込み、全ての書き込みを完了させる.
+	*/
+	void Flush()
+	{
+		if (isStaged) {
+			Drain();
+			if (size > head) {
+				memcpy(dst + head, buffer + head, size - head);
+			}
+#ifdef _XM_SSE_INTRINSICS_
+			_mm_sfence();
+#endif
+		}
+		dst += size;
+		head = size = 0;
+	}
+
+private:
+	/**
+	* 作業領域のうち、埋まったキャッシュラインを書き出す.
+	*/
+	void Drain()
+	{
+		const size_t lineCount = size / lineSize;
+		if (lineCount == 0) {
+			return;
+		}
+		size_t i = 0;
+		if (head) {
+			memcpy(dst + head, buffer + head, lineSize - head);
+			head = 0;
+			i = 1;
+		}
+		for (; i < lineCount; ++i) {
+			uint8_t* d = dst + i * lineSize;
+			const uint8_t* s = buffer + i * lineSize;
+#ifdef _XM_SSE_INTRINSICS_
+			for (size_t k = 0; k < lineSize; k += 16) {
+				_mm_stream_si128(reinterpret_cast<__m128i*>(d + k), _mm_load_si128(reinterpret_cast<const __m128i*>(s + k)));
+			}
+#else
+			memcpy(d, s, lineSize);
+#endif
+		}
+		const size_t written = lineCount * lineSize;
+		memcpy(buffer, buffer + written, size - written);
+		dst += written;
+		size -= written;
+	}
+
+	alignas(lineSize) uint8_t buffer[bufferSize];
+	uint8_t* dst; ///< buffer[0]に対応する書き込み先. キャッシュライン境界にある.
+	size_t head; ///< buffer[0]からの、書き込んではならない範囲のバイト数.
+	size_t size; ///< 作業領域に置いたバイト数. headを含む.
+	bool isStaged; ///< 作業領域を使うならtrue.
+};
+
+static_assert(batchSize * SpriteMesh::maxVertexCount * sizeof(Vertex) <= WriteCombiner::maxReserveSize, "AddVertexBatch must be able to reserve a whole batch.");
+
+/**
+* batchSize個のfloatをXMVECTORに読み込む.
+*
+* @param p 16バイト境界に配置された配列.
+*/
+inline DirectX::XMVECTOR LoadLane(const float* p)
+{
+	return DirectX::XMLoadFloat4A(reinterpret_cast<const DirectX::XMFLOAT4A*>(p));
+}
+
+DirectX::XMVECTOR Premultiply(DirectX::FXMVECTOR color, BlendMode blendMode);
+const DirectX::XMFLOAT2* GetMesh(const Cell& cell);
+uint32_t GetMeshVertexCount(const Cell& cell);
+void StoreVertex(const Vertex* src, uint32_t count, Vertex* dst);
+void StoreVertex(const Vertex* src, uint32_t count, CompactVertex* dst);
+void ComputeVertexBatch(const Sprite* const* spriteList, const Cell* const* cellList, size_t count, DirectX::XMFLOAT2 offset, Vertex (*vertexList)[SpriteMesh::maxVertexCount], uint32_t* vertexCountList);
+template<typename T>
+void AddVertexBatch(const Sprite* const* spriteList, const Cell* const* cellList, size_t count, WriteCombiner& vertexOut, WriteCombiner& indexOut, uint32_t baseVertex, DirectX::XMFLOAT2 offset);
+template<typename T>
+void AddStaticVertexBatch(const Sprite* const* spriteList, const Cell* const* cellList, size_t count, WriteCombiner& vertexOut, DirectX::XMFLOAT2 offset);
+void MakeInstance(const Sprite& sprite, const Cell& cell, uint32_t cellSlot, DirectX::XMFLOAT2 offset, SpriteInstance::Instance& instance);
+void MakeCellData(const Cell& cell, SpriteInstance::CellData& data);
+
+} // namespace Sprite
+
+#endif // DX12TUTORIAL_SRC_SPRITEVERTEX_H_
@@ -0,0 +1,298 @@
+/**
+* @file Terrain.cpp
+*/
+#include "Terrain.h"
+#include <emmintrin.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <cmath>
+
+namespace Terrain {
+
+namespace /* unnamed */ {
+
+/// 高さに対応する色.
+const float colorList[][3] = {
+	{ 0.1f, 0.2f, 0.5f },
+	{ 0.7f, 0.9f, 1.0f },
+	{ 0.7f, 0.5f, 0.1f },
+	{ 0.3f, 0.65f, 0.1f },
+	{ 0.95f, 1.0f, 1.0f },
+};
+
+/// colorListの各色に対応する高さ.
+const float offsetList[] = { 0.0f, 0.4f, 0.43f, 0.65f, 1.0f };
+
+/**
+* 格子の座標を周期内に折り返す.
+*
+* @param i         格子の座標.
+* @param frequency 周期.
+*
+* @return 0以上frequency未満に折り返した座標.
+*/
+int Wrap(int i, int frequency)
+{
+	const int n = i % frequency;
+	return n < 0 ? n + frequency : n;
+}
+
+/**
+* 0以上1未満に折り返す.
+*/
+float WrapUnit(float u)
+{
+	return u - std::floor(u);
+}
+
+/**
+* 高さと左隣の高さからピクセルの色を求める.
+*
+* @param value     高さ.
+* @param valueLeft 左隣の高さ.
+* @param rgba      色を格納する4バイトの配列.
+*/
+void Shade(float value, float valueLeft, uint8_t* rgba)
+{
+	const float* color = colorList[4];
+	float c[3] = { color[0], color[1], color[2] };
+	for (int i = 1; i < 5; ++i) {
+		if (value <= offsetList[i]) {
+			const float t = (value - offsetList[i - 1]) / (offsetList[i] - offsetList[i - 1]);
+			for (int j = 0; j < 3; ++j) {
+				c[j] = colorList[i - 1][j] * (1.0f - t) + colorList[i][j] * t;
+			}
+			if (value > offsetList[1] && value < valueLeft) {
+				const float shade = 1.0f + (value - valueLeft) * 50.0f;
+				for (int j = 0; j < 3; ++j) {
+					c[j] *= shade;
+				}
+			}
+			break;
+		}
+	}
+	for (int j = 0; j < 3; ++j) {
+		rgba[j] = static_cast<uint8_t>(std::min(std::max(c[j], 0.0f), 1.0f) * 255.0f + 0.5f);
+	}
+	rgba[3] = 255;
+}
+
+/**
+* 4つの点のフラクタルノイズをSIMDで計算する.
+*
+* 格子点の乱数はseedTableから引くため、sinの計算は不要.
+*
+* @param seedTable 周期periodの格子点の乱数表.
+* @param u         4つの点のX座標. 0以上1未満であること.
+* @param v         4つの点に共通のY座標. 0以上1未満であること.
+*
+* @return 4つの点の高さ.
+*/
+__m128 FractalNoise4(const float* seedTable, __m128 u, float v)
+{
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 two = _mm_set1_ps(2.0f);
+	const __m128 three = _mm_set1_ps(3.0f);
+	__m128 value = _mm_setzero_ps();
+	float scale = 0.5f;
+	int freq = baseFrequency;
+	for (int octave = 0; octave < octaveCount; ++octave, scale *= 0.5f, freq *= 2) {
+		// Y方向は4つの点で共通なのでスカラーで計算する.
+		const float y = v * static_cast<float>(freq);
+		const float iy = std::floor(y);
+		const float fy = y - iy;
+		const float uy = fy * fy * (3.0f - 2.0f * fy);
+		const int y0 = Wrap(static_cast<int>(iy), freq);
+		const float* row0 = seedTable + y0 * period;
+		const float* row1 = seedTable + Wrap(y0 + 1, freq) * period;
+
+		const __m128 x = _mm_mul_ps(u, _mm_set1_ps(static_cast<float>(freq)));
+		__m128i ix = _mm_cvttps_epi32(x);
+		const __m128 fx = _mm_sub_ps(x, _mm_cvtepi32_ps(ix));
+		const __m128 ux = _mm_mul_ps(_mm_mul_ps(fx, fx), _mm_sub_ps(three, _mm_mul_ps(two, fx)));
+		const __m128i vfreq = _mm_set1_epi32(freq);
+		ix = _mm_sub_epi32(ix, _mm_and_si128(_mm_cmpgt_epi32(ix, _mm_sub_epi32(vfreq, _mm_set1_epi32(1))), vfreq));
+		__m128i ix1 = _mm_add_epi32(ix, _mm_set1_epi32(1));
+		ix1 = _mm_andnot_si128(_mm_cmpeq_epi32(ix1, vfreq), ix1);
+
+		alignas(16) int32_t x0[4];
+		alignas(16) int32_t x1[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(x0), ix);
+		_mm_store_si128(reinterpret_cast<__m128i*>(x1), ix1);
+		const __m128 a = _mm_setr_ps(row0[x0[0]], row0[x0[1]], row0[x0[2]], row0[x0[3]]);
+		const __m128 b = _mm_setr_ps(row0[x1[0]], row0[x1[1]], row0[x1[2]], row0[x1[3]]);
+		const __m128 c = _mm_setr_ps(row1[x0[0]], row1[x0[1]], row1[x0[2]], row1[x0[3]]);
+		const __m128 d = _mm_setr_ps(row1[x1[0]], row1[x1[1]], row1[x1[2]], row1[x1[3]]);
+
+		// (a * (1 - ux) + b * ux) + (c - a) * uy * (1 - ux) + (d - b) * uy * ux
+		const __m128 vuy = _mm_set1_ps(uy);
+		const __m128 invUx = _mm_sub_ps(one, ux);
+		__m128 n = _mm_add_ps(_mm_mul_ps(a, invUx), _mm_mul_ps(b, ux));
+		n = _mm_add_ps(n, _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(c, a), vuy), invUx));
+		n = _mm_add_ps(n, _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(d, b), vuy), ux));
+		value = _mm_add_ps(value, _mm_mul_ps(n, _mm_set1_ps(scale)));
+	}
+	return value;
+}
+
+/**
+* 指定した範囲の行を生成する.
+*
+* @param seedTable 周期periodの格子点の乱数表.
+* @param image     生成した画像を格納するバッファ.
+* @param rowPitch  1行のバイト数.
+* @param width     画像の幅.
+* @param height    画像の高さ.
+* @param begin     生成する最初の行.
+* @param end       生成する最後の行の次の行.
+*/
+void BakeRows(const float* seedTable, uint8_t* image, size_t rowPitch, uint32_t width, uint32_t height, uint32_t begin, uint32_t end)
+{
+	for (uint32_t y = begin; y < end; ++y) {
+		const float v = (static_cast<float>(y) + 0.5f) / static_cast<float>(height);
+		uint8_t* p = image + rowPitch * y;
+		for (uint32_t x = 0; x < width; x += 4) {
+			alignas(16) float u[4];
+			alignas(16) float uLeft[4];
+			for (uint32_t i = 0; i < 4; ++i) {
+				u[i] = (static_cast<float>(x + i) + 0.5f) / static_cast<float>(width);
+				uLeft[i] = WrapUnit(u[i] - shadeOffset);
+			}
+			alignas(16) float value[4];
+			alignas(16) float valueLeft[4];
+			_mm_store_ps(value, FractalNoise4(seedTable, _mm_load_ps(u), v));
+			_mm_store_ps(valueLeft, FractalNoise4(seedTable, _mm_load_ps(uLeft), v));
+			const uint32_t count = std::min(4U, width - x);
+			for (uint32_t i = 0; i < count; ++i) {
+				Shade(value[i], valueLeft[i], p);
+				p += 4;
+			}
+		}
+	}
+}
+
+} // unnamed namespace
+
+/**
+* 格子点の乱数を計算する.
+*
+* @param x 格子点のX座標.
+* @param y 格子点のY座標.
+*
+* @return 0以上1未満の乱数.
+*/
+float NoiseSeed(float x, float y)
+{
+	const float n = std::sin(x * 12.9898f + y * 78.233f) * 43758.5453123f;
+	return n - std::floor(n);
+}
+
+/**
+* 値ノイズを計算する.
+*
+* @param x         X座標.
+* @param y         Y座標.
+* @param frequency 格子の周期. 格子の座標はこの値で折り返される.
+*
+* @return 0以上1未満のノイズ値.
+*/
+float Noise(float x, float y, int frequency)
+{
+	const float ix = std::floor(x);
+	const float iy = std::floor(y);
+	const float fx = x - ix;
+	const float fy = y - iy;
+	const float ux = fx * fx * (3.0f - 2.0f * fx);
+	const float uy = fy * fy * (3.0f - 2.0f * fy);
+	const int x0 = Wrap(static_cast<int>(ix), frequency);
+	const int y0 = Wrap(static_cast<int>(iy), frequency);
+	const float x1 = static_cast<float>(Wrap(x0 + 1, frequency));
+	const float y1 = static_cast<float>(Wrap(y0 + 1, frequency));
+	const float a = NoiseSeed(static_cast<float>(x0), static_cast<float>(y0));
+	const float b = NoiseSeed(x1, static_cast<float>(y0));
+	const float c = NoiseSeed(static_cast<float>(x0), y1);
+	const float d = NoiseSeed(x1, y1);
+	return (a * (1.0f - ux) + b * ux) + (c - a) * uy * (1.0f - ux) + (d - b) * uy * ux;
+}
+
+/**
+* 値ノイズのフラクタル和(高さ)を計算する.
+*
+* @param u X座標. 1で1周期となる.
+* @param v Y座標. 1で1周期となる.
+*
+* @return 0以上1未満の高さ.
+*/
+float FractalNoise(float u, float v)
+{
+	float value = 0.0f;
+	float scale = 0.5f;
+	int freq = baseFrequency;
+	for (int i = 0; i < octaveCount; ++i) {
+		value += Noise(u * static_cast<float>(freq), v * static_cast<float>(freq), freq) * scale;
+		scale *= 0.5f;
+		freq *= 2;
+	}
+	return value;
+}
+
+/**
+* 1ピクセルの色を計算する.
+*
+* NoiseTexture.hlslのピクセルシェーダと同じ計算を行う参照実装.
+* ブレンドを行わないため、アルファは常に255とする.
+*
+* @param u    X座標. 0以上1未満であること.
+* @param v    Y座標. 0以上1未満であること.
+* @param rgba 色を格納する4バイトの配列.
+*/
+void EvaluatePixel(float u, float v, uint8_t* rgba)
+{
+	Shade(FractalNoise(u, v), FractalNoise(WrapUnit(u - shadeOffset), v), rgba);
+}
+
+/**
+* 地形テクスチャを生成する.
+*
+* 4ピクセルずつSIMDで計算し、行を複数のスレッドに分けて生成する.
+*
+* @param image       生成した画像を格納するバッファ. R8G8B8A8形式で書き込まれる.
+* @param rowPitch    1行のバイト数.
+* @param width       画像の幅.
+* @param height      画像の高さ.
+* @param threadCount 使用するスレッド数. 0ならハードウェアのスレッド数.
+*/
+void Bake(uint8_t* image, size_t rowPitch, uint32_t width, uint32_t height, uint32_t threadCount)
+{
+	// 全てのノイズの格子点は周期periodの格子点に含まれるので、最初に乱数表を作っておく.
+	std::vector<float> seedTable(period * period);
+	for (int y = 0; y < period; ++y) {
+		for (int x = 0; x < period; ++x) {
+			seedTable[y * period + x] = NoiseSeed(static_cast<float>(x), static_cast<float>(y));
+		}
+	}
+
+	if (threadCount == 0) {
+		threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+	}
+	threadCount = std::min(threadCount, height);
+	if (threadCount <= 1) {
+		BakeRows(seedTable.data(), image, rowPitch, width, height, 0, height);
+		return;
+	}
+	std::vector<std::thread> threadList;
+	threadList.reserve(threadCount - 1);
+	const uint32_t rowsPerThread = (height + threadCount - 1) / threadCount;
+	for (uint32_t i = 1; i < threadCount; ++i) {
+		const uint32_t begin = std::min(rowsPerThread * i, height);
+		const uint32_t end = std::min(begin + rowsPerThread, height);
+		threadList.push_back(std::thread(BakeRows, seedTable.data(), image, rowPitch, width, height, begin, end));
+	}
+	BakeRows(seedTable.data(), image, rowPitch, width, height, 0, std::min(rowsPerThread, height));
+	for (auto& e : threadList) {
+		e.join();
+	}
+}
+
+} // namespace Terrain
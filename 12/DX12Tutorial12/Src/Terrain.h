@@ -0,0 +1,33 @@
+/**
+* @file Terrain.h
+*/
+#ifndef DX12TUTORIAL_SRC_TERRAIN_H_
+#define DX12TUTORIAL_SRC_TERRAIN_H_
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+* 地形テクスチャ生成用名前空間.
+*
+* 値ノイズのフラクタル和を高さとみなし、高さに応じた色と左隣との差による陰影を付ける.
+* ノイズの格子は周期periodで折り返すため、生成したテクスチャは上下左右に継ぎ目なく並べられる.
+*
+* EvaluatePixelはシェーダと同じ計算を1ピクセルずつ行う参照実装. Test/TerrainTest.cppでBakeの結果と
+* 全ピクセルを比べ、スレッド数を変えても同じ画像になることを確かめている.
+*/
+namespace Terrain {
+
+static const int octaveCount = 5; ///< 重ね合わせるノイズの数.
+static const int baseFrequency = 3; ///< 最初のノイズの格子数.
+static const int period = baseFrequency << (octaveCount - 1); ///< 最も細かいノイズの格子数. 全てのノイズはこの周期で折り返す.
+static const float shadeOffset = 1.0f / 800.0f; ///< 陰影を計算するための左隣の点までの距離.
+
+float NoiseSeed(float x, float y);
+float Noise(float x, float y, int frequency);
+float FractalNoise(float u, float v);
+void EvaluatePixel(float u, float v, uint8_t* rgba);
+void Bake(uint8_t* image, size_t rowPitch, uint32_t width, uint32_t height, uint32_t threadCount = 0);
+
+} // namespace Terrain
+
+#endif // DX12TUTORIAL_SRC_TERRAIN_H_
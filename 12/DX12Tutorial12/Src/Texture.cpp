@@ -1,464 +1,1423 @@
-/**
-* @file Texture.cpp
-*/
-#include "Texture.h"
-#include "d3dx12.h"
-
-namespace Resource
-{
-
-using Microsoft::WRL::ComPtr;
-
-/**
-* WICtH[}bgΉDXGItH[}bg𓾂.
-*
-* @param wicFormat WICtH[}bgGUID.
-*
-* @return wicFormatɑΉDXGItH[}bg.
-*         ΉtH[}bgȂꍇDXGI_FORMAT_UNKNOWNԂ.
-*/
-DXGI_FORMAT GetDXGIFormatFromWICFormat(const WICPixelFormatGUID& wicFormat)
-{
-	static const struct {
-		WICPixelFormatGUID guid;
-		DXGI_FORMAT format;
-	} wicToDxgiList[] = {
-		{ GUID_WICPixelFormat128bppRGBAFloat, DXGI_FORMAT_R32G32B32A32_FLOAT },
-		{ GUID_WICPixelFormat64bppRGBAHalf, DXGI_FORMAT_R16G16B16A16_FLOAT },
-		{ GUID_WICPixelFormat64bppRGBA, DXGI_FORMAT_R16G16B16A16_UNORM },
-		{ GUID_WICPixelFormat32bppRGBA, DXGI_FORMAT_R8G8B8A8_UNORM },
-		{ GUID_WICPixelFormat32bppBGRA, DXGI_FORMAT_B8G8R8A8_UNORM },
-		{ GUID_WICPixelFormat32bppBGR, DXGI_FORMAT_B8G8R8X8_UNORM },
-		{ GUID_WICPixelFormat32bppRGBA1010102XR, DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM },
-		{ GUID_WICPixelFormat32bppRGBA1010102, DXGI_FORMAT_R10G10B10A2_UNORM },
-		{ GUID_WICPixelFormat16bppBGRA5551, DXGI_FORMAT_B5G5R5A1_UNORM },
-		{ GUID_WICPixelFormat16bppBGR565, DXGI_FORMAT_B5G6R5_UNORM },
-		{ GUID_WICPixelFormat32bppGrayFloat, DXGI_FORMAT_R32_FLOAT },
-		{ GUID_WICPixelFormat16bppGrayHalf, DXGI_FORMAT_R16_FLOAT },
-		{ GUID_WICPixelFormat16bppGray, DXGI_FORMAT_R16_UNORM },
-		{ GUID_WICPixelFormat8bppGray, DXGI_FORMAT_R8_UNORM },
-		{ GUID_WICPixelFormat8bppAlpha, DXGI_FORMAT_A8_UNORM },
-	};
-	for (auto e : wicToDxgiList) {
-		if (e.guid == wicFormat) {
-			return e.format;
-		}
-	}
-	return DXGI_FORMAT_UNKNOWN;
-}
-
-/**
-* CӂWICtH[}bgDXGItH[}bgƌ݊̂WICtH[}bg𓾂.
-*
-* @param wicFormat WICtH[}bgGUID.
-*
-* @return DXGItH[}bgƌ݊̂WICtH[}bg.
-*         ̌`ł邾Čł悤ȃtH[}bgI΂.
-*         ̂悤ȃtH[}bgȂꍇGUID_WICPixelFormatDontCareԂ.
-*/
-WICPixelFormatGUID GetDXGICompatibleWICFormat(const WICPixelFormatGUID& wicFormat)
-{
-	static const struct {
-		WICPixelFormatGUID guid, compatible;
-	} guidToCompatibleList[] = {
-		{ GUID_WICPixelFormatBlackWhite, GUID_WICPixelFormat8bppGray },
-		{ GUID_WICPixelFormat1bppIndexed, GUID_WICPixelFormat32bppRGBA },
-		{ GUID_WICPixelFormat2bppIndexed, GUID_WICPixelFormat32bppRGBA },
-		{ GUID_WICPixelFormat4bppIndexed, GUID_WICPixelFormat32bppRGBA },
-		{ GUID_WICPixelFormat8bppIndexed, GUID_WICPixelFormat32bppRGBA },
-		{ GUID_WICPixelFormat2bppGray, GUID_WICPixelFormat8bppGray },
-		{ GUID_WICPixelFormat4bppGray, GUID_WICPixelFormat8bppGray },
-		{ GUID_WICPixelFormat16bppGrayFixedPoint, GUID_WICPixelFormat16bppGrayHalf },
-		{ GUID_WICPixelFormat32bppGrayFixedPoint, GUID_WICPixelFormat32bppGrayFloat },
-		{ GUID_WICPixelFormat16bppBGR555, GUID_WICPixelFormat16bppBGRA5551 },
-		{ GUID_WICPixelFormat32bppBGR101010, GUID_WICPixelFormat32bppRGBA1010102 },
-		{ GUID_WICPixelFormat24bppBGR, GUID_WICPixelFormat32bppRGBA },
-		{ GUID_WICPixelFormat24bppRGB, GUID_WICPixelFormat32bppRGBA },
-		{ GUID_WICPixelFormat32bppPBGRA, GUID_WICPixelFormat32bppRGBA },
-		{ GUID_WICPixelFormat32bppPRGBA, GUID_WICPixelFormat32bppRGBA },
-		{ GUID_WICPixelFormat48bppRGB, GUID_WICPixelFormat64bppRGBA },
-		{ GUID_WICPixelFormat48bppBGR, GUID_WICPixelFormat64bppRGBA },
-		{ GUID_WICPixelFormat64bppBGRA, GUID_WICPixelFormat64bppRGBA },
-		{ GUID_WICPixelFormat64bppPRGBA, GUID_WICPixelFormat64bppRGBA },
-		{ GUID_WICPixelFormat64bppPBGRA, GUID_WICPixelFormat64bppRGBA },
-		{ GUID_WICPixelFormat48bppRGBFixedPoint, GUID_WICPixelFormat64bppRGBAHalf },
-		{ GUID_WICPixelFormat48bppBGRFixedPoint, GUID_WICPixelFormat64bppRGBAHalf },
-		{ GUID_WICPixelFormat64bppRGBAFixedPoint, GUID_WICPixelFormat64bppRGBAHalf },
-		{ GUID_WICPixelFormat64bppBGRAFixedPoint, GUID_WICPixelFormat64bppRGBAHalf },
-		{ GUID_WICPixelFormat64bppRGBFixedPoint, GUID_WICPixelFormat64bppRGBAHalf },
-		{ GUID_WICPixelFormat64bppRGBHalf, GUID_WICPixelFormat64bppRGBAHalf },
-		{ GUID_WICPixelFormat48bppRGBHalf, GUID_WICPixelFormat64bppRGBAHalf },
-		{ GUID_WICPixelFormat128bppPRGBAFloat, GUID_WICPixelFormat128bppRGBAFloat },
-		{ GUID_WICPixelFormat128bppRGBFloat, GUID_WICPixelFormat128bppRGBAFloat },
-		{ GUID_WICPixelFormat128bppRGBAFixedPoint, GUID_WICPixelFormat128bppRGBAFloat },
-		{ GUID_WICPixelFormat128bppRGBFixedPoint, GUID_WICPixelFormat128bppRGBAFloat },
-		{ GUID_WICPixelFormat32bppRGBE, GUID_WICPixelFormat128bppRGBAFloat },
-		{ GUID_WICPixelFormat32bppCMYK, GUID_WICPixelFormat32bppRGBA },
-		{ GUID_WICPixelFormat64bppCMYK, GUID_WICPixelFormat64bppRGBA },
-		{ GUID_WICPixelFormat40bppCMYKAlpha, GUID_WICPixelFormat64bppRGBA },
-		{ GUID_WICPixelFormat80bppCMYKAlpha, GUID_WICPixelFormat64bppRGBA },
-		{ GUID_WICPixelFormat32bppRGB, GUID_WICPixelFormat32bppRGBA },
-		{ GUID_WICPixelFormat64bppRGB, GUID_WICPixelFormat64bppRGBA },
-		{ GUID_WICPixelFormat64bppPRGBAHalf, GUID_WICPixelFormat64bppRGBAHalf },
-	};
-	for (auto e : guidToCompatibleList) {
-		if (e.guid == wicFormat) {
-			return e.compatible;
-		}
-	}
-	return GUID_WICPixelFormatDontCare;
-}
-
-/**
-* DXGItH[}bg1sNZ̃oCg𓾂.
-*
-* @param dxgiFormat DXGItH[}bg.
-*
-* @return dxgiFormatɑΉrbg.
-*/
-int GetDXGIFormatBitesPerPixel(DXGI_FORMAT dxgiFormat)
-{
-	switch (dxgiFormat) {
-	case DXGI_FORMAT_R32G32B32A32_FLOAT: return 16;
-	case DXGI_FORMAT_R16G16B16A16_FLOAT: return 8;
-	case DXGI_FORMAT_R16G16B16A16_UNORM: return 8;
-	case DXGI_FORMAT_R8G8B8A8_UNORM: return 4;
-	case DXGI_FORMAT_B8G8R8A8_UNORM: return 4;
-	case DXGI_FORMAT_B8G8R8X8_UNORM: return 4;
-	case DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM: return 4;
-	case DXGI_FORMAT_R10G10B10A2_UNORM: return 4;
-	case DXGI_FORMAT_B5G5R5A1_UNORM: return 2;
-	case DXGI_FORMAT_B5G6R5_UNORM: return 2;
-	case DXGI_FORMAT_R32_FLOAT: return 4;
-	case DXGI_FORMAT_R16_FLOAT: return 2;
-	case DXGI_FORMAT_R16_UNORM: return 2;
-	case DXGI_FORMAT_R8_UNORM: return 1;
-	case DXGI_FORMAT_A8_UNORM: return 1;
-	default: return 1;
-	}
-}
-
-/**
-* \[Xǂݍ݂Jn.
-*
-* @param heap eNX`pRTVfXNv^擾̃fXNv^q[v.
-*
-* @retval true  .
-* @retval false s.
-*/
-bool ResourceLoader::Begin(Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> heap)
-{
-	descriptorHeap = heap;
-	if (FAILED(descriptorHeap->GetDevice(IID_PPV_ARGS(&device)))) {
-		return false;
-	}
-	if (FAILED(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator)))) {
-		return false;
-	}
-	if (FAILED(device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocator.Get(), nullptr, IID_PPV_ARGS(&commandList)))) {
-		return false;
-	}
-	descriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-
-	if (FAILED(CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&imagingFactory)))) {
-		return false;
-	}
-	return true;
-}
-
-/**
-* \[Xǂݍ݂I.
-*
-* @return R}hXgւ̃|C^.
-*/
-ID3D12GraphicsCommandList* ResourceLoader::End()
-{
-	commandList->Close();
-	return commandList.Get();
-}
-
-/*
-* f[^ftHgq[vɓ].
-*/
-bool ResourceLoader::Upload(Microsoft::WRL::ComPtr<ID3D12Resource>& defaultHeap, const D3D12_RESOURCE_DESC& desc, D3D12_SUBRESOURCE_DATA data, D3D12_RESOURCE_STATES stateAfter, const wchar_t* name)
-{
-	if (FAILED(device->CreateCommittedResource(
-		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
-		D3D12_HEAP_FLAG_NONE,
-		&desc,
-		D3D12_RESOURCE_STATE_COPY_DEST,
-		nullptr,
-		IID_PPV_ARGS(&defaultHeap)
-	))) {
-		return false;
-	}
-	if (name) {
-		defaultHeap->SetName(name);
-	}
-
-	UINT64 heapSize;
-	device->GetCopyableFootprints(&desc, 0, 1, 0, nullptr, nullptr, nullptr, &heapSize);
-	ComPtr<ID3D12Resource> uploadHeap;
-	if (FAILED(device->CreateCommittedResource(
-		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
-		D3D12_HEAP_FLAG_NONE,
-		&CD3DX12_RESOURCE_DESC::Buffer(heapSize),
-		D3D12_RESOURCE_STATE_GENERIC_READ,
-		nullptr,
-		IID_PPV_ARGS(&uploadHeap)
-	))) {
-		return false;
-	}
-	if (UpdateSubresources<1>(commandList.Get(), defaultHeap.Get(), uploadHeap.Get(), 0, 0, 1, &data) == 0) {
-		return false;
-	}
-	commandList->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(defaultHeap.Get(), D3D12_RESOURCE_STATE_COPY_DEST, stateAfter));
-	uploadHeapList.push_back(uploadHeap);
-
-	return true;
-}
-
-/**
-* oCg񂩂eNX`쐬.
-*
-* @param texture  쐬eNX`ǗIuWFNg.
-* @param index    쐬eNX`pRTVfXNv^̃CfbNX.
-* @param desc     eNX`̏ڍ׏.
-* @param data     eNX`쐬ɎgpoCgւ̃|C^.
-* @param name     eNX`\[Xɕt閼O(fobOp). nullptrnƖOtȂ.
-*
-* @retval true  쐬.
-* @retval false 쐬s.
-*/
-bool ResourceLoader::Create(Texture& texture, int index, const D3D12_RESOURCE_DESC& desc, const void* data, const wchar_t* name)
-{
-	ComPtr<ID3D12Resource> textureBuffer;
-	const int bytesPerRow = static_cast<int>(desc.Width * GetDXGIFormatBitesPerPixel(desc.Format));
-	D3D12_SUBRESOURCE_DATA subresource = { data, bytesPerRow, static_cast<LONG_PTR>(bytesPerRow * desc.Height) };
-	if (!Upload(textureBuffer, desc, subresource, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, name)) {
-		return false;
-	}
-
-	device->CreateShaderResourceView(textureBuffer.Get(), nullptr, CD3DX12_CPU_DESCRIPTOR_HANDLE(descriptorHeap->GetCPUDescriptorHandleForHeapStart(), index, descriptorSize));
-
-	texture.resource = textureBuffer;
-	texture.format = desc.Format;
-	texture.handle = CD3DX12_GPU_DESCRIPTOR_HANDLE(descriptorHeap->GetGPUDescriptorHandleForHeapStart(), index, descriptorSize);
-
-	return true;
-}
-
-/**
-* t@CeNX`ǂݍ.
-*
-* @param texture   ǂݍ񂾃eNX`ǗIuWFNg.
-* @param index     ǂݍ񂾃eNX`pRTVfXNv^̃CfbNX.
-* @param filename  eNX`t@C.
-*
-* @retval true  ǂݍݐ.
-* @retval false ǂݍݎs.
-*/
-bool ResourceLoader::LoadFromFile(Texture& texture, int index, const wchar_t* filename)
-{
-	ComPtr<IWICBitmapDecoder> decoder;
-	if (FAILED(imagingFactory->CreateDecoderFromFilename(filename, nullptr, GENERIC_READ, WICDecodeMetadataCacheOnLoad, decoder.GetAddressOf()))) {
-		return false;
-	}
-	ComPtr<IWICBitmapFrameDecode> frame;
-	if (FAILED(decoder->GetFrame(0, frame.GetAddressOf()))) {
-		return false;
-	}
-	WICPixelFormatGUID wicFormat;
-	if (FAILED(frame->GetPixelFormat(&wicFormat))) {
-		return false;
-	}
-	UINT width, height;
-	if (FAILED(frame->GetSize(&width, &height))) {
-		return false;
-	}
-	DXGI_FORMAT dxgiFormat = GetDXGIFormatFromWICFormat(wicFormat);
-	bool imageConverted = false;
-	ComPtr<IWICFormatConverter> converter;
-	if (dxgiFormat == DXGI_FORMAT_UNKNOWN) {
-		const WICPixelFormatGUID compatibleFormat = GetDXGICompatibleWICFormat(wicFormat);
-		if (compatibleFormat == GUID_WICPixelFormatDontCare) {
-			return false;
-		}
-		dxgiFormat = GetDXGIFormatFromWICFormat(compatibleFormat);
-		if (FAILED(imagingFactory->CreateFormatConverter(converter.GetAddressOf()))) {
-			return false;
-		}
-		BOOL canConvert = FALSE;
-		if (FAILED(converter->CanConvert(wicFormat, compatibleFormat, &canConvert))) {
-			return false;
-		}
-		if (!canConvert) {
-			return false;
-		}
-		if (FAILED(converter->Initialize(frame.Get(), compatibleFormat, WICBitmapDitherTypeNone, nullptr, 0, WICBitmapPaletteTypeCustom))) {
-			return false;
-		}
-		imageConverted = true;
-	}
-	const int bytesPerRow = width * GetDXGIFormatBitesPerPixel(dxgiFormat);
-	const int imageSize = bytesPerRow * height;
-	std::vector<uint8_t> imageData;
-	imageData.resize(imageSize);
-	if (imageConverted) {
-		if (FAILED(converter->CopyPixels(nullptr, bytesPerRow, imageSize, imageData.data()))) {
-			return false;
-		}
-	} else {
-		if (FAILED(frame->CopyPixels(nullptr, bytesPerRow, imageSize, imageData.data()))) {
-			return false;
-		}
-	}
-
-	const D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Tex2D(dxgiFormat, width, height, 1, 1);
-	if (!Create(texture, index, desc, imageData.data(), filename)) {
-		return false;
-	}
-	return true;
-}
-
-/**
-* .
-*
-* @param heap eNX`pCSUfXNv^擾̃fXNv^q[v.
-*/
-void TextureMap::Init(Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> heap)
-{
-	descriptorHeap = heap;
-	size_t numDescriptors = descriptorHeap->GetDesc().NumDescriptors;
-	const uint16_t avairableCount = numDescriptors > 4096 ? 4096 : static_cast<uint16_t>(numDescriptors);
-	freeIDList.resize(avairableCount);
-	uint16_t id = avairableCount - 1;
-	for (size_t i = 0; i < avairableCount; ++i) {
-		freeIDList[i] = id;
-		--id;
-	}
-}
-
-/**
-* \[Xǂݍ݂Jn.
-*
-* @retval true  .
-* @retval false s.
-*/
-bool TextureMap::Begin()
-{
-	Microsoft::WRL::ComPtr<ID3D12Device> device;
-	if (FAILED(descriptorHeap->GetDevice(IID_PPV_ARGS(&device)))) {
-		return false;
-	}
-	descriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-	loader.reset(new ResourceLoader);
-	loader->Begin(descriptorHeap);
-	return true;
-}
-
-/**
-* \[Xǂݍ݂I.
-*
-* @return R}hXgւ̃|C^.
-*/
-ID3D12GraphicsCommandList* TextureMap::End()
-{
-	return loader->End();
-}
-
-/**
-* OveNX`.
-*
-* @param texture  ߂ltruȅꍇɁAeNX`i[IuWFNg.
-* @param name     eNX`.
-*
-* @retval true  nameɈveNX`𔭌.
-* @retval false nameɈveNX`ێĂȂ.
-*/
-bool TextureMap::Find(Texture& texture, const wchar_t* name)
-{
-	auto itr = map.find(name);
-	if (itr == map.end()) {
-		return false;
-	}
-	texture = itr->second;
-	return true;
-}
-
-/**
-* oCg񂩂eNX`쐬.
-*
-* @param texture  쐬eNX`ǗIuWFNg.
-* @param name     eNX`\[Xɕt閼O.
-* @param desc     eNX`̏ڍ׏.
-* @param data     eNX`쐬ɎgpoCgւ̃|C^.
-*
-* @retval true  쐬.
-* @retval false 쐬s.
-*/
-bool TextureMap::Create(Texture& texture, const wchar_t* name, const D3D12_RESOURCE_DESC& desc, const void* data)
-{
-	if (Find(texture, name)) {
-		return true;
-	}
-
-	if (freeIDList.empty()) {
-		return false;
-	}
-	const int index = freeIDList.back();
-	if (loader->Create(texture, index, desc, data, name)) {
-		freeIDList.pop_back();
-		map.insert(std::make_pair(name, texture));
-		return true;
-	}
-	return false;
-}
-
-/**
-* t@CeNX`ǂݍ.
-*
-* @param texture   ǂݍ񂾃eNX`ǗIuWFNg.
-* @param filename  eNX`t@C.
-*
-* @retval true  ǂݍݐ.
-* @retval false ǂݍݎs.
-*/
-bool TextureMap::LoadFromFile(Texture& texture, const wchar_t* filename)
-{
-	if (Find(texture, filename)) {
-		return true;
-	}
-
-	if (freeIDList.empty()) {
-		return false;
-	}
-	const int index = freeIDList.back();
-	if (loader->LoadFromFile(texture, index, filename)) {
-		freeIDList.pop_back();
-		map.insert(std::make_pair(filename, texture));
-		return true;
-	}
-	return false;
-}
-
-/**
-* QƂȂȂeNX`j.
-*/
-void TextureMap::GC()
-{
-	auto itr = map.begin();
-	while (itr != map.end()) {
-		itr->second.resource.Get()->AddRef();
-		const ULONG refCount = itr->second.resource.Get()->Release();
-		if (refCount == 1) {
-			const int index = static_cast<int>((itr->second.handle.ptr - descriptorHeap->GetGPUDescriptorHandleForHeapStart().ptr) / descriptorSize);
-			itr = map.erase(itr);
-			freeIDList.push_back(index);
-		} else {
-			++itr;
-		}
-	}
-}
-
+/**
+* @file Texture.cpp
+*/
+#include "Texture.h"
+#include "d3dx12.h"
+#include <algorithm>
+#include <atomic>
+
+namespace Resource
+{
+
+using Microsoft::WRL::ComPtr;
+
+/**
+* テクスチャの常駐状態.
+*/
+enum class TextureState
+{
+	Resident, ///< 完全なテクスチャが常駐している.
+	Evicted, ///< 追い出されている. 縮小版を表示する.
+	StreamRequested, ///< 追い出されていて、再読み込みを待っている.
+	Streaming, ///< 再読み込みしたデータを転送している.
+};
+
+/**
+* TextureMapが管理するテクスチャの参照カウント・常駐情報.
+*
+* resident, placeholderは参照カウントを持たない.
+*/
+struct TextureEntry
+{
+	Texture resident; ///< 完全なテクスチャ. 追い出されている間は空.
+	Texture placeholder; ///< 縮小版テクスチャ. 空ならこのテクスチャは追い出されない.
+	TextureMap* owner; ///< 管理元のTextureMap. TextureMapが先に破棄された場合はnullptr.
+	const std::wstring* name; ///< テクスチャ名.
+	uint32_t refCount; ///< テクスチャを参照しているTextureオブジェクトの数.
+	uint32_t releaseSerial; ///< 解放待ちキューに積まれた回数.
+	TextureState state;
+	UINT64 size; ///< residentのバイト数.
+	std::atomic<UINT64> lastUsedFenceValue; ///< 最後に使われたフレームの完了を示すフレームフェンスの値. MarkUsedがロックせずに読む.
+	std::list<TextureEntry*>::iterator lruItr; ///< lruList内の位置. 追い出し可能な常駐テクスチャのみ有効.
+
+	/// 描画に使うテクスチャを取得する.
+	const Texture& Current() const { return state == TextureState::Resident ? resident : placeholder; }
+};
+
+/**
+* コピーコンストラクタ.
+*
+* 管理されているテクスチャの場合、参照カウントを増やす.
+*/
+Texture::Texture(const Texture& other) :
+	resource(other.resource),
+	format(other.format),
+	handle(other.handle),
+	heap(other.heap),
+	descriptor(other.descriptor),
+	allocation(other.allocation),
+	readyFenceValue(other.readyFenceValue),
+	paletteResource(other.paletteResource),
+	paletteAllocation(other.paletteAllocation),
+	entry(other.entry)
+{
+	if (entry) {
+		++entry->refCount;
+	}
+}
+
+/**
+* コピー代入演算子.
+*
+* 管理されているテクスチャの場合、新しいテクスチャの参照カウントを増やし、古いテクスチャの参照カウントを減らす.
+*/
+Texture& Texture::operator=(const Texture& other)
+{
+	if (other.entry) {
+		++other.entry->refCount;
+	}
+	TextureEntry* oldEntry = entry;
+	resource = other.resource;
+	format = other.format;
+	handle = other.handle;
+	heap = other.heap;
+	descriptor = other.descriptor;
+	allocation = other.allocation;
+	readyFenceValue = other.readyFenceValue;
+	paletteResource = other.paletteResource;
+	paletteAllocation = other.paletteAllocation;
+	entry = other.entry;
+	if (oldEntry && --oldEntry->refCount == 0) {
+		if (oldEntry->owner) {
+			oldEntry->owner->Release(*oldEntry);
+		} else {
+			delete oldEntry;
+		}
+	}
+	return *this;
+}
+
+/**
+* デストラクタ.
+*
+* 管理されているテクスチャの場合、参照カウントを減らす.
+* 参照カウントが0になったら、テクスチャを解放待ちキューに積む.
+*/
+Texture::~Texture()
+{
+	if (entry && --entry->refCount == 0) {
+		if (entry->owner) {
+			entry->owner->Release(*entry);
+		} else {
+			delete entry;
+		}
+	}
+}
+
+/**
+* 描画に使うテクスチャを取得する.
+*
+* TextureMapが管理するテクスチャの場合、使われたことを記録し、現在の常駐状態に応じて
+* 完全なテクスチャか縮小版テクスチャを返す.
+*
+* @return 描画に使うテクスチャ.
+*/
+const Texture& Texture::Resolve() const
+{
+	if (!entry) {
+		return *this;
+	}
+	if (entry->owner) {
+		entry->owner->MarkUsed(*entry);
+	}
+	return entry->Current();
+}
+
+/**
+* WICフォーマットから対応するDXGIフォーマットを得る.
+*
+* @param wicFormat WICフォーマットを示すGUID.
+*
+* @return wicFormatに対応するDXGIフォーマット.
+*         対応するフォーマットが見つからない場合はDXGI_FORMAT_UNKNOWNを返す.
+*/
+DXGI_FORMAT GetDXGIFormatFromWICFormat(const WICPixelFormatGUID& wicFormat)
+{
+	static const struct {
+		WICPixelFormatGUID guid;
+		DXGI_FORMAT format;
+	} wicToDxgiList[] = {
+		{ GUID_WICPixelFormat128bppRGBAFloat, DXGI_FORMAT_R32G32B32A32_FLOAT },
+		{ GUID_WICPixelFormat128bppPRGBAFloat, DXGI_FORMAT_R32G32B32A32_FLOAT },
+		{ GUID_WICPixelFormat64bppRGBAHalf, DXGI_FORMAT_R16G16B16A16_FLOAT },
+		{ GUID_WICPixelFormat64bppPRGBAHalf, DXGI_FORMAT_R16G16B16A16_FLOAT },
+		{ GUID_WICPixelFormat64bppRGBA, DXGI_FORMAT_R16G16B16A16_UNORM },
+		{ GUID_WICPixelFormat64bppPRGBA, DXGI_FORMAT_R16G16B16A16_UNORM },
+		{ GUID_WICPixelFormat32bppRGBA, DXGI_FORMAT_R8G8B8A8_UNORM },
+		{ GUID_WICPixelFormat32bppPRGBA, DXGI_FORMAT_R8G8B8A8_UNORM },
+		{ GUID_WICPixelFormat32bppBGRA, DXGI_FORMAT_B8G8R8A8_UNORM },
+		{ GUID_WICPixelFormat32bppPBGRA, DXGI_FORMAT_B8G8R8A8_UNORM },
+		{ GUID_WICPixelFormat32bppBGR, DXGI_FORMAT_B8G8R8X8_UNORM },
+		{ GUID_WICPixelFormat32bppRGBA1010102XR, DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM },
+		{ GUID_WICPixelFormat32bppRGBA1010102, DXGI_FORMAT_R10G10B10A2_UNORM },
+		{ GUID_WICPixelFormat16bppBGRA5551, DXGI_FORMAT_B5G5R5A1_UNORM },
+		{ GUID_WICPixelFormat16bppBGR565, DXGI_FORMAT_B5G6R5_UNORM },
+		{ GUID_WICPixelFormat32bppGrayFloat, DXGI_FORMAT_R32_FLOAT },
+		{ GUID_WICPixelFormat16bppGrayHalf, DXGI_FORMAT_R16_FLOAT },
+		{ GUID_WICPixelFormat16bppGray, DXGI_FORMAT_R16_UNORM },
+		{ GUID_WICPixelFormat8bppGray, DXGI_FORMAT_R8_UNORM },
+		{ GUID_WICPixelFormat8bppAlpha, DXGI_FORMAT_A8_UNORM },
+	};
+	for (auto e : wicToDxgiList) {
+		if (e.guid == wicFormat) {
+			return e.format;
+		}
+	}
+	return DXGI_FORMAT_UNKNOWN;
+}
+
+/**
+* 任意のWICフォーマットからDXGIフォーマットと互換性のあるWICフォーマットを得る.
+*
+* @param wicFormat WICフォーマットのGUID.
+*
+* @return DXGIフォーマットと互換性のあるWICフォーマット.
+*         元の形式をできるだけ再現できるようなフォーマットが選ばれる.
+*         そのようなフォーマットが見つからない場合はGUID_WICPixelFormatDontCareを返す.
+*/
+WICPixelFormatGUID GetDXGICompatibleWICFormat(const WICPixelFormatGUID& wicFormat)
+{
+	static const struct {
+		WICPixelFormatGUID guid, compatible;
+	} guidToCompatibleList[] = {
+		{ GUID_WICPixelFormatBlackWhite, GUID_WICPixelFormat8bppGray },
+		{ GUID_WICPixelFormat1bppIndexed, GUID_WICPixelFormat32bppRGBA },
+		{ GUID_WICPixelFormat2bppIndexed, GUID_WICPixelFormat32bppRGBA },
+		{ GUID_WICPixelFormat4bppIndexed, GUID_WICPixelFormat32bppRGBA },
+		{ GUID_WICPixelFormat8bppIndexed, GUID_WICPixelFormat32bppRGBA },
+		{ GUID_WICPixelFormat2bppGray, GUID_WICPixelFormat8bppGray },
+		{ GUID_WICPixelFormat4bppGray, GUID_WICPixelFormat8bppGray },
+		{ GUID_WICPixelFormat16bppGrayFixedPoint, GUID_WICPixelFormat16bppGrayHalf },
+		{ GUID_WICPixelFormat32bppGrayFixedPoint, GUID_WICPixelFormat32bppGrayFloat },
+		{ GUID_WICPixelFormat16bppBGR555, GUID_WICPixelFormat16bppBGRA5551 },
+		{ GUID_WICPixelFormat32bppBGR101010, GUID_WICPixelFormat32bppRGBA1010102 },
+		{ GUID_WICPixelFormat24bppBGR, GUID_WICPixelFormat32bppRGBA },
+		{ GUID_WICPixelFormat24bppRGB, GUID_WICPixelFormat32bppRGBA },
+		{ GUID_WICPixelFormat48bppRGB, GUID_WICPixelFormat64bppRGBA },
+		{ GUID_WICPixelFormat48bppBGR, GUID_WICPixelFormat64bppRGBA },
+		{ GUID_WICPixelFormat64bppBGRA, GUID_WICPixelFormat64bppRGBA },
+		{ GUID_WICPixelFormat64bppPBGRA, GUID_WICPixelFormat64bppPRGBA },
+		{ GUID_WICPixelFormat48bppRGBFixedPoint, GUID_WICPixelFormat64bppRGBAHalf },
+		{ GUID_WICPixelFormat48bppBGRFixedPoint, GUID_WICPixelFormat64bppRGBAHalf },
+		{ GUID_WICPixelFormat64bppRGBAFixedPoint, GUID_WICPixelFormat64bppRGBAHalf },
+		{ GUID_WICPixelFormat64bppBGRAFixedPoint, GUID_WICPixelFormat64bppRGBAHalf },
+		{ GUID_WICPixelFormat64bppRGBFixedPoint, GUID_WICPixelFormat64bppRGBAHalf },
+		{ GUID_WICPixelFormat64bppRGBHalf, GUID_WICPixelFormat64bppRGBAHalf },
+		{ GUID_WICPixelFormat48bppRGBHalf, GUID_WICPixelFormat64bppRGBAHalf },
+		{ GUID_WICPixelFormat128bppRGBFloat, GUID_WICPixelFormat128bppRGBAFloat },
+		{ GUID_WICPixelFormat128bppRGBAFixedPoint, GUID_WICPixelFormat128bppRGBAFloat },
+		{ GUID_WICPixelFormat128bppRGBFixedPoint, GUID_WICPixelFormat128bppRGBAFloat },
+		{ GUID_WICPixelFormat32bppRGBE, GUID_WICPixelFormat128bppRGBAFloat },
+		{ GUID_WICPixelFormat32bppCMYK, GUID_WICPixelFormat32bppRGBA },
+		{ GUID_WICPixelFormat64bppCMYK, GUID_WICPixelFormat64bppRGBA },
+		{ GUID_WICPixelFormat40bppCMYKAlpha, GUID_WICPixelFormat64bppRGBA },
+		{ GUID_WICPixelFormat80bppCMYKAlpha, GUID_WICPixelFormat64bppRGBA },
+		{ GUID_WICPixelFormat32bppRGB, GUID_WICPixelFormat32bppRGBA },
+		{ GUID_WICPixelFormat64bppRGB, GUID_WICPixelFormat64bppRGBA },
+	};
+	for (auto e : guidToCompatibleList) {
+		if (e.guid == wicFormat) {
+			return e.compatible;
+		}
+	}
+	return GUID_WICPixelFormatDontCare;
+}
+
+/**
+* アルファを持つWICフォーマットから、対応する乗算済みアルファのWICフォーマットを得る.
+*
+* @param wicFormat WICフォーマットのGUID.
+*
+* @return wicFormatに対応する乗算済みアルファのWICフォーマット.
+*         wicFormatがアルファを持たないか、既に乗算済みの場合はGUID_WICPixelFormatDontCareを返す.
+*/
+WICPixelFormatGUID GetPremultipliedWICFormat(const WICPixelFormatGUID& wicFormat)
+{
+	static const struct {
+		WICPixelFormatGUID guid, premultiplied;
+	} guidToPremultipliedList[] = {
+		{ GUID_WICPixelFormat32bppRGBA, GUID_WICPixelFormat32bppPRGBA },
+		{ GUID_WICPixelFormat32bppBGRA, GUID_WICPixelFormat32bppPBGRA },
+		{ GUID_WICPixelFormat64bppRGBA, GUID_WICPixelFormat64bppPRGBA },
+		{ GUID_WICPixelFormat64bppRGBAHalf, GUID_WICPixelFormat64bppPRGBAHalf },
+		{ GUID_WICPixelFormat128bppRGBAFloat, GUID_WICPixelFormat128bppPRGBAFloat },
+	};
+	for (auto e : guidToPremultipliedList) {
+		if (e.guid == wicFormat) {
+			return e.premultiplied;
+		}
+	}
+	return GUID_WICPixelFormatDontCare;
+}
+
+/**
+* DXGIフォーマットから1ピクセルのバイト数を得る.
+*
+* @param dxgiFormat DXGIフォーマット.
+*
+* @return dxgiFormatに対応するビット数.
+*/
+int GetDXGIFormatBitesPerPixel(DXGI_FORMAT dxgiFormat)
+{
+	switch (dxgiFormat) {
+	case DXGI_FORMAT_R32G32B32A32_FLOAT: return 16;
+	case DXGI_FORMAT_R16G16B16A16_FLOAT: return 8;
+	case DXGI_FORMAT_R16G16B16A16_UNORM: return 8;
+	case DXGI_FORMAT_R8G8B8A8_UNORM: return 4;
+	case DXGI_FORMAT_B8G8R8A8_UNORM: return 4;
+	case DXGI_FORMAT_B8G8R8X8_UNORM: return 4;
+	case DXGI_FORMAT_R10G10B10_XR_BIAS_A2_UNORM: return 4;
+	case DXGI_FORMAT_R10G10B10A2_UNORM: return 4;
+	case DXGI_FORMAT_B5G5R5A1_UNORM: return 2;
+	case DXGI_FORMAT_B5G6R5_UNORM: return 2;
+	case DXGI_FORMAT_R32_FLOAT: return 4;
+	case DXGI_FORMAT_R16_FLOAT: return 2;
+	case DXGI_FORMAT_R16_UNORM: return 2;
+	case DXGI_FORMAT_R8_UNORM: return 1;
+	case DXGI_FORMAT_A8_UNORM: return 1;
+	default: return 1;
+	}
+}
+
+/**
+* リソース読み込みを開始する.
+*
+* @param heap      テクスチャ用のSRVデスクリプタを作成するデスクリプタヒープ.
+* @param buffer    データ転送に使うアップロードバッファ.
+* @param resHeap   テクスチャを配置するヒープ.
+* @param queue     データ転送に使うコピーキュー.
+*
+* @retval true  初期化成功.
+* @retval false 初期化失敗.
+*/
+bool ResourceLoader::Begin(DescriptorHeap& heap, UploadBuffer& buffer, ResourceHeap& resHeap, CopyQueue& queue)
+{
+	descriptorHeap = &heap;
+	uploadBuffer = &buffer;
+	resourceHeap = &resHeap;
+	copyQueue = &queue;
+	device = heap.GetDevice();
+	if (FAILED(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&commandAllocator)))) {
+		return false;
+	}
+	if (FAILED(device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, commandAllocator.Get(), nullptr, IID_PPV_ARGS(&commandList)))) {
+		return false;
+	}
+
+	if (FAILED(CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&imagingFactory)))) {
+		return false;
+	}
+	return true;
+}
+
+/**
+* リソース読み込みを終了し、データ転送を開始する.
+*
+* @param fenceValue 転送完了を示すフェンス値を格納する変数.
+*                   途中で実行したコマンドリストの転送も、このフェンス値までに完了する.
+*
+* @retval true  転送開始成功.
+* @retval false 転送開始失敗.
+*/
+bool ResourceLoader::Execute(UINT64& fenceValue)
+{
+	return Submit(fenceValue);
+}
+
+/**
+* ここまでに積んだ転送コマンドをコピーキューで実行し、アップロードバッファの領域の使用完了を示すフェンスを積む.
+*
+* @param fenceValue 転送完了を示すフェンス値を格納する変数.
+*
+* @retval true  成功.
+* @retval false 失敗.
+*/
+bool ResourceLoader::Submit(UINT64& fenceValue)
+{
+	if (FAILED(commandList->Close())) {
+		return false;
+	}
+	if (!copyQueue->Submit(commandList.Get(), fenceValue)) {
+		return false;
+	}
+	return uploadBuffer->Signal(copyQueue->Get());
+}
+
+/**
+* 転送元データを書き込むアップロードバッファの領域を確保する.
+*
+* 複数の領域は1つの連続した領域から切り出すため、どれかの転送コマンドを積む前に全てを確保しても、
+* 確保の途中で転送前の領域が再利用されることはない.
+* アップロードバッファがまだ転送していないデータで一杯の場合は、それまでに積んだ転送コマンドを実行し、
+* その完了を待ってから確保する. そのため、確保済みの全ての領域について転送コマンドを積んでから呼び出すこと.
+*
+* @param descList   転送先リソースの詳細情報の配列.
+* @param regionList 確保した領域の情報を格納する配列.
+* @param count      確保する領域の数.
+*
+* @retval true  確保成功.
+* @retval false 確保失敗.
+*/
+bool ResourceLoader::AllocateUploadRegions(const D3D12_RESOURCE_DESC* descList, UploadRegion* regionList, size_t count)
+{
+	UINT64 totalSize = 0;
+	for (size_t i = 0; i < count; ++i) {
+		UINT64 heapSize;
+		device->GetCopyableFootprints(&descList[i], 0, 1, 0, &regionList[i].layout, &regionList[i].numRows, &regionList[i].rowSize, &heapSize);
+		regionList[i].layout.Offset = totalSize;
+		totalSize = (totalSize + heapSize + D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1) & ~static_cast<UINT64>(D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT - 1);
+	}
+	UploadBuffer::Allocation allocation;
+	if (!uploadBuffer->Allocate(totalSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT, allocation)) {
+		if (!uploadBuffer->HasUnsignaledRange()) {
+			return false;
+		}
+		// 未転送のデータで一杯なので、ここまでの転送を実行してから確保し直す.
+		UINT64 fenceValue;
+		if (!Submit(fenceValue)) {
+			return false;
+		}
+		if (FAILED(commandList->Reset(commandAllocator.Get(), nullptr))) {
+			return false;
+		}
+		if (!uploadBuffer->Allocate(totalSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT, allocation)) {
+			return false;
+		}
+	}
+	for (size_t i = 0; i < count; ++i) {
+		const UINT64 offset = regionList[i].layout.Offset;
+		regionList[i].buffer.resource = allocation.resource;
+		regionList[i].buffer.offset = allocation.offset + offset;
+		regionList[i].buffer.cpuAddress = allocation.cpuAddress + offset;
+		regionList[i].layout.Offset = regionList[i].buffer.offset;
+	}
+	return true;
+}
+
+/**
+* 確保済みのアップロードバッファの領域に転送元データを書き込む.
+*
+* @param data   転送元データ.
+* @param region AllocateUploadRegionsで確保した領域.
+*/
+void ResourceLoader::WriteSubresource(const D3D12_SUBRESOURCE_DATA& data, const UploadRegion& region)
+{
+	const D3D12_MEMCPY_DEST dest = { region.buffer.cpuAddress, region.layout.Footprint.RowPitch, region.layout.Footprint.RowPitch * region.numRows };
+	MemcpySubresource(&dest, &data, static_cast<SIZE_T>(region.rowSize), region.numRows, region.layout.Footprint.Depth);
+}
+
+/**
+* アップロードバッファの領域を確保し、転送元データを書き込む.
+*
+* @param desc   転送先リソースの詳細情報.
+* @param data   転送元データ.
+* @param region 確保した領域の情報を格納するオブジェクト.
+*
+* @retval true  書き込み成功.
+* @retval false 書き込み失敗.
+*/
+bool ResourceLoader::WriteUploadRegion(const D3D12_RESOURCE_DESC& desc, const D3D12_SUBRESOURCE_DATA& data, UploadRegion& region)
+{
+	if (!AllocateUploadRegion(desc, region)) {
+		return false;
+	}
+	WriteSubresource(data, region);
+	return true;
+}
+
+/**
+* 転送先リソースを作成し、アップロードバッファの領域からの転送コマンドを積む.
+*
+* 転送先リソースはResourceHeapに配置され、その配置情報がallocationに格納される.
+* 転送先リソースは共通状態で作成され、コピーによってコピー先状態へ暗黙に昇格し、転送完了後に共通状態へ戻る.
+*
+* @param defaultHeap 作成したリソースを格納するオブジェクト.
+* @param allocation  作成したリソースの配置情報を格納するオブジェクト.
+* @param desc        転送先リソースの詳細情報.
+* @param region      転送元データを書き込んだ領域.
+* @param name        リソースに付ける名前(デバッグ用). nullptrを渡すと名前を付けない.
+*
+* @retval true  成功.
+* @retval false 失敗.
+*/
+bool ResourceLoader::CopyFromUploadRegion(ComPtr<ID3D12Resource>& defaultHeap, ResourceHeap::Allocation& allocation, const D3D12_RESOURCE_DESC& desc, const UploadRegion& region, const wchar_t* name)
+{
+	if (!resourceHeap->CreateResource(desc, D3D12_RESOURCE_STATE_COMMON, nullptr, defaultHeap, allocation)) {
+		return false;
+	}
+	if (name) {
+		defaultHeap->SetName(name);
+	}
+	RecordCopy(defaultHeap.Get(), desc, region);
+	return true;
+}
+
+/**
+* アップロードバッファの領域から転送先リソースへの転送コマンドを積む.
+*
+* 転送コマンドを積んだ後は、転送が完了するまで転送先リソースを解放してはならない.
+* そのため、失敗する可能性のある処理は全てこの関数より前に済ませておくこと.
+*
+* @param defaultHeap 転送先リソース.
+* @param desc        転送先リソースの詳細情報.
+* @param region      転送元データを書き込んだ領域.
+*/
+void ResourceLoader::RecordCopy(ID3D12Resource* defaultHeap, const D3D12_RESOURCE_DESC& desc, const UploadRegion& region)
+{
+	if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER) {
+		commandList->CopyBufferRegion(defaultHeap, 0, region.buffer.resource, region.buffer.offset, region.layout.Footprint.Width);
+	} else {
+		const CD3DX12_TEXTURE_COPY_LOCATION dst(defaultHeap, 0);
+		const CD3DX12_TEXTURE_COPY_LOCATION src(region.buffer.resource, region.layout);
+		commandList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+	}
+}
+
+/*
+* データをデフォルトヒープに転送する.
+*
+* 転送元データはアップロードバッファにコピーされるため、この関数から戻った後はdataを破棄してよい.
+* 転送先リソースはResourceHeapに配置され、その配置情報がallocationに格納される.
+*/
+bool ResourceLoader::Upload(Microsoft::WRL::ComPtr<ID3D12Resource>& defaultHeap, ResourceHeap::Allocation& allocation, const D3D12_RESOURCE_DESC& desc, D3D12_SUBRESOURCE_DATA data, const wchar_t* name)
+{
+	UploadRegion region;
+	if (!WriteUploadRegion(desc, data, region)) {
+		return false;
+	}
+	return CopyFromUploadRegion(defaultHeap, allocation, desc, region, name);
+}
+
+/**
+* 転送先リソースをテクスチャとして設定する.
+*
+* @param texture    設定するテクスチャ.
+* @param descriptor テクスチャ用のSRVデスクリプタ.
+* @param resource   テクスチャリソース.
+* @param allocation resourceの配置情報.
+*/
+void ResourceLoader::SetTexture(Texture& texture, const DescriptorHandle& descriptor, const ComPtr<ID3D12Resource>& resource, const ResourceHeap::Allocation& allocation)
+{
+	device->CreateShaderResourceView(resource.Get(), nullptr, descriptorHeap->GetCPUHandle(descriptor));
+
+	texture.resource = resource;
+	texture.format = resource->GetDesc().Format;
+	texture.handle = descriptorHeap->GetGPUHandle(descriptor);
+	texture.heap = descriptorHeap->GetHeap(descriptor);
+	texture.descriptor = descriptor;
+	texture.allocation = allocation;
+}
+
+/**
+* バイト列からテクスチャを作成する.
+*
+* @param texture  作成したテクスチャを管理するオブジェクト.
+* @param descriptor 作成したテクスチャ用のSRVデスクリプタ.
+* @param desc     テクスチャの詳細情報.
+* @param data     テクスチャ作成に使用するバイト列へのポインタ.
+* @param name     テクスチャリソースに付ける名前(デバッグ用). nullptrを渡すと名前を付けない.
+*
+* @retval true  作成成功.
+* @retval false 作成失敗.
+*/
+bool ResourceLoader::Create(Texture& texture, const DescriptorHandle& descriptor, const D3D12_RESOURCE_DESC& desc, const void* data, const wchar_t* name)
+{
+	if (!descriptorHeap->IsValid(descriptor)) {
+		return false;
+	}
+	ComPtr<ID3D12Resource> textureBuffer;
+	const int bytesPerRow = static_cast<int>(desc.Width * GetDXGIFormatBitesPerPixel(desc.Format));
+	D3D12_SUBRESOURCE_DATA subresource = { data, bytesPerRow, static_cast<LONG_PTR>(bytesPerRow * desc.Height) };
+	ResourceHeap::Allocation allocation;
+	if (!Upload(textureBuffer, allocation, desc, subresource, name)) {
+		return false;
+	}
+	SetTexture(texture, descriptor, textureBuffer, allocation);
+	return true;
+}
+
+/**
+* 画像からテクスチャを作成する.
+*
+* 画像はアップロードバッファの領域に直接デコードされる.
+*
+* @param texture    作成したテクスチャを管理するオブジェクト.
+* @param descriptor 作成したテクスチャ用のSRVデスクリプタ.
+* @param image      OpenImageFileまたはCreateReducedImageで作成した画像.
+* @param name       テクスチャリソースに付ける名前(デバッグ用). nullptrを渡すと名前を付けない.
+*
+* @retval true  作成成功.
+* @retval false 作成失敗.
+*/
+bool ResourceLoader::CreateFromImage(Texture& texture, const DescriptorHandle& descriptor, const Image& image, const wchar_t* name)
+{
+	if (!descriptorHeap->IsValid(descriptor)) {
+		return false;
+	}
+	const D3D12_RESOURCE_DESC desc = image.GetDesc();
+	UploadRegion region;
+	if (!AllocateUploadRegion(desc, region)) {
+		return false;
+	}
+	// GetCopyableFootprintsの行ピッチで、アップロードバッファに直接書き込む.
+	const UINT rowPitch = region.layout.Footprint.RowPitch;
+	const UINT bufferSize = static_cast<UINT>(rowPitch * (region.numRows - 1) + region.rowSize);
+	if (FAILED(image.source->CopyPixels(nullptr, rowPitch, bufferSize, region.buffer.cpuAddress))) {
+		return false;
+	}
+	ComPtr<ID3D12Resource> textureBuffer;
+	ResourceHeap::Allocation allocation;
+	if (!CopyFromUploadRegion(textureBuffer, allocation, desc, region, name)) {
+		return false;
+	}
+	SetTexture(texture, descriptor, textureBuffer, allocation);
+	return true;
+}
+
+/**
+* ファイルからテクスチャを読み込む.
+*
+* @param texture   読み込んだテクスチャを管理するオブジェクト.
+* @param descriptor 読み込んだテクスチャ用のSRVデスクリプタ.
+* @param filename  テクスチャファイル名.
+*
+* @retval true  読み込み成功.
+* @retval false 読み込み失敗.
+*/
+bool ResourceLoader::LoadFromFile(Texture& texture, const DescriptorHandle& descriptor, const wchar_t* filename)
+{
+	Image image;
+	if (!OpenImageFile(image, filename)) {
+		return false;
+	}
+	return CreateFromImage(texture, descriptor, image, filename);
+}
+
+/**
+* 画像ファイルを開き、DXGIフォーマットのピクセルデータを取り出せるようにする.
+*
+* ピクセルデータのデコードは、CreateFromImageでアップロードバッファに書き込むときに行われる.
+* アルファを持つ画像は、デコード時に乗算済みアルファに変換される.
+* 乗算済みアルファでは透明なピクセルの色が0になるため、縁の補間で周囲の色がにじむことはない.
+*
+* @param image    開いた画像を格納するオブジェクト.
+* @param filename 画像ファイル名.
+*
+* @retval true  成功.
+* @retval false 失敗.
+*/
+bool ResourceLoader::OpenImageFile(Image& image, const wchar_t* filename)
+{
+	ComPtr<IWICBitmapDecoder> decoder;
+	if (FAILED(imagingFactory->CreateDecoderFromFilename(filename, nullptr, GENERIC_READ, WICDecodeMetadataCacheOnLoad, decoder.GetAddressOf()))) {
+		return false;
+	}
+	ComPtr<IWICBitmapFrameDecode> frame;
+	if (FAILED(decoder->GetFrame(0, frame.GetAddressOf()))) {
+		return false;
+	}
+	WICPixelFormatGUID wicFormat;
+	if (FAILED(frame->GetPixelFormat(&wicFormat))) {
+		return false;
+	}
+	UINT width, height;
+	if (FAILED(frame->GetSize(&width, &height))) {
+		return false;
+	}
+	image.source = frame;
+	image.wicFormat = wicFormat;
+	image.width = width;
+	image.height = height;
+	image.format = GetDXGIFormatFromWICFormat(wicFormat);
+	WICPixelFormatGUID targetFormat = wicFormat;
+	if (image.format == DXGI_FORMAT_UNKNOWN) {
+		targetFormat = GetDXGICompatibleWICFormat(wicFormat);
+		if (targetFormat == GUID_WICPixelFormatDontCare) {
+			return false;
+		}
+	}
+	const WICPixelFormatGUID premultipliedFormat = GetPremultipliedWICFormat(targetFormat);
+	if (premultipliedFormat != GUID_WICPixelFormatDontCare) {
+		targetFormat = premultipliedFormat;
+	}
+	if (targetFormat != wicFormat) {
+		return ConvertImage(image, targetFormat);
+	}
+	return true;
+}
+
+/**
+* 画像のピクセルフォーマットを変換する.
+*
+* @param image     変換する画像.
+* @param wicFormat 変換後のWICピクセルフォーマット.
+*
+* @retval true  変換成功.
+* @retval false 変換失敗.
+*/
+bool ResourceLoader::ConvertImage(Image& image, const WICPixelFormatGUID& wicFormat)
+{
+	ComPtr<IWICFormatConverter> converter;
+	if (FAILED(imagingFactory->CreateFormatConverter(converter.GetAddressOf()))) {
+		return false;
+	}
+	BOOL canConvert = FALSE;
+	if (FAILED(converter->CanConvert(image.wicFormat, wicFormat, &canConvert))) {
+		return false;
+	}
+	if (!canConvert) {
+		return false;
+	}
+	if (FAILED(converter->Initialize(image.source.Get(), wicFormat, WICBitmapDitherTypeNone, nullptr, 0, WICBitmapPaletteTypeCustom))) {
+		return false;
+	}
+	image.source = converter;
+	image.wicFormat = wicFormat;
+	image.format = GetDXGIFormatFromWICFormat(wicFormat);
+	return true;
+}
+
+/**
+* 縮小画像を作成する.
+*
+* 縦横を半分にする処理を、長辺がmaxSize以下になるまで繰り返した大きさに縮小する.
+* 縮小はデコード時にWICのスケーラーで行われるため、元画像のピクセルデータを保持する必要はない.
+*
+* @param src     元の画像.
+* @param dst     縮小画像を格納するオブジェクト.
+* @param maxSize 縮小画像の長辺の最大ピクセル数.
+*
+* @retval true  作成成功.
+* @retval false 作成失敗.
+*/
+bool ResourceLoader::CreateReducedImage(const Image& src, Image& dst, UINT maxSize)
+{
+	UINT w = src.width;
+	UINT h = src.height;
+	while (w > maxSize || h > maxSize) {
+		w = w > 1 ? w / 2 : 1;
+		h = h > 1 ? h / 2 : 1;
+	}
+	ComPtr<IWICBitmapScaler> scaler;
+	if (FAILED(imagingFactory->CreateBitmapScaler(scaler.GetAddressOf()))) {
+		return false;
+	}
+	if (FAILED(scaler->Initialize(src.source.Get(), w, h, WICBitmapInterpolationModeFant))) {
+		return false;
+	}
+	WICPixelFormatGUID wicFormat;
+	if (FAILED(scaler->GetPixelFormat(&wicFormat))) {
+		return false;
+	}
+	dst.source = scaler;
+	dst.wicFormat = wicFormat;
+	dst.width = w;
+	dst.height = h;
+	dst.format = GetDXGIFormatFromWICFormat(wicFormat);
+	// スケーラーの出力フォーマットが元画像と異なる場合は元のフォーマットに戻す.
+	if (wicFormat != src.wicFormat) {
+		return ConvertImage(dst, src.wicFormat);
+	}
+	return true;
+}
+
+/**
+* 画像をデコードし、パレット画像に変換する.
+*
+* @param image        OpenImageFileで開いた画像.
+* @param indexedImage 変換したパレット画像を格納するオブジェクト.
+*
+* @retval true  変換成功.
+* @retval false 変換失敗.
+*/
+bool ResourceLoader::DecodeIndexedImage(const Image& image, Palette::IndexedImage& indexedImage)
+{
+	// 量子化は乗算済みアルファの8ビットRGBAで行う.
+	Image rgbaImage = image;
+	if (rgbaImage.wicFormat != GUID_WICPixelFormat32bppPRGBA) {
+		if (!ConvertImage(rgbaImage, GUID_WICPixelFormat32bppPRGBA)) {
+			return false;
+		}
+	}
+	const UINT rowPitch = rgbaImage.width * 4;
+	std::vector<uint8_t> pixels(static_cast<size_t>(rowPitch) * rgbaImage.height);
+	if (FAILED(rgbaImage.source->CopyPixels(nullptr, rowPitch, static_cast<UINT>(pixels.size()), pixels.data()))) {
+		return false;
+	}
+	return Palette::Quantize(pixels.data(), rowPitch, rgbaImage.width, rgbaImage.height, indexedImage);
+}
+
+/**
+* パレット画像からテクスチャを作成する.
+*
+* インデックステクスチャと、全ての種類のパレットを1行ずつ並べたパレットテクスチャを作成する.
+* 2つのリソースの作成が両方とも成功してから転送コマンドを積むため、
+* 片方の作成に失敗しても、転送中のリソースを解放してしまうことはない.
+*
+* @param texture      作成したテクスチャを管理するオブジェクト.
+* @param descriptor   作成したテクスチャ用のSRVデスクリプタ. 2つ以上のデスクリプタを含むこと.
+* @param indexedImage パレット画像.
+* @param name         テクスチャリソースに付ける名前(デバッグ用). nullptrを渡すと名前を付けない.
+*
+* @retval true  作成成功.
+* @retval false 作成失敗.
+*/
+bool ResourceLoader::CreateIndexed(Texture& texture, const DescriptorHandle& descriptor, const Palette::IndexedImage& indexedImage, const wchar_t* name)
+{
+	if (!descriptorHeap->IsValid(descriptor) || descriptor.count < 2) {
+		return false;
+	}
+	uint32_t paletteList[Palette::countof_Variant][Palette::maxColorCount];
+	for (int i = 0; i < Palette::countof_Variant; ++i) {
+		Palette::CreateVariant(indexedImage.colorList, paletteList[i], Palette::maxColorCount, static_cast<Palette::Variant>(i));
+	}
+	const D3D12_RESOURCE_DESC descList[2] = {
+		CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_R8_UINT, indexedImage.width, indexedImage.height, 1, 1),
+		CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_R8G8B8A8_UNORM, Palette::maxColorCount, Palette::countof_Variant, 1, 1),
+	};
+	const D3D12_RESOURCE_DESC& indexDesc = descList[0];
+	const D3D12_RESOURCE_DESC& paletteDesc = descList[1];
+	// 2つの転送コマンドを積む前に両方の領域が必要なので、まとめて確保する.
+	UploadRegion regionList[2];
+	if (!AllocateUploadRegions(descList, regionList, 2)) {
+		return false;
+	}
+	const UploadRegion& indexRegion = regionList[0];
+	const UploadRegion& paletteRegion = regionList[1];
+	const LONG_PTR indexRowPitch = static_cast<LONG_PTR>(indexedImage.width);
+	const D3D12_SUBRESOURCE_DATA indexData = { indexedImage.indexList.data(), indexRowPitch, indexRowPitch * indexedImage.height };
+	WriteSubresource(indexData, indexRegion);
+	const D3D12_SUBRESOURCE_DATA paletteData = { paletteList, sizeof(paletteList[0]), sizeof(paletteList) };
+	WriteSubresource(paletteData, paletteRegion);
+
+	// どちらのリソースにもまだ転送コマンドを積んでいないので、失敗したらすぐに解放してよい.
+	ComPtr<ID3D12Resource> indexBuffer;
+	ResourceHeap::Allocation indexAllocation;
+	if (!resourceHeap->CreateResource(indexDesc, D3D12_RESOURCE_STATE_COMMON, nullptr, indexBuffer, indexAllocation)) {
+		return false;
+	}
+	ComPtr<ID3D12Resource> paletteBuffer;
+	ResourceHeap::Allocation paletteAllocation;
+	if (!resourceHeap->CreateResource(paletteDesc, D3D12_RESOURCE_STATE_COMMON, nullptr, paletteBuffer, paletteAllocation)) {
+		resourceHeap->Free(indexAllocation);
+		return false;
+	}
+	if (name) {
+		indexBuffer->SetName(name);
+	}
+	RecordCopy(indexBuffer.Get(), indexDesc, indexRegion);
+	RecordCopy(paletteBuffer.Get(), paletteDesc, paletteRegion);
+
+	SetTexture(texture, descriptor, indexBuffer, indexAllocation);
+	device->CreateShaderResourceView(paletteBuffer.Get(), nullptr, descriptorHeap->GetCPUHandle(descriptor, 1));
+	texture.paletteResource = paletteBuffer;
+	texture.paletteAllocation = paletteAllocation;
+	return true;
+}
+
+/**
+* ファイルからパレット画像テクスチャを読み込む.
+*
+* @param texture    読み込んだテクスチャを管理するオブジェクト.
+* @param descriptor 読み込んだテクスチャ用のSRVデスクリプタ. 2つ以上のデスクリプタを含むこと.
+* @param filename   テクスチャファイル名.
+*
+* @retval true  読み込み成功.
+* @retval false 読み込み失敗.
+*/
+bool ResourceLoader::LoadIndexedFromFile(Texture& texture, const DescriptorHandle& descriptor, const wchar_t* filename)
+{
+	Image image;
+	if (!OpenImageFile(image, filename)) {
+		return false;
+	}
+	Palette::IndexedImage indexedImage;
+	if (!DecodeIndexedImage(image, indexedImage)) {
+		return false;
+	}
+	return CreateIndexed(texture, descriptor, indexedImage, filename);
+}
+
+/**
+* 画像の詳細情報を取得する.
+*
+* @return 画像と同じ大きさとフォーマットを持つテクスチャの詳細情報.
+*/
+D3D12_RESOURCE_DESC ResourceLoader::Image::GetDesc() const
+{
+	return CD3DX12_RESOURCE_DESC::Tex2D(format, width, height, 1, 1);
+}
+
+/**
+* 画像ファイルからアルファ値だけを読み込む.
+*
+* スプライトの形状の作成など、CPUでアルファ値を調べるために使う.
+* 乗算済みアルファへの変換はアルファ値を変えないため、テクスチャと同じ値が得られる.
+*
+* @param filename 画像ファイル名.
+* @param alpha    アルファ値を格納する配列. 1ピクセル1バイトで、1行はwidthバイト.
+* @param width    画像の幅を格納する変数.
+* @param height   画像の高さを格納する変数.
+*
+* @retval true  読み込み成功.
+* @retval false 読み込み失敗.
+*/
+bool LoadAlphaMap(const wchar_t* filename, std::vector<uint8_t>& alpha, UINT& width, UINT& height)
+{
+	ComPtr<IWICImagingFactory> imagingFactory;
+	if (FAILED(CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&imagingFactory)))) {
+		return false;
+	}
+	ComPtr<IWICBitmapDecoder> decoder;
+	if (FAILED(imagingFactory->CreateDecoderFromFilename(filename, nullptr, GENERIC_READ, WICDecodeMetadataCacheOnLoad, decoder.GetAddressOf()))) {
+		return false;
+	}
+	ComPtr<IWICBitmapFrameDecode> frame;
+	if (FAILED(decoder->GetFrame(0, frame.GetAddressOf()))) {
+		return false;
+	}
+	ComPtr<IWICFormatConverter> converter;
+	if (FAILED(imagingFactory->CreateFormatConverter(converter.GetAddressOf()))) {
+		return false;
+	}
+	if (FAILED(converter->Initialize(frame.Get(), GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0, WICBitmapPaletteTypeCustom))) {
+		return false;
+	}
+	if (FAILED(converter->GetSize(&width, &height))) {
+		return false;
+	}
+	const UINT rowPitch = width * 4;
+	std::vector<uint8_t> pixels(static_cast<size_t>(rowPitch) * height);
+	if (FAILED(converter->CopyPixels(nullptr, rowPitch, static_cast<UINT>(pixels.size()), pixels.data()))) {
+		return false;
+	}
+	alpha.resize(static_cast<size_t>(width) * height);
+	for (size_t i = 0; i < alpha.size(); ++i) {
+		alpha[i] = pixels[i * 4 + 3];
+	}
+	return true;
+}
+
+/**
+* デストラクタ.
+*
+* まだ参照されているテクスチャは管理元から切り離され、最後の参照が消えた時点で破棄される.
+*/
+TextureMap::~TextureMap()
+{
+	for (auto& e : map) {
+		if (e.second->refCount > 0) {
+			e.second->owner = nullptr;
+			e.second.release();
+		}
+	}
+}
+
+/**
+* 初期化する.
+*
+* @param heap            テクスチャ用のCSUデスクリプタ取得先のデスクリプタヒープ.
+* @param buffer          データ転送に使うアップロードバッファ.
+* @param resHeap         テクスチャを配置するヒープ.
+* @param queue           データ転送に使うコピーキュー.
+* @param frameFence      描画キューが毎フレームの終わりにSignalするフェンス.
+* @param frameFenceValue 現在のフレームの終わりにframeFenceへ積まれる値.
+*
+* @retval true  初期化成功.
+* @retval false 初期化失敗.
+*/
+bool TextureMap::Init(DescriptorHeap& heap, UploadBuffer& buffer, ResourceHeap& resHeap, CopyQueue& queue, ComPtr<ID3D12Fence> frameFence, UINT64 frameFenceValue)
+{
+	descriptorHeap = &heap;
+	uploadBuffer = &buffer;
+	resourceHeap = &resHeap;
+	copyQueue = &queue;
+	fence = frameFence;
+	fenceValue = frameFenceValue;
+	return true;
+}
+
+/**
+* リソース読み込みを開始する.
+*
+* @retval true  初期化成功.
+* @retval false 初期化失敗.
+*/
+bool TextureMap::Begin()
+{
+	loadingList.clear();
+	loader.reset(new ResourceLoader);
+	return loader->Begin(*descriptorHeap, *uploadBuffer, *resourceHeap, *copyQueue);
+}
+
+/**
+* リソース読み込みを終了し、コピーキューで転送を開始する.
+*
+* 転送の完了は待たない. ローダーは転送完了後のCollectで破棄される.
+*
+* @retval true  転送開始成功.
+* @retval false 転送開始失敗.
+*/
+bool TextureMap::End()
+{
+	StreamBatch batch;
+	if (!loader->Execute(batch.fenceValue)) {
+		return false;
+	}
+	for (TextureEntry* e : loadingList) {
+		e->resident.readyFenceValue = batch.fenceValue;
+		e->placeholder.readyFenceValue = batch.fenceValue;
+	}
+	loadingList.clear();
+	batch.loader = std::move(loader);
+	streamBatchList.push_back(std::move(batch));
+	return true;
+}
+
+/**
+* 名前が一致するテクスチャを検索する.
+*
+* @param texture  戻り値がtrueの場合に、発見したテクスチャを格納するオブジェクト.
+* @param name     検索するテクスチャ名.
+*
+* @retval true  nameに一致するテクスチャを発見.
+* @retval false nameに一致するテクスチャを保持していない.
+*/
+bool TextureMap::Find(Texture& texture, const wchar_t* name)
+{
+	auto itr = map.find(name);
+	if (itr == map.end()) {
+		return false;
+	}
+	Acquire(texture, *itr->second);
+	return true;
+}
+
+/**
+* バイト列からテクスチャを作成する.
+*
+* 元データを保持しないため、作成したテクスチャは追い出されない.
+*
+* @param texture  作成したテクスチャを管理するオブジェクト.
+* @param name     テクスチャリソースに付ける名前.
+* @param desc     テクスチャの詳細情報.
+* @param data     テクスチャ作成に使用するバイト列へのポインタ.
+*
+* @retval true  作成成功.
+* @retval false 作成失敗.
+*/
+bool TextureMap::Create(Texture& texture, const wchar_t* name, const D3D12_RESOURCE_DESC& desc, const void* data)
+{
+	if (Find(texture, name)) {
+		return true;
+	}
+
+	const DescriptorHandle descriptor = descriptorHeap->Allocate();
+	if (descriptor.IsNull()) {
+		return false;
+	}
+	Texture newTexture;
+	if (loader->Create(newTexture, descriptor, desc, data, name)) {
+		Register(texture, name, newTexture, Texture());
+		return true;
+	}
+	descriptorHeap->Free(descriptor);
+	return false;
+}
+
+/**
+* ファイルからテクスチャを読み込む.
+*
+* 追い出された場合に表示する縮小版テクスチャも同時に作成する.
+*
+* @param texture   読み込んだテクスチャを管理するオブジェクト.
+* @param filename  テクスチャファイル名.
+*
+* @retval true  読み込み成功.
+* @retval false 読み込み失敗.
+*/
+bool TextureMap::LoadFromFile(Texture& texture, const wchar_t* filename)
+{
+	if (Find(texture, filename)) {
+		return true;
+	}
+
+	ResourceLoader::Image image;
+	if (!loader->OpenImageFile(image, filename)) {
+		return false;
+	}
+	const DescriptorHandle descriptor = descriptorHeap->Allocate();
+	if (descriptor.IsNull()) {
+		return false;
+	}
+	Texture newTexture;
+	if (!loader->CreateFromImage(newTexture, descriptor, image, filename)) {
+		descriptorHeap->Free(descriptor);
+		return false;
+	}
+
+	// 縮小版テクスチャを作成する. 作成できなくても、追い出されなくなるだけなので失敗扱いにはしない.
+	Texture placeholder;
+	ResourceLoader::Image reducedImage;
+	if (loader->CreateReducedImage(image, reducedImage, placeholderSize)) {
+		const DescriptorHandle reducedDescriptor = descriptorHeap->Allocate();
+		if (!reducedDescriptor.IsNull() && !loader->CreateFromImage(placeholder, reducedDescriptor, reducedImage)) {
+			descriptorHeap->Free(reducedDescriptor);
+		}
+	}
+	Register(texture, filename, newTexture, placeholder);
+	return true;
+}
+
+/**
+* ファイルからパレット画像テクスチャを読み込む.
+*
+* パレットを切り替えて色を変えるスプライト用. 縮小版は作らないため、読み込んだテクスチャは追い出されない.
+* 同じファイルをLoadFromFileで読み込んだテクスチャとは別のテクスチャとして管理される.
+*
+* @param texture   読み込んだテクスチャを管理するオブジェクト.
+* @param filename  テクスチャファイル名.
+*
+* @retval true  読み込み成功.
+* @retval false 読み込み失敗.
+*/
+bool TextureMap::LoadIndexedFromFile(Texture& texture, const wchar_t* filename)
+{
+	const std::wstring name = std::wstring(filename) + L"#indexed";
+	if (Find(texture, name.c_str())) {
+		return true;
+	}
+
+	const DescriptorHandle descriptor = descriptorHeap->Allocate(2);
+	if (descriptor.IsNull()) {
+		return false;
+	}
+	Texture newTexture;
+	if (!loader->LoadIndexedFromFile(newTexture, descriptor, filename)) {
+		descriptorHeap->Free(descriptor);
+		return false;
+	}
+	Register(texture, name.c_str(), newTexture, Texture());
+	return true;
+}
+
+/**
+* テクスチャを登録し、参照を取得する.
+*
+* @param texture     参照を格納するオブジェクト.
+* @param name        テクスチャ名.
+* @param source      登録するテクスチャ.
+* @param placeholder 追い出された場合に表示する縮小版テクスチャ. 空なら追い出さない.
+*/
+void TextureMap::Register(Texture& texture, const wchar_t* name, const Texture& source, const Texture& placeholder)
+{
+	std::unique_ptr<TextureEntry> p(new TextureEntry());
+	p->resident = source;
+	p->placeholder = placeholder;
+	p->owner = this;
+	p->state = TextureState::Resident;
+	p->size = GetAllocationSize(source);
+	p->lastUsedFenceValue = fenceValue;
+	const auto result = map.insert(std::make_pair(std::wstring(name), std::move(p)));
+	TextureEntry& entry = *result.first->second;
+	entry.name = &result.first->first;
+	if (entry.placeholder.resource) {
+		entry.lruItr = lruList.insert(lruList.begin(), &entry);
+	}
+	residentSize += entry.size;
+	loadingList.push_back(&entry);
+	Acquire(texture, entry);
+}
+
+/**
+* テクスチャの参照を取得する.
+*
+* 解放待ちのテクスチャだった場合、解放は取り消される.
+*
+* @param texture 参照を格納するオブジェクト.
+* @param entry   参照するテクスチャ.
+*/
+void TextureMap::Acquire(Texture& texture, TextureEntry& entry)
+{
+	texture = entry.Current();
+	texture.resource.Reset();
+	texture.paletteResource.Reset();
+	texture.entry = &entry;
+	++entry.refCount;
+}
+
+/**
+* 参照されなくなったテクスチャを解放待ちにする.
+*
+* まだGPUが使っている可能性があるため、次のEndFrameでフェンス値を割り当て、GPUが通過した後で破棄する.
+*
+* @param entry 参照カウントが0になったテクスチャ.
+*/
+void TextureMap::Release(TextureEntry& entry)
+{
+	++entry.releaseSerial;
+	pendingList.push_back({ 0, &entry, entry.releaseSerial });
+}
+
+/**
+* テクスチャが現在のフレームで使われたことを記録する.
+*
+* 追い出されていた場合は再読み込みを要求する.
+* 転送が完了していない場合は、描画キューが転送完了を待つように登録する.
+* 描画コマンドを記録する複数のスレッドから呼ばれるため、排他制御を行う.
+* ただし、現在のフレームで記録済みのテクスチャはロックせずに戻る. fenceValueはフレームの記録中には変わらない.
+*
+* @param entry 使われたテクスチャ.
+*/
+void TextureMap::MarkUsed(TextureEntry& entry)
+{
+	if (entry.lastUsedFenceValue.load(std::memory_order_relaxed) == fenceValue) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(markMutex);
+	if (entry.lastUsedFenceValue.load(std::memory_order_relaxed) == fenceValue) {
+		return;
+	}
+	entry.lastUsedFenceValue.store(fenceValue, std::memory_order_relaxed);
+	copyQueue->Require(entry.Current().readyFenceValue);
+	if (entry.state == TextureState::Resident) {
+		if (entry.placeholder.resource) {
+			lruList.splice(lruList.begin(), lruList, entry.lruItr);
+		}
+	} else if (entry.state == TextureState::Evicted) {
+		entry.state = TextureState::StreamRequested;
+		streamRequestList.push_back(&entry);
+	}
+}
+
+/**
+* テクスチャを追い出し、縮小版テクスチャに切り替える.
+*
+* GPUがテクスチャを使い終えてから呼び出すこと.
+*
+* @param entry 追い出すテクスチャ.
+*/
+void TextureMap::Evict(TextureEntry& entry)
+{
+	lruList.erase(entry.lruItr);
+	FreeTexture(entry.resident);
+	entry.state = TextureState::Evicted;
+	residentSize -= entry.size;
+}
+
+/**
+* テクスチャのデスクリプタと配置領域を解放する.
+*
+* GPUがテクスチャを使い終えてから呼び出すこと.
+*
+* @param texture 解放するテクスチャ. 解放後は空になる.
+*/
+void TextureMap::FreeTexture(Texture& texture)
+{
+	descriptorHeap->Free(texture.descriptor);
+	resourceHeap->Free(texture.allocation);
+	resourceHeap->Free(texture.paletteAllocation);
+	texture = Texture();
+}
+
+/**
+* テクスチャを破棄する.
+*
+* GPUがテクスチャを使い終えてから呼び出すこと.
+*
+* @param entry 破棄するテクスチャ.
+*/
+void TextureMap::Erase(TextureEntry& entry)
+{
+	switch (entry.state) {
+	case TextureState::Resident:
+		if (entry.placeholder.resource) {
+			lruList.erase(entry.lruItr);
+		}
+		FreeTexture(entry.resident);
+		residentSize -= entry.size;
+		break;
+	case TextureState::Evicted:
+		break;
+	case TextureState::StreamRequested:
+		streamRequestList.erase(std::find(streamRequestList.begin(), streamRequestList.end(), &entry));
+		break;
+	case TextureState::Streaming:
+		// 転送中のテクスチャは転送完了時に破棄する.
+		for (auto& batch : streamBatchList) {
+			for (auto& item : batch.itemList) {
+				if (item.entry == &entry) {
+					item.entry = nullptr;
+				}
+			}
+		}
+		break;
+	}
+	if (entry.placeholder.resource) {
+		FreeTexture(entry.placeholder);
+	}
+	map.erase(map.find(*entry.name));
+}
+
+/**
+* テクスチャの転送が完了しているか調べる.
+*
+* @param entry 調べるテクスチャ.
+*
+* @retval true  転送完了.
+* @retval false 転送中.
+*/
+bool TextureMap::IsCopyCompleted(const TextureEntry& entry) const
+{
+	return copyQueue->IsCompleted(entry.resident.readyFenceValue) && copyQueue->IsCompleted(entry.placeholder.readyFenceValue);
+}
+
+/**
+* テクスチャが使用するGPUメモリのバイト数を取得する.
+*
+* @param texture テクスチャ.
+*
+* @return textureが使用するバイト数.
+*/
+UINT64 TextureMap::GetAllocationSize(const Texture& texture) const
+{
+	const D3D12_RESOURCE_DESC desc = texture.resource->GetDesc();
+	UINT64 size = descriptorHeap->GetDevice()->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes;
+	if (texture.paletteResource) {
+		const D3D12_RESOURCE_DESC paletteDesc = texture.paletteResource->GetDesc();
+		size += descriptorHeap->GetDevice()->GetResourceAllocationInfo(0, 1, &paletteDesc).SizeInBytes;
+	}
+	return size;
+}
+
+/**
+* 再読み込みを要求されたテクスチャの読み込みを開始する.
+*
+* 1フレームで開始するのは最大maxStreamCountPerFrame個まで.
+* 読み込んだテクスチャはコピーキューで転送され、転送完了後のCollectで縮小版と入れ替わる.
+*
+* @retval true  成功.
+* @retval false 失敗.
+*/
+bool TextureMap::Stream()
+{
+	if (streamRequestList.empty()) {
+		return true;
+	}
+	StreamBatch batch;
+	batch.loader.reset(new ResourceLoader);
+	if (!batch.loader->Begin(*descriptorHeap, *uploadBuffer, *resourceHeap, *copyQueue)) {
+		return false;
+	}
+	const size_t count = streamRequestList.size() < maxStreamCountPerFrame ? streamRequestList.size() : maxStreamCountPerFrame;
+	for (size_t i = 0; i < count; ++i) {
+		TextureEntry& entry = *streamRequestList[i];
+		StreamItem item = { &entry, Texture() };
+		const DescriptorHandle descriptor = descriptorHeap->Allocate();
+		if (descriptor.IsNull()) {
+			entry.state = TextureState::Evicted;
+			continue;
+		}
+		if (!batch.loader->LoadFromFile(item.texture, descriptor, entry.name->c_str())) {
+			descriptorHeap->Free(descriptor);
+			entry.state = TextureState::Evicted;
+			continue;
+		}
+		entry.state = TextureState::Streaming;
+		residentSize += entry.size;
+		batch.itemList.push_back(item);
+	}
+	streamRequestList.erase(streamRequestList.begin(), streamRequestList.begin() + count);
+
+	if (!batch.loader->Execute(batch.fenceValue)) {
+		return false;
+	}
+	for (auto& item : batch.itemList) {
+		item.texture.readyFenceValue = batch.fenceValue;
+	}
+	streamBatchList.push_back(std::move(batch));
+	return true;
+}
+
+/**
+* 描画キューがフレームフェンスに積んだ値を記録する.
+*
+* 前回のEndFrame以降に解放待ちになったテクスチャは、この値をGPUが通過した後のCollectで破棄される.
+* 使われたテクスチャの記録にはMarkUsedの時点でこの値を使っているため、ここでは何もしない.
+* フェンスはGraphicsが毎フレーム積むので、TextureMapが描画キューにSignalすることはない.
+*
+* @param signaledValue フレームフェンスに積んだ値. Initまたは前回のEndFrameで予定した値と等しいこと.
+*                      次のフレームでは1大きい値が積まれるものとする.
+*/
+void TextureMap::EndFrame(UINT64 signaledValue)
+{
+	for (auto& e : pendingList) {
+		e.fenceValue = signaledValue;
+		releaseQueue.push_back(e);
+	}
+	pendingList.clear();
+	fenceValue = signaledValue + 1;
+}
+
+/**
+* GPUが使い終えたテクスチャを破棄し、転送が完了したテクスチャを入れ替える.
+*
+* 常駐サイズが予算を超えている場合、GPUが使い終えたテクスチャを古い順に追い出す.
+*/
+void TextureMap::Collect()
+{
+	if (releaseQueue.empty() && streamBatchList.empty() && residentSize <= budget) {
+		return;
+	}
+	const UINT64 completedValue = fence->GetCompletedValue();
+
+	while (!streamBatchList.empty() && copyQueue->IsCompleted(streamBatchList.front().fenceValue)) {
+		for (auto& item : streamBatchList.front().itemList) {
+			if (item.entry) {
+				TextureEntry& entry = *item.entry;
+				entry.resident = item.texture;
+				entry.state = TextureState::Resident;
+				entry.lruItr = lruList.insert(lruList.begin(), &entry);
+			} else {
+				residentSize -= GetAllocationSize(item.texture);
+				FreeTexture(item.texture);
+			}
+		}
+		streamBatchList.pop_front();
+	}
+
+	while (!releaseQueue.empty() && releaseQueue.front().fenceValue <= completedValue) {
+		const ReleaseItem item = releaseQueue.front();
+		// 再取得されたか、より新しい解放待ちがある場合は破棄しない.
+		if (item.entry->refCount > 0 || item.entry->releaseSerial != item.serial) {
+			releaseQueue.pop_front();
+			continue;
+		}
+		// 一度も描画されずに解放された場合、まだ転送中の可能性がある.
+		if (!IsCopyCompleted(*item.entry)) {
+			break;
+		}
+		releaseQueue.pop_front();
+		Erase(*item.entry);
+	}
+
+	while (residentSize > budget && !lruList.empty()) {
+		TextureEntry& entry = *lruList.back();
+		if (entry.lastUsedFenceValue > completedValue || !IsCopyCompleted(entry)) {
+			break;
+		}
+		Evict(entry);
+	}
+}
+
 } // namespace Resource
\ No newline at end of file
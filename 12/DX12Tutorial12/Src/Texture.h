@@ -1,98 +1,241 @@
-/**
-* @file Texture.h
-*/
-#ifndef DX12TUTORIAL_SRC_TEXTURE_H_
-#define DX12TUTORIAL_SRC_TEXTURE_H_
-#include <d3d12.h>
-#include <dxgiformat.h>
-#include <wrl/client.h>
-#include <wincodec.h>
-#include <vector>
-#include <string>
-#include <map>
-#include <memory>
-
-/**
-* \[XǗpO.
-*/
-namespace Resource
-{
-
-/**
-* eNX`ێNX.
-*/
-struct Texture
-{
-	Microsoft::WRL::ComPtr<ID3D12Resource> resource;
-	DXGI_FORMAT format;
-	D3D12_GPU_DESCRIPTOR_HANDLE handle;
-};
-
-/**
-* \[Xǂݍ݃NX.
-*
-* eNX`̍쐬Eǂݍ݂̎菇.
-* -# ResourceLoaderIuWFNg쐬.
-* -# BeginĂ.
-* -# Create, LoadFromFileŃeNX`쐬܂͓ǂݍ.
-* -# EndŃf[^]pR}hXg擾AR}hL[ɐςŎs.
-* -# ResourceLoaderIuWFNgj.
-*    f[^]pobt@͂̃^C~Oŉ.
-*/
-class ResourceLoader
-{
-public:
-	ResourceLoader() = default;
-	~ResourceLoader() = default;
-	bool Begin(Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> heap);
-	ID3D12GraphicsCommandList* End();
-	bool Upload(Microsoft::WRL::ComPtr<ID3D12Resource>& defaultHeap, const D3D12_RESOURCE_DESC& desc, D3D12_SUBRESOURCE_DATA data, D3D12_RESOURCE_STATES stateAfter, const wchar_t* name = nullptr);
-	bool Create(Texture& texture, int index, const D3D12_RESOURCE_DESC& desc, const void* data, const wchar_t* name = nullptr);
-	bool LoadFromFile(Texture& texture, int index, const wchar_t* filename);
-
-private:
-	Microsoft::WRL::ComPtr<ID3D12Device> device;
-	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> descriptorHeap;
-	Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
-	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList;
-	Microsoft::WRL::ComPtr<IWICImagingFactory> imagingFactory;
-	UINT descriptorSize;
-	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> uploadHeapList;
-};
-
-/**
-* eNX`ێNX.
-*
-* - w肳ꂽeNX`ǂݍ݁A󂫃fXNv^Ɋ蓖Ă.
-* - w肳ꂽeNX`ɑ݂ꍇÃeNX`Ԃ.
-*
-* ǂQƂȂȂeNX`j邽߁AIGC()Ăяo.
-*/
-class TextureMap
-{
-public:
-	TextureMap() = default;
-	TextureMap(const TextureMap&) = delete;
-	TextureMap& operator=(const TextureMap&) = delete;
-
-	void Init(Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> heap);
-	bool Begin();
-	ID3D12GraphicsCommandList* End();
-	bool Create(Texture& texture, const wchar_t* name, const D3D12_RESOURCE_DESC& desc, const void* data);
-	bool LoadFromFile(Texture& texture, const wchar_t* filename);
-	void ResetLoader() { loader.reset(); }
-	bool Find(Texture& texture, const wchar_t* filename);
-	void GC();
-
-private:
-	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> descriptorHeap;
-	UINT descriptorSize;
-	std::unique_ptr<ResourceLoader> loader;
-	std::vector<uint16_t> freeIDList;
-
-	std::map<std::wstring, Texture> map;
-};
-
-} // namespace Resource
-
+/**
+* @file Texture.h
+*/
+#ifndef DX12TUTORIAL_SRC_TEXTURE_H_
+#define DX12TUTORIAL_SRC_TEXTURE_H_
+#include "UploadBuffer.h"
+#include "DescriptorHeap.h"
+#include "ResourceHeap.h"
+#include "CopyQueue.h"
+#include "Palette.h"
+#include <d3d12.h>
+#include <dxgiformat.h>
+#include <wrl/client.h>
+#include <wincodec.h>
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <deque>
+#include <list>
+#include <mutex>
+
+/**
+* リソース管理用名前空間.
+*/
+namespace Resource
+{
+
+struct TextureEntry;
+
+/**
+* テクスチャを保持するクラス.
+*
+* TextureMapから取得したテクスチャは、TextureMapが管理する参照カウントを持つ.
+* 最後のTextureオブジェクトが破棄されると、テクスチャはTextureMapの解放待ちキューに積まれる.
+* TextureMapが管理するテクスチャはメモリ予算に応じて縮小版と入れ替わることがあるため、
+* 描画時はResolveで得たテクスチャを使うこと. また、resourceはTextureMapだけが保持する.
+*
+* パレット画像の場合、resourceはR8_UINTのインデックステクスチャで、paletteResourceにパレットを持つ.
+* descriptorはインデックス、パレットの順に並んだ2つのSRVを含む.
+*/
+struct Texture
+{
+	Texture() = default;
+	Texture(const Texture& other);
+	Texture& operator=(const Texture& other);
+	~Texture();
+
+	const Texture& Resolve() const;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+	DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+	D3D12_GPU_DESCRIPTOR_HANDLE handle = {};
+	ID3D12DescriptorHeap* heap = nullptr; ///< handleを含むデスクリプタヒープ.
+	DescriptorHandle descriptor = {}; ///< SRVデスクリプタの割り当て情報.
+	ResourceHeap::Allocation allocation; ///< resourceの配置情報.
+	UINT64 readyFenceValue = 0; ///< 転送完了を示すコピーキューのフェンス値.
+	Microsoft::WRL::ComPtr<ID3D12Resource> paletteResource; ///< パレットテクスチャ. パレット画像でなければ空.
+	ResourceHeap::Allocation paletteAllocation; ///< paletteResourceの配置情報.
+	TextureEntry* entry = nullptr; ///< TextureMapが管理する参照カウント情報. 管理外のテクスチャならnullptr.
+};
+
+/**
+* リソース読み込みクラス.
+*
+* テクスチャの作成・読み込みの手順.
+* -# ResourceLoaderオブジェクトを作成する.
+* -# Beginを呼ぶ.
+* -# Create, LoadFromFile, LoadIndexedFromFileでテクスチャを作成または読み込む.
+* -# Executeでデータ転送用コマンドリストをコピーキューに積んで実行し、転送完了を示すフェンス値を得る.
+*    データ転送に使ったアップロードバッファの領域は、転送完了後に再利用される.
+*    途中でアップロードバッファが未転送のデータで一杯になった場合は、それまでのコマンドリストを実行して転送の完了を待つ.
+* -# 転送が完了したらResourceLoaderオブジェクトを破棄する.
+*
+* 転送はコピーキューで行うため、リソースは共通状態のままになる.
+* 描画キューで使うときに、シェーダリソース状態へ暗黙に昇格する.
+*/
+class ResourceLoader
+{
+public:
+	/**
+	* 読み込み用に開いた画像.
+	*
+	* ピクセルデータはCreateFromImageでアップロードバッファに直接デコードされる.
+	*/
+	struct Image
+	{
+		Microsoft::WRL::ComPtr<IWICBitmapSource> source;
+		WICPixelFormatGUID wicFormat;
+		UINT width;
+		UINT height;
+		DXGI_FORMAT format;
+
+		D3D12_RESOURCE_DESC GetDesc() const;
+	};
+
+	ResourceLoader() = default;
+	~ResourceLoader() = default;
+	bool Begin(DescriptorHeap& heap, UploadBuffer& buffer, ResourceHeap& resourceHeap, CopyQueue& copyQueue);
+	bool Execute(UINT64& fenceValue);
+	bool Upload(Microsoft::WRL::ComPtr<ID3D12Resource>& defaultHeap, ResourceHeap::Allocation& allocation, const D3D12_RESOURCE_DESC& desc, D3D12_SUBRESOURCE_DATA data, const wchar_t* name = nullptr);
+	bool Create(Texture& texture, const DescriptorHandle& descriptor, const D3D12_RESOURCE_DESC& desc, const void* data, const wchar_t* name = nullptr);
+	bool CreateFromImage(Texture& texture, const DescriptorHandle& descriptor, const Image& image, const wchar_t* name = nullptr);
+	bool LoadFromFile(Texture& texture, const DescriptorHandle& descriptor, const wchar_t* filename);
+	bool OpenImageFile(Image& image, const wchar_t* filename);
+	bool CreateReducedImage(const Image& src, Image& dst, UINT maxSize);
+	bool DecodeIndexedImage(const Image& image, Palette::IndexedImage& indexedImage);
+	bool CreateIndexed(Texture& texture, const DescriptorHandle& descriptor, const Palette::IndexedImage& indexedImage, const wchar_t* name = nullptr);
+	bool LoadIndexedFromFile(Texture& texture, const DescriptorHandle& descriptor, const wchar_t* filename);
+
+private:
+	/// 転送元データを書き込むアップロードバッファの領域.
+	struct UploadRegion
+	{
+		UploadBuffer::Allocation buffer;
+		D3D12_PLACED_SUBRESOURCE_FOOTPRINT layout; ///< 行ピッチと、バッファ先頭からのオフセット.
+		UINT numRows;
+		UINT64 rowSize; ///< 1行の有効なバイト数.
+	};
+
+	bool Submit(UINT64& fenceValue);
+	bool AllocateUploadRegions(const D3D12_RESOURCE_DESC* descList, UploadRegion* regionList, size_t count);
+	bool AllocateUploadRegion(const D3D12_RESOURCE_DESC& desc, UploadRegion& region) { return AllocateUploadRegions(&desc, &region, 1); }
+	void WriteSubresource(const D3D12_SUBRESOURCE_DATA& data, const UploadRegion& region);
+	bool WriteUploadRegion(const D3D12_RESOURCE_DESC& desc, const D3D12_SUBRESOURCE_DATA& data, UploadRegion& region);
+	bool CopyFromUploadRegion(Microsoft::WRL::ComPtr<ID3D12Resource>& defaultHeap, ResourceHeap::Allocation& allocation, const D3D12_RESOURCE_DESC& desc, const UploadRegion& region, const wchar_t* name);
+	void RecordCopy(ID3D12Resource* defaultHeap, const D3D12_RESOURCE_DESC& desc, const UploadRegion& region);
+	void SetTexture(Texture& texture, const DescriptorHandle& descriptor, const Microsoft::WRL::ComPtr<ID3D12Resource>& resource, const ResourceHeap::Allocation& allocation);
+	bool ConvertImage(Image& image, const WICPixelFormatGUID& wicFormat);
+
+	Microsoft::WRL::ComPtr<ID3D12Device> device;
+	DescriptorHeap* descriptorHeap;
+	Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
+	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> commandList;
+	Microsoft::WRL::ComPtr<IWICImagingFactory> imagingFactory;
+	UploadBuffer* uploadBuffer;
+	ResourceHeap* resourceHeap;
+	CopyQueue* copyQueue;
+};
+
+bool LoadAlphaMap(const wchar_t* filename, std::vector<uint8_t>& alpha, UINT& width, UINT& height);
+
+/**
+* テクスチャを保持するクラス.
+*
+* - 指定されたテクスチャを読み込み、空きデスクリプタに割り当てる.
+* - 指定されたテクスチャが既に存在する場合、そのテクスチャを返す.
+* - どこからも参照されなくなったテクスチャは解放待ちキューに積まれる.
+*   EndFrameで解放待ちキューにフレームフェンスの値を割り当て、Collectを呼ぶと、GPUが通過した値までのテクスチャが破棄される.
+*   解放待ちのテクスチャがなければ、EndFrame, Collectはほとんど何もしない.
+* - ファイルから読み込んだテクスチャは、常駐サイズが予算を超えると、最も長く使われていないものから追い出される.
+*   追い出されたテクスチャは縮小版で表示され、次に使われたときにStreamで再読み込みされる.
+* - 転送はコピーキューで描画と並行して行われる. 転送が終わる前にテクスチャを描画に使うと、
+*   そのフレームの描画はCopyQueue::InsertWaitによってGPU上で転送完了を待つ.
+*/
+class TextureMap
+{
+public:
+	TextureMap() = default;
+	TextureMap(const TextureMap&) = delete;
+	TextureMap& operator=(const TextureMap&) = delete;
+	~TextureMap();
+
+	bool Init(DescriptorHeap& heap, UploadBuffer& buffer, ResourceHeap& resourceHeap, CopyQueue& copyQueue, Microsoft::WRL::ComPtr<ID3D12Fence> frameFence, UINT64 frameFenceValue);
+	bool Begin();
+	bool End();
+	bool Create(Texture& texture, const wchar_t* name, const D3D12_RESOURCE_DESC& desc, const void* data);
+	bool LoadFromFile(Texture& texture, const wchar_t* filename);
+	bool LoadIndexedFromFile(Texture& texture, const wchar_t* filename);
+	bool Find(Texture& texture, const wchar_t* filename);
+	bool Stream();
+	void EndFrame(UINT64 signaledValue);
+	void Collect();
+
+	void SetBudget(UINT64 size) { budget = size; }
+	UINT64 GetBudget() const { return budget; }
+	UINT64 GetResidentSize() const { return residentSize; }
+
+	static const UINT placeholderSize = 64; ///< 縮小版テクスチャの長辺の最大ピクセル数.
+	static const size_t maxStreamCountPerFrame = 2; ///< 1フレームで再読み込みを開始するテクスチャの最大数.
+
+private:
+	friend struct Texture;
+
+	/// 解放待ちのテクスチャ.
+	struct ReleaseItem
+	{
+		UINT64 fenceValue; ///< テクスチャの使用完了を示すフェンス値.
+		TextureEntry* entry; ///< 解放するテクスチャ.
+		uint32_t serial; ///< キューに積んだ時点の解放番号. 再取得された場合は一致しなくなる.
+	};
+
+	/// 再読み込み中のテクスチャ.
+	struct StreamItem
+	{
+		TextureEntry* entry; ///< 再読み込み先. 読み込み中に破棄された場合はnullptr.
+		Texture texture; ///< 読み込んだテクスチャ.
+	};
+
+	/// 同じコマンドリストで再読み込みしたテクスチャの集まり.
+	struct StreamBatch
+	{
+		UINT64 fenceValue; ///< 転送完了を示すコピーキューのフェンス値.
+		std::unique_ptr<ResourceLoader> loader; ///< 転送に使ったローダー. 転送完了まで保持する.
+		std::vector<StreamItem> itemList;
+	};
+
+	void Register(Texture& texture, const wchar_t* name, const Texture& source, const Texture& placeholder);
+	void Acquire(Texture& texture, TextureEntry& entry);
+	void Release(TextureEntry& entry);
+	void MarkUsed(TextureEntry& entry);
+	void Evict(TextureEntry& entry);
+	void FreeTexture(Texture& texture);
+	void Erase(TextureEntry& entry);
+	bool IsCopyCompleted(const TextureEntry& entry) const;
+	UINT64 GetAllocationSize(const Texture& texture) const;
+
+	DescriptorHeap* descriptorHeap;
+	UploadBuffer* uploadBuffer;
+	ResourceHeap* resourceHeap;
+	CopyQueue* copyQueue;
+	std::unique_ptr<ResourceLoader> loader;
+	std::vector<TextureEntry*> loadingList; ///< Begin以降に作成したテクスチャ.
+
+	std::map<std::wstring, std::unique_ptr<TextureEntry>> map;
+	Microsoft::WRL::ComPtr<ID3D12Fence> fence; ///< Graphicsのフレームフェンス.
+	UINT64 fenceValue = 0; ///< 現在のフレームの終わりにfenceへ積まれる値.
+	std::vector<ReleaseItem> pendingList; ///< まだフェンス値を割り当てていない解放待ちテクスチャ.
+	std::deque<ReleaseItem> releaseQueue; ///< フェンス値の順に並んだ解放待ちテクスチャ.
+
+	UINT64 budget = ~0ULL; ///< 常駐できるテクスチャの合計バイト数.
+	UINT64 residentSize = 0; ///< 常駐しているテクスチャの合計バイト数.
+	std::list<TextureEntry*> lruList; ///< 追い出し可能な常駐テクスチャ. 先頭ほど最近使われている.
+	std::vector<TextureEntry*> streamRequestList; ///< 再読み込みを待っているテクスチャ.
+	std::mutex markMutex; ///< MarkUsedの排他制御用. スプライトのレイヤーは複数のスレッドで同時に記録される.
+	std::deque<StreamBatch> streamBatchList; ///< 転送中のテクスチャ.
+};
+
+} // namespace Resource
+
 #endif // DX12TUTORIAL_SRC_TEXTURE_H_
\ No newline at end of file
@@ -0,0 +1,144 @@
+/**
+* @file ThreadPool.cpp
+*/
+#include "ThreadPool.h"
+#include <algorithm>
+
+/**
+* デストラクタ.
+*/
+ThreadPool::~ThreadPool()
+{
+	Destroy();
+}
+
+/**
+* ワーカースレッドを作成する.
+*
+* @param threadCount 呼び出し側のスレッドを含めたスレッド数. 0ならハードウェアのスレッド数.
+*/
+void ThreadPool::Init(uint32_t threadCount)
+{
+	Destroy();
+	if (threadCount == 0) {
+		threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+	}
+	threadList.reserve(threadCount - 1);
+	for (uint32_t i = 1; i < threadCount; ++i) {
+		threadList.push_back(std::thread(&ThreadPool::Run, this));
+	}
+}
+
+/**
+* ワーカースレッドを終了する.
+*/
+void ThreadPool::Destroy()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+	startCondition.notify_all();
+	for (auto& e : threadList) {
+		e.join();
+	}
+	threadList.clear();
+	quit = false;
+}
+
+/**
+* 処理を複数のスレッドで分担して実行する.
+*
+* count個の要素をgrainSize個ずつに分け、空いたスレッドから順に処理する.
+* 分割が1つだけ、またはワーカースレッドがなければ、呼び出したスレッドだけで処理する.
+* 他のParallelForの処理中(funcの中からの呼び出しを含む)に呼び出した場合も、空いているワーカースレッドが分担する.
+*
+* @param count     要素の数.
+* @param grainSize 1回のfuncの呼び出しで処理する要素の数.
+* @param func      処理を行う関数.
+*/
+void ThreadPool::ParallelFor(size_t count, size_t grainSize, const Func& func)
+{
+	if (count == 0) {
+		return;
+	}
+	grainSize = std::max<size_t>(grainSize, 1);
+	if (threadList.empty() || count <= grainSize) {
+		for (size_t begin = 0; begin < count; begin += grainSize) {
+			func(begin, std::min(begin + grainSize, count));
+		}
+		return;
+	}
+
+	Job job;
+	job.func = &func;
+	job.count = count;
+	job.grainSize = grainSize;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		jobList.push_back(&job);
+	}
+	startCondition.notify_all();
+	RunChunks(job);
+
+	// 未処理の要素はもうないので、ジョブをリストから外してから、処理中のワーカースレッドの完了を待つ.
+	// 待たずに戻ると、スタック上のjobやfuncが破棄された後に参照される恐れがある.
+	std::unique_lock<std::mutex> lock(mutex);
+	jobList.erase(std::find(jobList.begin(), jobList.end(), &job));
+	finishCondition.wait(lock, [&job]() { return job.workerCount == 0; });
+}
+
+/**
+* 未処理の要素が残っているジョブを探す.
+*
+* 入れ子の呼び出しを先に終わらせるため、最も新しく追加されたジョブを優先する.
+* mutexをロックした状態で呼び出すこと.
+*
+* @return 見つかったジョブ. 見つからなければnullptr.
+*/
+ThreadPool::Job* ThreadPool::FindJob() const
+{
+	for (auto i = jobList.rbegin(); i != jobList.rend(); ++i) {
+		if ((*i)->nextIndex.load() < (*i)->count) {
+			return *i;
+		}
+	}
+	return nullptr;
+}
+
+/**
+* ワーカースレッドの処理.
+*/
+void ThreadPool::Run()
+{
+	for (;;) {
+		Job* job;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			startCondition.wait(lock, [this]() { return quit || FindJob(); });
+			if (quit) {
+				return;
+			}
+			job = FindJob();
+			++job->workerCount;
+		}
+		RunChunks(*job);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--job->workerCount > 0) {
+				continue;
+			}
+		}
+		finishCondition.notify_all();
+	}
+}
+
+/**
+* 未処理の要素がなくなるまで、grainSize個ずつ取り出してfuncを実行する.
+*/
+void ThreadPool::RunChunks(Job& job)
+{
+	for (size_t begin = job.nextIndex.fetch_add(job.grainSize); begin < job.count; begin = job.nextIndex.fetch_add(job.grainSize)) {
+		(*job.func)(begin, std::min(begin + job.grainSize, job.count));
+	}
+}
@@ -0,0 +1,62 @@
+/**
+* @file ThreadPool.h
+*/
+#ifndef DX12TUTORIAL_SRC_THREADPOOL_H_
+#define DX12TUTORIAL_SRC_THREADPOOL_H_
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+* 常駐するワーカースレッドで処理を分担するクラス.
+*
+* 毎フレームの処理をスレッドの作成なしに並列化するために使う.
+* ParallelForは呼び出したスレッドも処理に参加し、全ての処理が終わってから戻る.
+* 処理中のParallelForは共有のジョブリストに積まれ、空いたワーカースレッドは最も新しく積まれたジョブから要素を取り出す.
+* そのため、funcの中から入れ子で呼び出したParallelForも、他のスレッドが空き次第並列に処理される.
+*/
+class ThreadPool
+{
+public:
+	/// ParallelForで実行する関数の型. [begin, end)の範囲の要素を処理する.
+	typedef std::function<void(size_t begin, size_t end)> Func;
+
+	ThreadPool() = default;
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	~ThreadPool();
+
+	void Init(uint32_t threadCount = 0);
+	void Destroy();
+	void ParallelFor(size_t count, size_t grainSize, const Func& func);
+	size_t GetThreadCount() const { return threadList.size() + 1; }
+
+private:
+	/// 1回のParallelForの処理. ParallelForを呼び出したスレッドのスタック上に置かれる.
+	struct Job
+	{
+		const Func* func;
+		size_t count;
+		size_t grainSize;
+		std::atomic<size_t> nextIndex{ 0 }; ///< 次に処理する要素の番号.
+		size_t workerCount = 0; ///< このジョブを処理中のワーカースレッドの数. mutexで保護する.
+	};
+
+	void Run();
+	Job* FindJob() const;
+	static void RunChunks(Job& job);
+
+	std::vector<std::thread> threadList;
+	std::mutex mutex;
+	std::condition_variable startCondition; ///< ジョブの追加をワーカースレッドに通知する.
+	std::condition_variable finishCondition; ///< ワーカースレッドがジョブの処理を終えたことを通知する.
+	bool quit = false;
+	std::vector<Job*> jobList; ///< 処理中のジョブ. 入れ子の呼び出しほど後ろにある. mutexで保護する.
+};
+
+#endif // DX12TUTORIAL_SRC_THREADPOOL_H_
@@ -0,0 +1,215 @@
+/**
+* @file UploadArena.cpp
+*/
+#include "UploadArena.h"
+#include "d3dx12.h"
+#include <algorithm>
+
+namespace Resource {
+
+namespace /* unnamed */ {
+
+/// 空きページを解放するまでのSignalの回数. 60fpsで約2秒.
+const uint32_t maxIdleCount = 120;
+
+/// ページより大きな要求に対して作成するページの大きさの単位.
+const UINT64 largePageAlignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+
+} // unnamed namespace
+
+/**
+* デストラクタ.
+*
+* ページを使うコマンドの実行が全て終わってから破棄すること.
+*/
+UploadArena::~UploadArena()
+{
+	for (auto* list : { &activePageList, &pendingPageList, &freePageList }) {
+		for (PagePtr& e : *list) {
+			ReleasePage(*e);
+		}
+	}
+}
+
+/**
+* アロケータを初期化する.
+*
+* ページは最初の確保時に作成する.
+*
+* @param d    D3Dデバイス.
+* @param h    ページを配置するアップロードヒープ.
+* @param size 1ページのバイト数.
+*
+* @retval true  初期化成功.
+* @retval false 初期化失敗.
+*/
+bool UploadArena::Init(Microsoft::WRL::ComPtr<ID3D12Device> d, ResourceHeap& h, UINT64 size)
+{
+	device = d;
+	heap = &h;
+	pageSize = size;
+	if (FAILED(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)))) {
+		return false;
+	}
+	fenceValue = 0;
+	usedSize = 0;
+	highWaterMark = 0;
+	return true;
+}
+
+/**
+* 領域を確保する.
+*
+* 使用中のページに空きがなければ、空きページを再利用するか新しいページを追加する.
+*
+* @param size       確保するバイト数.
+* @param alignment  領域先頭のアラインメント. 2のべき乗であること.
+* @param allocation 確保した領域を格納するオブジェクト.
+*
+* @retval true  確保成功.
+* @retval false 確保失敗. ページを作成できなかった.
+*/
+bool UploadArena::Allocate(UINT64 size, UINT64 alignment, Allocation& allocation)
+{
+	Reclaim();
+	for (;;) {
+		if (!activePageList.empty()) {
+			Page& page = *activePageList.back();
+			const UINT64 offset = (page.offset + alignment - 1) & ~(alignment - 1);
+			if (offset + size <= page.size) {
+				allocation.resource = page.buffer.Get();
+				allocation.offset = offset;
+				allocation.cpuAddress = page.cpuAddress + offset;
+				allocation.gpuAddress = page.buffer->GetGPUVirtualAddress() + offset;
+				usedSize += offset + size - page.offset;
+				page.offset = offset + size;
+				return true;
+			}
+		}
+		// 入りきる空きページがあれば再利用し、なければ追加する.
+		// 最近使ったページから再利用することで、使われなくなったページだけが解放されるようにする.
+		const auto itr = std::find_if(freePageList.rbegin(), freePageList.rend(), [size](const PagePtr& p) { return p->size >= size; });
+		if (itr != freePageList.rend()) {
+			activePageList.push_back(std::move(*itr));
+			freePageList.erase(std::next(itr).base());
+		} else if (!AddPage(size <= pageSize ? pageSize : (size + largePageAlignment - 1) & ~(largePageAlignment - 1))) {
+			return false;
+		}
+	}
+}
+
+/**
+* 前回のSignal以降に使用したページの使用完了を示すフェンスをコマンドキューに積む.
+*
+* 確保した領域を使うコマンドリストをコマンドキューに積んだ後で呼び出すこと.
+* 長い間使われなかった空きページはここで解放する.
+*
+* @param commandQueue コマンドキュー.
+*
+* @retval true  成功.
+* @retval false 失敗.
+*/
+bool UploadArena::Signal(ID3D12CommandQueue* commandQueue)
+{
+	for (auto itr = freePageList.begin(); itr != freePageList.end();) {
+		if (++(*itr)->idleCount > maxIdleCount) {
+			ReleasePage(**itr);
+			itr = freePageList.erase(itr);
+		} else {
+			++itr;
+		}
+	}
+
+	highWaterMark = std::max(highWaterMark, usedSize);
+	usedSize = 0;
+	if (activePageList.empty()) {
+		return true;
+	}
+	++fenceValue;
+	if (FAILED(commandQueue->Signal(fence.Get(), fenceValue))) {
+		return false;
+	}
+	for (PagePtr& e : activePageList) {
+		e->fenceValue = fenceValue;
+		pendingPageList.push_back(std::move(e));
+	}
+	activePageList.clear();
+	return true;
+}
+
+/**
+* 使用状況を取得する.
+*
+* @param stats 使用状況を格納するオブジェクト.
+*/
+void UploadArena::GetStatistics(Statistics& stats) const
+{
+	stats = {};
+	for (auto* list : { &activePageList, &pendingPageList, &freePageList }) {
+		for (const PagePtr& e : *list) {
+			++stats.pageCount;
+			stats.reservedSize += e->size;
+		}
+	}
+	stats.usedSize = usedSize;
+	stats.highWaterMark = std::max(highWaterMark, usedSize);
+}
+
+/**
+* ページを追加する.
+*
+* @param size ページのバイト数.
+*
+* @retval true  追加成功.
+* @retval false 追加失敗.
+*/
+bool UploadArena::AddPage(UINT64 size)
+{
+	if (!heap) {
+		return false;
+	}
+	PagePtr p(new Page);
+	if (!heap->CreateResource(CD3DX12_RESOURCE_DESC::Buffer(size), D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, p->buffer, p->allocation)) {
+		return false;
+	}
+	p->buffer->SetName(L"Upload Arena Page");
+	CD3DX12_RANGE range(0, 0);
+	void* cpuAddress;
+	if (FAILED(p->buffer->Map(0, &range, &cpuAddress))) {
+		ReleasePage(*p);
+		return false;
+	}
+	p->cpuAddress = static_cast<uint8_t*>(cpuAddress);
+	p->size = size;
+	p->offset = 0;
+	p->fenceValue = 0;
+	p->idleCount = 0;
+	activePageList.push_back(std::move(p));
+	return true;
+}
+
+/**
+* GPUが使用を終えたページを空きページに戻す.
+*/
+void UploadArena::Reclaim()
+{
+	const UINT64 completedValue = fence->GetCompletedValue();
+	auto itr = pendingPageList.begin();
+	for (; itr != pendingPageList.end() && (*itr)->fenceValue <= completedValue; ++itr) {
+		(*itr)->offset = 0;
+		(*itr)->idleCount = 0;
+		freePageList.push_back(std::move(*itr));
+	}
+	pendingPageList.erase(pendingPageList.begin(), itr);
+}
+
+/**
+* ページのバッファを破棄し、ヒープの領域を解放する.
+*/
+void UploadArena::ReleasePage(Page& page)
+{
+	page.buffer.Reset();
+	heap->Free(page.allocation);
+}
+
+} // namespace Resource
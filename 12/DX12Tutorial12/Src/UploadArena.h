@@ -0,0 +1,85 @@
+/**
+* @file UploadArena.h
+*/
+#ifndef DX12TUTORIAL_SRC_UPLOADARENA_H_
+#define DX12TUTORIAL_SRC_UPLOADARENA_H_
+#include "ResourceHeap.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <vector>
+#include <memory>
+
+namespace Resource {
+
+/**
+* 毎フレーム書き込むデータ用の、常時マップされたアップロードバッファの線形アロケータ.
+*
+* 一定サイズのページを先頭から順に使い、足りなくなったら新しいページを追加する.
+* ページより大きな要求には、その大きさのページを作成する.
+* 使い終わったページはSignalで送ったフェンスをGPUが通過した時点で再利用し、長い間使われなかったページは解放する.
+* スレッドセーフではないため、複数のスレッドから使う場合は呼び出し側で排他制御すること.
+*/
+class UploadArena
+{
+public:
+	/// 確保した領域.
+	struct Allocation
+	{
+		ID3D12Resource* resource; ///< 領域を含むバッファ.
+		UINT64 offset; ///< バッファ先頭からのオフセット.
+		uint8_t* cpuAddress; ///< 書き込み先アドレス.
+		D3D12_GPU_VIRTUAL_ADDRESS gpuAddress; ///< 描画時に指定するアドレス.
+	};
+
+	/// 使用状況.
+	struct Statistics
+	{
+		size_t pageCount; ///< 作成済みのページ数.
+		UINT64 reservedSize; ///< 作成済みのページの合計バイト数.
+		UINT64 usedSize; ///< 前回のSignal以降に確保したバイト数.
+		UINT64 highWaterMark; ///< Signalの間に確保したバイト数の最大値.
+	};
+
+	UploadArena() = default;
+	UploadArena(const UploadArena&) = delete;
+	UploadArena& operator=(const UploadArena&) = delete;
+	~UploadArena();
+
+	bool Init(Microsoft::WRL::ComPtr<ID3D12Device> device, ResourceHeap& heap, UINT64 pageSize);
+	bool Allocate(UINT64 size, UINT64 alignment, Allocation& allocation);
+	bool Signal(ID3D12CommandQueue* commandQueue);
+	void GetStatistics(Statistics& stats) const;
+
+private:
+	/// ページ.
+	struct Page
+	{
+		Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+		ResourceHeap::Allocation allocation;
+		uint8_t* cpuAddress;
+		UINT64 size; ///< ページのバイト数.
+		UINT64 offset; ///< 次に確保する位置.
+		UINT64 fenceValue; ///< 使用完了を示すフェンス値.
+		uint32_t idleCount; ///< 空きページのまま経過したSignalの回数.
+	};
+	typedef std::unique_ptr<Page> PagePtr;
+
+	bool AddPage(UINT64 size);
+	void Reclaim();
+	void ReleasePage(Page& page);
+
+	Microsoft::WRL::ComPtr<ID3D12Device> device;
+	ResourceHeap* heap = nullptr;
+	Microsoft::WRL::ComPtr<ID3D12Fence> fence;
+	UINT64 fenceValue = 0;
+	UINT64 pageSize = 0;
+	std::vector<PagePtr> activePageList; ///< 前回のSignal以降に使用したページ. 末尾から確保する.
+	std::vector<PagePtr> pendingPageList; ///< GPUの使用完了を待っているページ. フェンス値の小さい順に並ぶ.
+	std::vector<PagePtr> freePageList; ///< 再利用できるページ.
+	UINT64 usedSize = 0;
+	UINT64 highWaterMark = 0;
+};
+
+} // namespace Resource
+
+#endif // DX12TUTORIAL_SRC_UPLOADARENA_H_
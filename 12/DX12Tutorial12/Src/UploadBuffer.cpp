@@ -0,0 +1,174 @@
+/**
+* @file UploadBuffer.cpp
+*/
+#include "UploadBuffer.h"
+#include "d3dx12.h"
+
+namespace Resource {
+
+/**
+* デストラクタ.
+*/
+UploadBuffer::~UploadBuffer()
+{
+	if (fenceEvent) {
+		CloseHandle(fenceEvent);
+	}
+}
+
+/**
+* アップロードバッファを初期化する.
+*
+* @param device D3Dデバイス.
+* @param size   バッファのバイト数.
+*
+* @retval true  初期化成功.
+* @retval false 初期化失敗.
+*/
+bool UploadBuffer::Init(Microsoft::WRL::ComPtr<ID3D12Device> device, UINT64 size)
+{
+	if (FAILED(device->CreateCommittedResource(
+		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
+		D3D12_HEAP_FLAG_NONE,
+		&CD3DX12_RESOURCE_DESC::Buffer(size),
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&buffer)
+	))) {
+		return false;
+	}
+	this->device = device;
+	buffer->SetName(L"Upload Ring Buffer");
+	CD3DX12_RANGE range(0, 0);
+	void* p;
+	if (FAILED(buffer->Map(0, &range, &p))) {
+		return false;
+	}
+	cpuAddress = static_cast<uint8_t*>(p);
+
+	if (FAILED(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)))) {
+		return false;
+	}
+	fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+	if (!fenceEvent) {
+		return false;
+	}
+	fenceValue = 0;
+	allocator.Init(size);
+	dedicatedList.clear();
+	return true;
+}
+
+/**
+* 領域を確保する.
+*
+* sizeがバッファより大きい場合は、専用のアップロードバッファを作成して返す.
+*
+* @param size       確保するバイト数.
+* @param alignment  領域先頭のアラインメント.
+* @param allocation 確保した領域を格納するオブジェクト.
+*
+* @retval true  確保成功.
+* @retval false 確保失敗. まだSignalしていない領域だけで一杯になっているか、専用バッファの作成に失敗した.
+*               前者の場合は、領域を使うコマンドリストを実行してSignalを呼べば、再び確保できるようになる.
+*/
+bool UploadBuffer::Allocate(UINT64 size, UINT64 alignment, Allocation& allocation)
+{
+	Reclaim();
+	if (allocator.IsOversized(size)) {
+		return AllocateDedicated(size, allocation);
+	}
+	for (;;) {
+		const uint64_t offset = allocator.Allocate(size, alignment);
+		if (offset != RingAllocator::invalidOffset) {
+			allocation.resource = buffer.Get();
+			allocation.offset = offset;
+			allocation.cpuAddress = cpuAddress + offset;
+			return true;
+		}
+		if (!allocator.HasCommittedRange()) {
+			return false;
+		}
+		// 空きが足りないので、最も古い領域の使用完了を待つ.
+		const UINT64 waitValue = allocator.GetOldestFenceValue();
+		if (fence->GetCompletedValue() < waitValue) {
+			if (FAILED(fence->SetEventOnCompletion(waitValue, fenceEvent))) {
+				return false;
+			}
+			WaitForSingleObject(fenceEvent, INFINITE);
+		}
+		Reclaim();
+	}
+}
+
+/**
+* バッファに収まらない大きさの領域を、専用のアップロードバッファとして作成する.
+*
+* 専用バッファは次のSignalで送るフェンスに関連付けられ、GPUがそのフェンスを通過した後のReclaimで解放される.
+*
+* @param size       確保するバイト数.
+* @param allocation 確保した領域を格納するオブジェクト.
+*
+* @retval true  作成成功.
+* @retval false 作成失敗.
+*/
+bool UploadBuffer::AllocateDedicated(UINT64 size, Allocation& allocation)
+{
+	Microsoft::WRL::ComPtr<ID3D12Resource> dedicated;
+	if (FAILED(device->CreateCommittedResource(
+		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
+		D3D12_HEAP_FLAG_NONE,
+		&CD3DX12_RESOURCE_DESC::Buffer(size),
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&dedicated)
+	))) {
+		return false;
+	}
+	dedicated->SetName(L"Dedicated Upload Buffer");
+	CD3DX12_RANGE range(0, 0);
+	void* p;
+	if (FAILED(dedicated->Map(0, &range, &p))) {
+		return false;
+	}
+	allocation.resource = dedicated.Get();
+	allocation.offset = 0;
+	allocation.cpuAddress = static_cast<uint8_t*>(p);
+	dedicatedList.push_back(dedicated);
+	allocator.AddExternal();
+	return true;
+}
+
+/**
+* GPUが使い終えた領域と専用バッファを解放する.
+*/
+void UploadBuffer::Reclaim()
+{
+	const size_t releaseCount = allocator.Reclaim(fence->GetCompletedValue());
+	dedicatedList.erase(dedicatedList.begin(), dedicatedList.begin() + releaseCount);
+}
+
+/**
+* 前回のSignal以降に確保した領域と専用バッファの使用完了を示すフェンスをコマンドキューに積む.
+*
+* 確保した領域を使うコマンドリストをコマンドキューに積んだ後で呼び出すこと.
+*
+* @param commandQueue コマンドキュー.
+*
+* @retval true  成功.
+* @retval false 失敗.
+*/
+bool UploadBuffer::Signal(ID3D12CommandQueue* commandQueue)
+{
+	if (!allocator.HasUncommittedRange()) {
+		return true;
+	}
+	++fenceValue;
+	if (FAILED(commandQueue->Signal(fence.Get(), fenceValue))) {
+		return false;
+	}
+	allocator.Commit(fenceValue);
+	return true;
+}
+
+} // namespace Resource
@@ -0,0 +1,57 @@
+/**
+* @file UploadBuffer.h
+*/
+#ifndef DX12TUTORIAL_SRC_UPLOADBUFFER_H_
+#define DX12TUTORIAL_SRC_UPLOADBUFFER_H_
+#include "RingAllocator.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <deque>
+
+namespace Resource {
+
+/**
+* データ転送用の常時マップされたアップロードバッファ.
+*
+* 内部はリングアロケータで管理され、確保した領域はSignalで送ったフェンスをGPUが通過した時点で再利用される.
+* 空きが足りない場合のみ、最も古いフェンスの完了を待つ.
+* バッファより大きな要求には専用のアップロードバッファを作成し、同じフェンスの通過後に解放する.
+*/
+class UploadBuffer
+{
+public:
+	/// 確保した領域.
+	struct Allocation
+	{
+		ID3D12Resource* resource; ///< 領域を含むバッファ.
+		UINT64 offset; ///< バッファ先頭からのオフセット.
+		uint8_t* cpuAddress; ///< 書き込み先アドレス.
+	};
+
+	UploadBuffer() = default;
+	UploadBuffer(const UploadBuffer&) = delete;
+	UploadBuffer& operator=(const UploadBuffer&) = delete;
+	~UploadBuffer();
+
+	bool Init(Microsoft::WRL::ComPtr<ID3D12Device> device, UINT64 size);
+	bool Allocate(UINT64 size, UINT64 alignment, Allocation& allocation);
+	bool Signal(ID3D12CommandQueue* commandQueue);
+	bool HasUnsignaledRange() const { return allocator.HasUncommittedRange(); }
+
+private:
+	bool AllocateDedicated(UINT64 size, Allocation& allocation);
+	void Reclaim();
+
+	Microsoft::WRL::ComPtr<ID3D12Device> device;
+	Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+	Microsoft::WRL::ComPtr<ID3D12Fence> fence;
+	HANDLE fenceEvent = nullptr;
+	UINT64 fenceValue = 0;
+	uint8_t* cpuAddress = nullptr;
+	RingAllocator allocator;
+	std::deque<Microsoft::WRL::ComPtr<ID3D12Resource>> dedicatedList; ///< 使用中の専用バッファ. 作成した順に並ぶ.
+};
+
+} // namespace Resource
+
+#endif // DX12TUTORIAL_SRC_UPLOADBUFFER_H_
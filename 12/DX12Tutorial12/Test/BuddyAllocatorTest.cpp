@@ -0,0 +1,218 @@
+/**
+* @file BuddyAllocatorTest.cpp
+*/
+#include "Test.h"
+#include "../Src/BuddyAllocator.h"
+#include <vector>
+#include <map>
+#include <iterator>
+#include <random>
+
+using Resource::BuddyAllocator;
+
+namespace Test {
+
+namespace /* unnamed */ {
+
+const uint64_t capacity = 1024 * 1024;
+const uint64_t minBlockSize = 4096;
+
+/**
+* 不正な引数での初期化が失敗することを確かめる.
+*/
+void TestInit()
+{
+	BuddyAllocator a;
+	TEST_CHECK(!a.Init(capacity + 1, minBlockSize));
+	TEST_CHECK(!a.Init(capacity, minBlockSize + 1));
+	TEST_CHECK(!a.Init(minBlockSize, capacity));
+	TEST_CHECK(a.Init(capacity, minBlockSize));
+	TEST_CHECK(a.IsEmpty());
+}
+
+/**
+* ブロックの分割と結合を確かめる.
+*
+* 最初の確保で全体が最小ブロックまで分割され、分割された後半が次の確保に使われる.
+* 全て解放すると、バディ同士が結合されて1つの空きブロックに戻る.
+*/
+void TestSplitAndMerge()
+{
+	BuddyAllocator a;
+	a.Init(capacity, minBlockSize);
+	const uint64_t o1 = a.Allocate(100, 1);
+	const uint64_t o2 = a.Allocate(5000, 1);
+	const uint64_t o3 = a.Allocate(minBlockSize, 1);
+	TEST_CHECK(o1 == 0);
+	TEST_CHECK(o2 == minBlockSize * 2);
+	TEST_CHECK(o3 == minBlockSize);
+
+	BuddyAllocator::Statistics stats;
+	a.GetStatistics(stats);
+	TEST_CHECK(stats.allocationCount == 3);
+	TEST_CHECK(stats.allocatedSize == minBlockSize * 4);
+	TEST_CHECK(stats.requestedSize == 100 + 5000 + minBlockSize);
+	TEST_CHECK(stats.largestFreeBlock == capacity / 2);
+
+	TEST_CHECK(a.Free(o3));
+	TEST_CHECK(a.Free(o1));
+	TEST_CHECK(!a.Free(o1));
+	TEST_CHECK(!a.IsEmpty());
+	TEST_CHECK(a.Free(o2));
+	TEST_CHECK(a.IsEmpty());
+	a.GetStatistics(stats);
+	TEST_CHECK(stats.freeBlockCount == 1);
+	TEST_CHECK(stats.largestFreeBlock == capacity);
+	TEST_CHECK(stats.allocatedSize == 0 && stats.requestedSize == 0);
+}
+
+/**
+* アラインメントと重なりを確かめる.
+*
+* 確保と解放を乱数で繰り返し、全ての領域がアラインメントを満たし、互いに重ならないことを調べる.
+*/
+void TestAlignment()
+{
+	BuddyAllocator a;
+	a.Init(capacity, minBlockSize);
+	std::mt19937 rng(1);
+	std::map<uint64_t, uint64_t> liveMap; // オフセットとサイズ.
+	int failureCount = 0;
+	for (int i = 0; i < 20000 && failureCount == 0; ++i) {
+		if (rng() % 2 && !liveMap.empty()) {
+			auto itr = liveMap.begin();
+			std::advance(itr, rng() % liveMap.size());
+			failureCount += !TEST_CHECK(a.Free(itr->first));
+			liveMap.erase(itr);
+			continue;
+		}
+		const uint64_t size = 1 + rng() % 70000;
+		const uint64_t alignment = 1ULL << (rng() % 17);
+		const uint64_t offset = a.Allocate(size, alignment);
+		if (offset == BuddyAllocator::invalidOffset) {
+			continue;
+		}
+		failureCount += !TEST_CHECK(offset % alignment == 0);
+		failureCount += !TEST_CHECK(offset + size <= capacity);
+		const auto next = liveMap.lower_bound(offset);
+		if (next != liveMap.end()) {
+			failureCount += !TEST_CHECK(offset + size <= next->first);
+		}
+		if (next != liveMap.begin()) {
+			const auto prev = std::prev(next);
+			failureCount += !TEST_CHECK(prev->first + prev->second <= offset);
+		}
+		liveMap[offset] = size;
+	}
+	for (const auto& e : liveMap) {
+		a.Free(e.first);
+	}
+	TEST_CHECK(a.IsEmpty());
+}
+
+/**
+* 領域を使い切ったときと、大きすぎる要求で確保が失敗することを確かめる.
+*/
+void TestExhaustion()
+{
+	BuddyAllocator a;
+	a.Init(capacity, minBlockSize);
+	TEST_CHECK(a.Allocate(0, 1) == BuddyAllocator::invalidOffset);
+	TEST_CHECK(a.Allocate(capacity + 1, 1) == BuddyAllocator::invalidOffset);
+	TEST_CHECK(a.Allocate(1, capacity * 2) == BuddyAllocator::invalidOffset);
+
+	std::vector<uint64_t> offsetList;
+	for (;;) {
+		const uint64_t offset = a.Allocate(1, 1);
+		if (offset == BuddyAllocator::invalidOffset) {
+			break;
+		}
+		offsetList.push_back(offset);
+	}
+	TEST_CHECK(offsetList.size() == capacity / minBlockSize);
+	BuddyAllocator::Statistics stats;
+	a.GetStatistics(stats);
+	TEST_CHECK(stats.allocatedSize == capacity);
+	TEST_CHECK(stats.largestFreeBlock == 0);
+	TEST_CHECK(stats.freeBlockCount == 0);
+
+	// 1つ解放すれば、その大きさまでは再び確保できる.
+	TEST_CHECK(a.Free(offsetList.back()));
+	TEST_CHECK(a.Allocate(minBlockSize * 2, 1) == BuddyAllocator::invalidOffset);
+	TEST_CHECK(a.Allocate(minBlockSize, 1) == offsetList.back());
+}
+
+/**
+* 断片化の統計情報を確かめる.
+*/
+void TestFragmentation()
+{
+	BuddyAllocator a;
+	a.Init(capacity, minBlockSize);
+	BuddyAllocator::Statistics stats;
+	a.GetStatistics(stats);
+	TEST_CHECK(stats.GetInternalFragmentation() == 0.0f);
+	TEST_CHECK(stats.GetExternalFragmentation() == 0.0f);
+
+	// 内部断片化: 1024バイトの要求に4096バイトのブロックを割り当てるので、3/4が未使用.
+	const uint64_t offset = a.Allocate(1024, 1);
+	a.GetStatistics(stats);
+	TEST_CHECK(stats.GetInternalFragmentation() == 0.75f);
+	a.Free(offset);
+
+	// 外部断片化: 最小ブロックを1つおきに解放すると、空き領域は半分あるが最小ブロックしか確保できない.
+	std::vector<uint64_t> offsetList;
+	for (uint64_t i = 0; i < capacity / minBlockSize; ++i) {
+		offsetList.push_back(a.Allocate(minBlockSize, 1));
+	}
+	for (size_t i = 0; i < offsetList.size(); i += 2) {
+		a.Free(offsetList[i]);
+	}
+	a.GetStatistics(stats);
+	TEST_CHECK(stats.largestFreeBlock == minBlockSize);
+	TEST_CHECK(stats.freeBlockCount == capacity / minBlockSize / 2);
+	TEST_CHECK(stats.GetInternalFragmentation() == 0.0f);
+	const float expected = 1.0f - static_cast<float>(minBlockSize) / static_cast<float>(capacity / 2);
+	TEST_CHECK(stats.GetExternalFragmentation() == expected);
+}
+
+} // unnamed namespace
+
+/**
+* BuddyAllocatorのテスト.
+*/
+void TestBuddyAllocator()
+{
+	TestInit();
+	TestSplitAndMerge();
+	TestAlignment();
+	TestExhaustion();
+	TestFragmentation();
+}
+
+/**
+* BuddyAllocatorのベンチマーク.
+*
+* テクスチャ用のResourceHeapと同じ32MBの領域で、4KBから64KBまでの確保と解放を繰り返す速度を計る.
+*/
+void BenchBuddyAllocator()
+{
+	BuddyAllocator a;
+	a.Init(32 * 1024 * 1024, 4096);
+	std::vector<uint64_t> offsetList;
+	offsetList.reserve(1000);
+	const int repeatCount = 200;
+	const double startTime = GetTime();
+	for (int r = 0; r < repeatCount; ++r) {
+		for (uint64_t i = 0; i < 1000; ++i) {
+			offsetList.push_back(a.Allocate(4096 * (1 + i % 16), 4096));
+		}
+		for (uint64_t offset : offsetList) {
+			a.Free(offset);
+		}
+		offsetList.clear();
+	}
+	ReportBench("Allocate + Free (4KB-64KB)", GetTime() - startTime, repeatCount * 1000, "pairs");
+}
+
+} // namespace Test
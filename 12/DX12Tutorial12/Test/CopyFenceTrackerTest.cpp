@@ -0,0 +1,102 @@
+/**
+* @file CopyFenceTrackerTest.cpp
+*/
+#include "Test.h"
+#include "../Src/CopyFenceTracker.h"
+#include <random>
+
+using Resource::CopyFenceTracker;
+
+namespace Test {
+
+namespace /* unnamed */ {
+
+/**
+* 待機が必要な場合だけ待機の値が返されることを確かめる.
+*/
+void TestWaitValue()
+{
+	CopyFenceTracker t;
+	TEST_CHECK(t.GetWaitValue(0) == 0);
+
+	const uint64_t v1 = t.Issue();
+	const uint64_t v2 = t.Issue();
+	TEST_CHECK(v1 == 1 && v2 == 2);
+	TEST_CHECK(t.GetLastIssuedValue() == 2);
+
+	// 転送前のリソース(値0)は待機を必要としない.
+	t.Require(0);
+	TEST_CHECK(t.GetWaitValue(0) == 0);
+
+	// 複数のリソースを使う場合は最大の値を待つ.
+	t.Require(v2);
+	t.Require(v1);
+	TEST_CHECK(t.GetWaitValue(0) == v2);
+	TEST_CHECK(t.GetWaitedValue() == v2);
+
+	// 登録はGetWaitValueでリセットされ、一度待機した値は再び待たない.
+	TEST_CHECK(t.GetWaitValue(0) == 0);
+	t.Require(v1);
+	TEST_CHECK(t.GetWaitValue(0) == 0);
+
+	// 完了済みの転送は待たない.
+	const uint64_t v3 = t.Issue();
+	t.Require(v3);
+	TEST_CHECK(t.GetWaitValue(v3) == 0);
+	TEST_CHECK(t.GetWaitedValue() == v2);
+}
+
+/**
+* コピーキューと描画キューを模して、描画が未完了の転送を待たずに実行されることがなく、
+* 不要な待機も挿入されないことを確かめる.
+*
+* コピーキューの完了は乱数で遅らせ、描画キューは挿入された待機の値まで進んだものとして扱う.
+*/
+void TestQueueSimulation()
+{
+	CopyFenceTracker t;
+	std::mt19937 rng(1);
+	uint64_t copyCompleted = 0;
+	uint64_t drawWaited = 0; // 描画キューが待機済みのフェンス値.
+	int failureCount = 0;
+	for (int frame = 0; frame < 5000 && failureCount == 0; ++frame) {
+		const int copyCount = rng() % 3;
+		for (int i = 0; i < copyCount; ++i) {
+			t.Issue();
+		}
+		// 描画で使うリソースは、発行済みの値から選ぶ. 0は転送の必要がないリソース.
+		uint64_t required = 0;
+		const int resourceCount = rng() % 4;
+		for (int i = 0; i < resourceCount; ++i) {
+			const uint64_t value = t.GetLastIssuedValue() ? rng() % (t.GetLastIssuedValue() + 1) : 0;
+			t.Require(value);
+			required = value > required ? value : required;
+		}
+		const uint64_t wait = t.GetWaitValue(copyCompleted);
+		if (wait) {
+			failureCount += !TEST_CHECK(wait > copyCompleted && wait > drawWaited);
+			failureCount += !TEST_CHECK(wait == required);
+			drawWaited = wait;
+		}
+		failureCount += !TEST_CHECK(required <= copyCompleted || required <= drawWaited);
+
+		// コピーキューは発行済みの値のどこかまで進む.
+		const uint64_t remaining = t.GetLastIssuedValue() - copyCompleted;
+		if (remaining) {
+			copyCompleted += rng() % (remaining + 1);
+		}
+	}
+}
+
+} // unnamed namespace
+
+/**
+* CopyFenceTrackerのテスト.
+*/
+void TestCopyFenceTracker()
+{
+	TestWaitValue();
+	TestQueueSimulation();
+}
+
+} // namespace Test
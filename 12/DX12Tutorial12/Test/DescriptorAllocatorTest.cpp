@@ -0,0 +1,169 @@
+/**
+* @file DescriptorAllocatorTest.cpp
+*/
+#include "Test.h"
+#include "../Src/DescriptorAllocator.h"
+
+using Resource::DescriptorAllocator;
+using Resource::DescriptorHandle;
+
+namespace Test {
+
+namespace /* unnamed */ {
+
+const uint32_t pageSize = 64;
+const uint32_t transientCount = 8;
+const uint32_t frameCount = 2;
+const uint32_t transientTotal = transientCount * frameCount;
+
+/**
+* 不正な引数での初期化が失敗することを確かめる.
+*/
+void TestInit()
+{
+	DescriptorAllocator a;
+	TEST_CHECK(!a.Init(0, 0, frameCount));
+	TEST_CHECK(!a.Init(0x10000, 0, frameCount));
+	TEST_CHECK(!a.Init(pageSize, pageSize / 2, frameCount));
+	TEST_CHECK(a.Init(pageSize, transientCount, frameCount));
+	TEST_CHECK(a.GetPageCount() == 1);
+	TEST_CHECK(a.GetAllocatedCount() == 0);
+}
+
+/**
+* 永続領域の確保と解放、空き範囲の結合を確かめる.
+*/
+void TestAllocateAndFree()
+{
+	DescriptorAllocator a;
+	a.Init(pageSize, transientCount, frameCount);
+	TEST_CHECK(a.Allocate(0).IsNull());
+	TEST_CHECK(a.Allocate(pageSize + 1).IsNull());
+
+	// 永続領域は一時領域の後ろから割り当てられる.
+	const DescriptorHandle h1 = a.Allocate(4);
+	const DescriptorHandle h2 = a.Allocate(4);
+	const DescriptorHandle h3 = a.Allocate(4);
+	TEST_CHECK(h1.page == 0 && h1.offset == transientTotal);
+	TEST_CHECK(h2.offset == transientTotal + 4);
+	TEST_CHECK(h3.offset == transientTotal + 8);
+	TEST_CHECK(!a.IsTransient(h1));
+	TEST_CHECK(a.GetAllocatedCount() == 12);
+
+	// 解放した穴には収まる要求だけが入る.
+	TEST_CHECK(a.Free(h2));
+	TEST_CHECK(!a.Free(h2));
+	const DescriptorHandle h4 = a.Allocate(5);
+	TEST_CHECK(h4.offset == transientTotal + 12);
+	const DescriptorHandle h5 = a.Allocate(4);
+	TEST_CHECK(h5.offset == h2.offset);
+	TEST_CHECK(a.Free(h5));
+
+	// 前後の空き範囲と結合されれば、大きな範囲を同じ位置に確保できる.
+	TEST_CHECK(a.Free(h1));
+	TEST_CHECK(a.Free(h3));
+	const DescriptorHandle h6 = a.Allocate(12);
+	TEST_CHECK(h6.page == 0 && h6.offset == transientTotal);
+	TEST_CHECK(a.Free(h6));
+	TEST_CHECK(a.Free(h4));
+	TEST_CHECK(a.GetAllocatedCount() == 0);
+	TEST_CHECK(a.Allocate(pageSize - transientTotal).offset == transientTotal);
+}
+
+/**
+* ページが足りなくなったとき、新しいページが追加されることを確かめる.
+*/
+void TestPageGrowth()
+{
+	DescriptorAllocator a;
+	a.Init(pageSize, transientCount, frameCount);
+	const DescriptorHandle h1 = a.Allocate(pageSize - transientTotal);
+	TEST_CHECK(a.GetPageCount() == 1);
+	const DescriptorHandle h2 = a.Allocate(1);
+	TEST_CHECK(a.GetPageCount() == 2);
+	TEST_CHECK(h2.page == 1 && h2.offset == 0);
+
+	// 2ページ目の先頭は一時領域ではない.
+	TEST_CHECK(!a.IsTransient(h2));
+	const DescriptorHandle h3 = a.Allocate(pageSize);
+	TEST_CHECK(h3.page == 2);
+	TEST_CHECK(a.Free(h1));
+	TEST_CHECK(a.Allocate(1).page == 0);
+}
+
+/**
+* 解放済みのハンドルが世代番号によって無効と判定されることを確かめる.
+*/
+void TestGeneration()
+{
+	DescriptorAllocator a;
+	a.Init(pageSize, transientCount, frameCount);
+	const DescriptorHandle h1 = a.Allocate(2);
+	TEST_CHECK(a.IsValid(h1));
+	a.Free(h1);
+	TEST_CHECK(!a.IsValid(h1));
+
+	// 同じ位置に同じ大きさで確保し直しても、古いハンドルは無効のまま.
+	const DescriptorHandle h2 = a.Allocate(2);
+	TEST_CHECK(h2.offset == h1.offset);
+	TEST_CHECK(h2.generation != h1.generation);
+	TEST_CHECK(a.IsValid(h2));
+	TEST_CHECK(!a.IsValid(h1));
+	TEST_CHECK(!a.Free(h1));
+
+	// 範囲の途中を指すハンドルは無効.
+	DescriptorHandle inner = h2;
+	inner.offset += 1;
+	inner.count = 1;
+	TEST_CHECK(!a.IsValid(inner));
+	TEST_CHECK(!a.IsValid(DescriptorHandle()));
+}
+
+/**
+* フレーム単位の一時領域を確かめる.
+*/
+void TestTransient()
+{
+	DescriptorAllocator a;
+	a.Init(pageSize, transientCount, frameCount);
+	a.BeginFrame(0);
+	const DescriptorHandle t1 = a.AllocateTransient(3);
+	const DescriptorHandle t2 = a.AllocateTransient(5);
+	TEST_CHECK(t1.page == 0 && t1.offset == 0);
+	TEST_CHECK(t2.offset == 3);
+	TEST_CHECK(a.IsTransient(t1) && a.IsValid(t1) && a.IsValid(t2));
+	TEST_CHECK(a.AllocateTransient(1).IsNull());
+	TEST_CHECK(!a.Free(t1));
+
+	// 別のフレームは別の領域を使い、前のフレームのハンドルは有効なまま.
+	a.BeginFrame(1);
+	const DescriptorHandle t3 = a.AllocateTransient(transientCount);
+	TEST_CHECK(t3.offset == transientCount);
+	TEST_CHECK(a.IsValid(t1));
+
+	// 同じフレームに戻ると、以前のハンドルは無効になる.
+	a.BeginFrame(0);
+	TEST_CHECK(!a.IsValid(t1));
+	TEST_CHECK(!a.IsValid(t2));
+	TEST_CHECK(a.IsValid(t3));
+	const DescriptorHandle t4 = a.AllocateTransient(3);
+	TEST_CHECK(t4.offset == 0 && a.IsValid(t4));
+	TEST_CHECK(!a.IsValid(t1));
+	TEST_CHECK(a.GetAllocatedCount() == 0);
+}
+
+} // unnamed namespace
+
+/**
+* DescriptorAllocatorのテスト.
+*/
+void TestDescriptorAllocator()
+{
+	TestInit();
+	TestAllocateAndFree();
+	TestPageGrowth();
+	TestGeneration();
+	TestTransient();
+}
+
+} // namespace Test
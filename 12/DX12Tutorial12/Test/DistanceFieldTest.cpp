@@ -0,0 +1,206 @@
+/**
+* @file DistanceFieldTest.cpp
+*/
+#include "Test.h"
+#include "../Src/DistanceField.h"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <stdlib.h>
+
+using DistanceField::Rect;
+
+namespace Test {
+
+namespace /* unnamed */ {
+
+/**
+* 全ての点の組を調べる方法で、1つのグリフの距離場を生成する.
+*
+* DistanceField::Generateと同じ規則で内外を判定し、同じ式で値に変換する.
+*/
+std::vector<uint8_t> GenerateReference(const uint8_t* alpha, size_t rowPitch, const Rect& glyph, uint32_t scale, uint32_t spread)
+{
+	uint32_t dstWidth, dstHeight;
+	DistanceField::GetSize(glyph, scale, spread, dstWidth, dstHeight);
+	const int width = static_cast<int>(dstWidth * scale);
+	const int height = static_cast<int>(dstHeight * scale);
+	std::vector<bool> isInside(width * height);
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			const int gx = x - static_cast<int>(spread);
+			const int gy = y - static_cast<int>(spread);
+			if (gx >= 0 && gy >= 0 && gx < static_cast<int>(glyph.width) && gy < static_cast<int>(glyph.height)) {
+				isInside[y * width + x] = alpha[rowPitch * (glyph.y + gy) + glyph.x + gx] >= 128;
+			}
+		}
+	}
+	std::vector<float> distance(width * height);
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			const bool self = isInside[y * width + x];
+			int nearest = width * width + height * height;
+			for (int i = 0; i < width * height; ++i) {
+				if (isInside[i] != self) {
+					const int dx = i % width - x;
+					const int dy = i / width - y;
+					nearest = std::min(nearest, dx * dx + dy * dy);
+				}
+			}
+			const float d = std::sqrt(static_cast<float>(nearest)) - 0.5f;
+			distance[y * width + x] = self ? -d : d;
+		}
+	}
+	std::vector<uint8_t> dst(dstWidth * dstHeight);
+	for (uint32_t y = 0; y < dstHeight; ++y) {
+		for (uint32_t x = 0; x < dstWidth; ++x) {
+			float sum = 0;
+			for (uint32_t sy = y * scale; sy < (y + 1) * scale; ++sy) {
+				for (uint32_t sx = x * scale; sx < (x + 1) * scale; ++sx) {
+					sum += distance[sy * width + sx];
+				}
+			}
+			const float value = 0.5f - sum / static_cast<float>(scale * scale) * 0.5f / static_cast<float>(spread);
+			dst[y * dstWidth + x] = static_cast<uint8_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+		}
+	}
+	return dst;
+}
+
+/**
+* 乱数でグリフを並べた画像を作成する.
+*
+* 各グリフは楕円と矩形を重ねた形にする. グリフの範囲外も不透明にして、範囲外を読まないことを確かめられるようにする.
+*/
+std::vector<uint8_t> CreateFontImage(uint32_t width, uint32_t height, const std::vector<Rect>& glyphList, uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	std::vector<uint8_t> alpha(width * height, 255);
+	for (const Rect& g : glyphList) {
+		const float cx = static_cast<float>(rng() % (g.width + 1));
+		const float cy = static_cast<float>(rng() % (g.height + 1));
+		const float rx = 1.0f + static_cast<float>(rng() % (g.width / 2 + 1));
+		const float ry = 1.0f + static_cast<float>(rng() % (g.height / 2 + 1));
+		const uint32_t bar = rng() % g.height;
+		for (uint32_t y = 0; y < g.height; ++y) {
+			for (uint32_t x = 0; x < g.width; ++x) {
+				const float dx = (x - cx) / rx;
+				const float dy = (y - cy) / ry;
+				const bool inside = dx * dx + dy * dy <= 1.0f || y == bar;
+				alpha[(g.y + y) * width + g.x + x] = inside ? static_cast<uint8_t>(128 + rng() % 128) : static_cast<uint8_t>(rng() % 128);
+			}
+		}
+	}
+	return alpha;
+}
+
+/**
+* 距離場の大きさの計算を確かめる.
+*/
+void TestGetSize()
+{
+	uint32_t w, h;
+	DistanceField::GetSize({ 0, 0, 10, 7 }, 1, 3, w, h);
+	TEST_CHECK(w == 16 && h == 13);
+	DistanceField::GetSize({ 0, 0, 10, 7 }, 4, 3, w, h);
+	TEST_CHECK(w == 4 && h == 4);
+	DistanceField::GetSize({ 0, 0, 0, 7 }, 4, 3, w, h);
+	TEST_CHECK(w == 0 && h == 0);
+}
+
+/**
+* Generateの結果が全探索による距離場と一致することを確かめる.
+*
+* 縮小しない場合と縮小する場合の両方を調べる. 平方根の丸めの差を考えて1の誤差を許す.
+*/
+void TestGenerateMatchesReference()
+{
+	const std::vector<Rect> glyphList = { { 2, 3, 14, 11 }, { 20, 1, 9, 17 }, { 31, 2, 1, 1 } };
+	const uint32_t imageWidth = 40;
+	const uint32_t imageHeight = 20;
+	const std::vector<uint8_t> alpha = CreateFontImage(imageWidth, imageHeight, glyphList, 1);
+	int failureCount = 0;
+	for (uint32_t scale : { 1U, 2U, 3U }) {
+		for (const Rect& g : glyphList) {
+			const uint32_t spread = 4;
+			uint32_t w, h;
+			DistanceField::GetSize(g, scale, spread, w, h);
+			std::vector<uint8_t> dst(w * h);
+			DistanceField::Generate(alpha.data(), imageWidth, g, scale, spread, dst.data(), w);
+			const std::vector<uint8_t> reference = GenerateReference(alpha.data(), imageWidth, g, scale, spread);
+			for (size_t i = 0; i < dst.size() && failureCount == 0; ++i) {
+				failureCount += !TEST_CHECK(abs(dst[i] - reference[i]) <= 1);
+			}
+		}
+	}
+}
+
+/**
+* BuildAtlasの配置と内容を確かめる.
+*
+* 配置した範囲は重ならず画像に収まり、各範囲の内容は単独でGenerateした結果と一致する.
+* スレッド数を変えても同じ画像が生成される.
+*/
+void TestBuildAtlas()
+{
+	std::mt19937 rng(2);
+	const uint32_t imageWidth = 256;
+	std::vector<Rect> glyphList;
+	uint32_t x = 0;
+	for (int i = 0; i < 24; ++i) {
+		const uint32_t w = (i == 5) ? 0 : 1 + rng() % 16;
+		const uint32_t h = 1 + rng() % 20;
+		glyphList.push_back({ x, 0, w, h });
+		x += w;
+	}
+	const std::vector<uint8_t> alpha = CreateFontImage(imageWidth, 20, glyphList, 3);
+	const uint32_t scale = 2;
+	const uint32_t spread = 4;
+	const uint32_t atlasWidth = 40;
+
+	DistanceField::Atlas atlas;
+	TEST_CHECK(!DistanceField::BuildAtlas(alpha.data(), imageWidth, glyphList.data(), glyphList.size(), scale, spread, 8, atlas));
+	TEST_CHECK(DistanceField::BuildAtlas(alpha.data(), imageWidth, glyphList.data(), glyphList.size(), scale, spread, atlasWidth, atlas, 1));
+	TEST_CHECK(atlas.rectList.size() == glyphList.size());
+	TEST_CHECK(atlas.image.size() == atlas.width * atlas.height);
+	TEST_CHECK(atlas.rectList[5].width == 0);
+
+	int failureCount = 0;
+	for (size_t i = 0; i < glyphList.size() && failureCount == 0; ++i) {
+		const Rect& r = atlas.rectList[i];
+		if (r.width == 0) {
+			continue;
+		}
+		failureCount += !TEST_CHECK(r.x + r.width <= atlas.width && r.y + r.height <= atlas.height);
+		for (size_t j = 0; j < i; ++j) {
+			const Rect& o = atlas.rectList[j];
+			failureCount += !TEST_CHECK(o.width == 0 || r.x + r.width <= o.x || o.x + o.width <= r.x || r.y + r.height <= o.y || o.y + o.height <= r.y);
+		}
+		std::vector<uint8_t> dst(r.width * r.height);
+		DistanceField::Generate(alpha.data(), imageWidth, glyphList[i], scale, spread, dst.data(), r.width);
+		for (uint32_t y = 0; y < r.height; ++y) {
+			failureCount += !TEST_CHECK(std::equal(dst.begin() + y * r.width, dst.begin() + (y + 1) * r.width, atlas.image.begin() + (r.y + y) * atlas.width + r.x));
+		}
+	}
+
+	for (uint32_t threadCount : { 2U, 5U, 64U }) {
+		DistanceField::Atlas other;
+		DistanceField::BuildAtlas(alpha.data(), imageWidth, glyphList.data(), glyphList.size(), scale, spread, atlasWidth, other, threadCount);
+		TEST_CHECK(other.image == atlas.image);
+	}
+}
+
+} // unnamed namespace
+
+/**
+* DistanceFieldのテスト.
+*/
+void TestDistanceField()
+{
+	TestGetSize();
+	TestGenerateMatchesReference();
+	TestBuildAtlas();
+}
+
+} // namespace Test
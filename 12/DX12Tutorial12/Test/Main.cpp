@@ -0,0 +1,71 @@
+/**
+* @file Main.cpp
+*
+* DX12Tutorial12のGPUに依存しない部品の単体テストとベンチマーク.
+*
+* 引数なしで実行すると全てのテストを実行し、失敗があれば1を返す.
+* --benchを指定すると、テストの後でベンチマークを実行して処理速度を表示する.
+* ベンチマークはReleaseビルドで実行すること.
+* SpriteVertexのベンチマークは、D3D12デバイスを作成できればアップロードヒープへの書き込みも計測する.
+*/
+#include "Test.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace /* unnamed */ {
+
+/// テストまたはベンチマークの名前と関数.
+struct Entry
+{
+	const char* name;
+	void(*func)();
+};
+
+const Entry testList[] = {
+	{ "BuddyAllocator", Test::TestBuddyAllocator },
+	{ "RingAllocator", Test::TestRingAllocator },
+	{ "DescriptorAllocator", Test::TestDescriptorAllocator },
+	{ "CopyFenceTracker", Test::TestCopyFenceTracker },
+	{ "Terrain", Test::TestTerrain },
+	{ "Palette", Test::TestPalette },
+	{ "SpriteMesh", Test::TestSpriteMesh },
+	{ "DistanceField", Test::TestDistanceField },
+	{ "SpriteVertex", Test::TestSpriteVertex },
+};
+
+const Entry benchList[] = {
+	{ "BuddyAllocator", Test::BenchBuddyAllocator },
+	{ "Terrain", Test::BenchTerrain },
+	{ "SpriteVertex", Test::BenchSpriteVertex },
+};
+
+} // unnamed namespace
+
+int main(int argc, char** argv)
+{
+	bool runBench = false;
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], "--bench") == 0) {
+			runBench = true;
+		}
+	}
+
+	for (const Entry& e : testList) {
+		printf("[test] %s\n", e.name);
+		e.func();
+	}
+	if (runBench) {
+		for (const Entry& e : benchList) {
+			printf("[bench] %s\n", e.name);
+			e.func();
+		}
+	}
+
+	const int failureCount = Test::GetFailureCount();
+	if (failureCount) {
+		printf("%d check(s) failed.\n", failureCount);
+		return 1;
+	}
+	printf("All tests passed.\n");
+	return 0;
+}
@@ -0,0 +1,149 @@
+/**
+* @file PaletteTest.cpp
+*/
+#include "Test.h"
+#include "../Src/Palette.h"
+#include <vector>
+#include <random>
+#include <string.h>
+
+namespace Test {
+
+namespace /* unnamed */ {
+
+/**
+* ピクセルの色を取得する.
+*/
+uint32_t GetPixel(const std::vector<uint8_t>& rgba, size_t rowPitch, uint32_t x, uint32_t y)
+{
+	uint32_t color;
+	memcpy(&color, rgba.data() + rowPitch * y + x * 4, 4);
+	return color;
+}
+
+/**
+* 2つの色の距離の2乗を求める.
+*/
+int Distance(uint32_t a, uint32_t b)
+{
+	int sum = 0;
+	for (int c = 0; c < 4; ++c) {
+		const int d = static_cast<int>((a >> (c * 8)) & 0xff) - static_cast<int>((b >> (c * 8)) & 0xff);
+		sum += d * d;
+	}
+	return sum;
+}
+
+/**
+* 乱数で画像を作成する.
+*
+* @param width      画像の幅.
+* @param rowPitch   1行のバイト数.
+* @param height     画像の高さ.
+* @param colorCount 使用する色数. 色は乱数で選ぶ.
+* @param seed       乱数の種.
+*
+* @return 作成した画像. 左上のピクセルは完全に透明な色にする.
+*/
+std::vector<uint8_t> CreateImage(uint32_t width, size_t rowPitch, uint32_t height, uint32_t colorCount, uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	std::vector<uint32_t> colorList(colorCount);
+	for (auto& e : colorList) {
+		e = rng() | 1; // 透明な色と区別するため、0にならないようにする.
+	}
+	std::vector<uint8_t> rgba(rowPitch * height, 0xcd);
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			const uint32_t color = (x == 0 && y == 0) ? 0 : colorList[rng() % colorCount];
+			memcpy(rgba.data() + rowPitch * y + x * 4, &color, 4);
+		}
+	}
+	return rgba;
+}
+
+/**
+* 256色以下の画像が劣化なく変換されることを確かめる.
+*/
+void TestLossless()
+{
+	Palette::IndexedImage image;
+	TEST_CHECK(!Palette::Quantize(nullptr, 0, 0, 0, image));
+
+	const uint32_t width = 37;
+	const uint32_t height = 19;
+	const size_t rowPitch = width * 4 + 12;
+	const std::vector<uint8_t> rgba = CreateImage(width, rowPitch, height, Palette::maxColorCount - 1, 1);
+	TEST_CHECK(Palette::Quantize(rgba.data(), rowPitch, width, height, image));
+	TEST_CHECK(image.width == width && image.height == height);
+	TEST_CHECK(image.indexList.size() == width * height);
+	TEST_CHECK(image.colorCount <= Palette::maxColorCount);
+	int failureCount = 0;
+	for (uint32_t y = 0; y < height && failureCount == 0; ++y) {
+		for (uint32_t x = 0; x < width && failureCount == 0; ++x) {
+			const uint8_t index = image.indexList[y * width + x];
+			failureCount += !TEST_CHECK(index < image.colorCount);
+			failureCount += !TEST_CHECK(image.colorList[index] == GetPixel(rgba, rowPitch, x, y));
+		}
+	}
+}
+
+/**
+* 256色を超える画像の変換を確かめる.
+*
+* 各ピクセルのパレット番号が、パレットの中で最も近い色を指していることを全探索と比べて調べる.
+* 完全に透明な色は0番に割り当てられ、他の色と混ざらない.
+*/
+void TestMedianCut()
+{
+	const uint32_t width = 64;
+	const uint32_t height = 64;
+	const size_t rowPitch = width * 4;
+	const std::vector<uint8_t> rgba = CreateImage(width, rowPitch, height, 1000, 2);
+	Palette::IndexedImage image;
+	TEST_CHECK(Palette::Quantize(rgba.data(), rowPitch, width, height, image));
+	TEST_CHECK(image.colorCount == Palette::maxColorCount);
+	TEST_CHECK(image.colorList[0] == 0);
+	TEST_CHECK(image.indexList[0] == 0);
+
+	int failureCount = 0;
+	for (uint32_t i = 1; i < width * height && failureCount == 0; ++i) {
+		const uint32_t color = GetPixel(rgba, rowPitch, i % width, i / width);
+		uint32_t nearest = 1;
+		for (uint32_t n = 2; n < image.colorCount; ++n) {
+			if (Distance(color, image.colorList[n]) < Distance(color, image.colorList[nearest])) {
+				nearest = n;
+			}
+		}
+		failureCount += !TEST_CHECK(image.indexList[i] == nearest);
+	}
+}
+
+/**
+* パレットの種類ごとの変換を確かめる.
+*/
+void TestCreateVariant()
+{
+	const uint32_t src[] = { 0x80402010, 0xff00ff00, 0 };
+	uint32_t dst[3];
+	Palette::CreateVariant(src, dst, 3, Palette::Variant_Normal);
+	TEST_CHECK(memcmp(src, dst, sizeof(src)) == 0);
+	Palette::CreateVariant(src, dst, 3, Palette::Variant_Flash);
+	TEST_CHECK(dst[0] == 0x80000010);
+	TEST_CHECK(dst[1] == 0xff000000);
+	TEST_CHECK(dst[2] == 0);
+}
+
+} // unnamed namespace
+
+/**
+* Paletteのテスト.
+*/
+void TestPalette()
+{
+	TestLossless();
+	TestMedianCut();
+	TestCreateVariant();
+}
+
+} // namespace Test
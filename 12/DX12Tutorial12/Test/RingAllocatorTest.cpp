@@ -0,0 +1,218 @@
+/**
+* @file RingAllocatorTest.cpp
+*/
+#include "Test.h"
+#include "../Src/RingAllocator.h"
+#include <deque>
+#include <random>
+
+using Resource::RingAllocator;
+
+namespace Test {
+
+namespace /* unnamed */ {
+
+const uint64_t capacity = 64 * 1024;
+
+/**
+* GPUのフェンスを模したカウンタ.
+*
+* Signalで発行した値を、Advanceを呼ぶたびに古い順に1つずつ完了させる.
+*/
+struct FakeFence
+{
+	uint64_t Signal() { pending.push_back(++lastValue); return lastValue; }
+	uint64_t Advance()
+	{
+		if (!pending.empty()) {
+			completedValue = pending.front();
+			pending.pop_front();
+		}
+		return completedValue;
+	}
+
+	uint64_t lastValue = 0;
+	uint64_t completedValue = 0;
+	std::deque<uint64_t> pending;
+};
+
+/**
+* 確保、Commit、Reclaimの基本的な流れを確かめる.
+*/
+void TestCommitAndReclaim()
+{
+	RingAllocator a(capacity);
+	TEST_CHECK(a.Allocate(0, 1) == RingAllocator::invalidOffset);
+	TEST_CHECK(a.Allocate(capacity + 1, 1) == RingAllocator::invalidOffset);
+
+	FakeFence fence;
+	TEST_CHECK(a.Allocate(1000, 1) == 0);
+	TEST_CHECK(a.Allocate(1000, 256) == 1024);
+	TEST_CHECK(a.GetUsedSize() == 2024);
+	TEST_CHECK(a.GetUncommittedSize() == 2024);
+	const uint64_t f1 = fence.Signal();
+	a.Commit(f1);
+	TEST_CHECK(a.GetUncommittedSize() == 0);
+	TEST_CHECK(a.GetOldestFenceValue() == f1);
+
+	// 同じフェンス値でのCommitは1つの範囲にまとめられる.
+	TEST_CHECK(a.Allocate(100, 1) == 2024);
+	a.Commit(f1);
+	TEST_CHECK(a.GetUsedSize() == 2124);
+
+	const uint64_t f2 = fence.Signal();
+	TEST_CHECK(a.Allocate(100, 1) == 2124);
+	a.Commit(f2);
+
+	// 完了していないフェンス値では何も解放されない.
+	a.Reclaim(fence.completedValue);
+	TEST_CHECK(a.GetUsedSize() == 2224);
+	a.Reclaim(fence.Advance());
+	TEST_CHECK(a.GetUsedSize() == 100);
+	TEST_CHECK(a.GetOldestFenceValue() == f2);
+	a.Reclaim(fence.Advance());
+	TEST_CHECK(a.GetUsedSize() == 0);
+	TEST_CHECK(!a.HasCommittedRange());
+}
+
+/**
+* 末尾で折り返すときの振る舞いを確かめる.
+*
+* 末尾の隙間は捨てられ、それを含む範囲が解放されるまで使用中として数えられる.
+*/
+void TestWrapAround()
+{
+	RingAllocator a(capacity);
+	FakeFence fence;
+	TEST_CHECK(a.Allocate(capacity / 2, 1) == 0);
+	a.Commit(fence.Signal());
+	TEST_CHECK(a.Allocate(capacity / 4, 1) == capacity / 2);
+	a.Commit(fence.Signal());
+
+	// 前半が使用中の間は、末尾の隙間に収まらない要求は失敗する.
+	TEST_CHECK(a.Allocate(capacity / 2, 1) == RingAllocator::invalidOffset);
+	a.Reclaim(fence.Advance());
+	TEST_CHECK(a.Allocate(capacity / 2, 1) == 0);
+	TEST_CHECK(a.GetUsedSize() == capacity);
+	a.Commit(fence.Signal());
+	TEST_CHECK(a.Allocate(1, 1) == RingAllocator::invalidOffset);
+
+	// 捨てた末尾の隙間は、折り返した確保の範囲として解放される.
+	a.Reclaim(fence.Advance());
+	TEST_CHECK(a.GetUsedSize() == capacity / 4 + capacity / 2);
+	a.Reclaim(fence.Advance());
+	TEST_CHECK(a.GetUsedSize() == 0);
+}
+
+/**
+* 容量を超える要求を外部の領域として登録したときの振る舞いを確かめる.
+*
+* UploadBufferは専用バッファを作成してAddExternalで登録し、Reclaimが返した数だけ古い順に解放する.
+*/
+void TestOversized()
+{
+	RingAllocator a(capacity);
+	FakeFence fence;
+	TEST_CHECK(!a.IsOversized(capacity));
+	TEST_CHECK(a.IsOversized(capacity + 1));
+	TEST_CHECK(a.Allocate(capacity + 1, 1) == RingAllocator::invalidOffset);
+
+	// リング内の領域と同じフェンス値で解放される.
+	TEST_CHECK(a.Allocate(1000, 1) == 0);
+	a.AddExternal();
+	TEST_CHECK(a.HasUncommittedRange());
+	const uint64_t f1 = fence.Signal();
+	a.Commit(f1);
+	TEST_CHECK(!a.HasUncommittedRange());
+	TEST_CHECK(a.GetOldestFenceValue() == f1);
+
+	// 外部の領域だけでもCommitでき、完了するまで解放されない.
+	a.AddExternal();
+	a.AddExternal();
+	TEST_CHECK(a.GetUncommittedSize() == 0);
+	TEST_CHECK(a.HasUncommittedRange());
+	const uint64_t f2 = fence.Signal();
+	a.Commit(f2);
+	TEST_CHECK(a.GetOldestFenceValue() == f1);
+	TEST_CHECK(a.Reclaim(fence.completedValue) == 0);
+	TEST_CHECK(a.Reclaim(fence.Advance()) == 1);
+	TEST_CHECK(a.GetUsedSize() == 0);
+
+	// 空になったリングは先頭から使われる. 外部の領域だけの範囲を解放しても、使用中の領域は影響を受けない.
+	TEST_CHECK(a.Allocate(capacity / 2, 1) == 0);
+	a.Commit(fence.Signal());
+	TEST_CHECK(a.Reclaim(fence.Advance()) == 2);
+	TEST_CHECK(a.GetUsedSize() == capacity / 2);
+	TEST_CHECK(a.Allocate(capacity / 2, 1) == capacity / 2);
+	TEST_CHECK(a.Allocate(1, 1) == RingAllocator::invalidOffset);
+	a.Commit(fence.Signal());
+	TEST_CHECK(a.Reclaim(fence.Advance()) == 0);
+	TEST_CHECK(a.GetUsedSize() == capacity / 2);
+	TEST_CHECK(a.Reclaim(fence.Advance()) == 0);
+	TEST_CHECK(a.GetUsedSize() == 0);
+	TEST_CHECK(!a.HasCommittedRange());
+}
+
+/**
+* 複数フレームが同時に実行中の状態を模して、確保した領域が使用中の領域と重ならないことを確かめる.
+*/
+void TestFramesInFlight()
+{
+	struct Range
+	{
+		uint64_t fenceValue;
+		uint64_t offset;
+		uint64_t size;
+	};
+
+	RingAllocator a(capacity);
+	FakeFence fence;
+	std::mt19937 rng(1);
+	std::deque<Range> liveList;
+	int failureCount = 0;
+	for (int frame = 0; frame < 2000 && failureCount == 0; ++frame) {
+		// GPUは最大3フレーム遅れる.
+		while (fence.pending.size() >= 3) {
+			a.Reclaim(fence.Advance());
+		}
+		while (!liveList.empty() && liveList.front().fenceValue <= fence.completedValue) {
+			liveList.pop_front();
+		}
+		const uint64_t fenceValue = fence.lastValue + 1;
+		const int allocationCount = rng() % 8;
+		for (int i = 0; i < allocationCount; ++i) {
+			const uint64_t size = 1 + rng() % (capacity / 16);
+			const uint64_t alignment = 1ULL << (rng() % 9);
+			const uint64_t offset = a.Allocate(size, alignment);
+			if (offset == RingAllocator::invalidOffset) {
+				continue;
+			}
+			failureCount += !TEST_CHECK(offset % alignment == 0);
+			failureCount += !TEST_CHECK(offset + size <= capacity);
+			for (const Range& r : liveList) {
+				failureCount += !TEST_CHECK(offset + size <= r.offset || r.offset + r.size <= offset);
+			}
+			liveList.push_back({ fenceValue, offset, size });
+		}
+		a.Commit(fence.Signal());
+	}
+	while (!fence.pending.empty()) {
+		a.Reclaim(fence.Advance());
+	}
+	TEST_CHECK(a.GetUsedSize() == 0);
+}
+
+} // unnamed namespace
+
+/**
+* RingAllocatorのテスト.
+*/
+void TestRingAllocator()
+{
+	TestCommitAndReclaim();
+	TestWrapAround();
+	TestOversized();
+	TestFramesInFlight();
+}
+
+} // namespace Test
@@ -0,0 +1,185 @@
+/**
+* @file SpriteMeshTest.cpp
+*/
+#include "Test.h"
+#include "../Src/SpriteMesh.h"
+#include <vector>
+#include <random>
+#include <cmath>
+
+namespace Test {
+
+namespace /* unnamed */ {
+
+const uint32_t atlasSize = 64; ///< テスト用の画像の大きさ.
+const uint32_t cellLeft = 8; ///< セルの左端.
+const uint32_t cellTop = 16; ///< セルの上端.
+const uint32_t cellSize = 32; ///< セルの大きさ.
+
+/**
+* 多角形が凸で時計回りであり、セルの範囲に収まっていることを確かめる.
+*
+* @return 条件を満たさなければfalse.
+*/
+bool CheckShape(const SpriteMesh::Polygon& polygon)
+{
+	if (!TEST_CHECK(polygon.count >= 3 && polygon.count <= SpriteMesh::maxVertexCount)) {
+		return false;
+	}
+	bool result = true;
+	for (uint32_t i = 0; i < polygon.count; ++i) {
+		const float* p0 = polygon.vertexList[i];
+		const float* p1 = polygon.vertexList[(i + 1) % polygon.count];
+		const float* p2 = polygon.vertexList[(i + 2) % polygon.count];
+		result &= TEST_CHECK(p0[0] >= 0 && p0[0] <= 1 && p0[1] >= 0 && p0[1] <= 1);
+		const float cross = (p1[0] - p0[0]) * (p2[1] - p1[1]) - (p1[1] - p0[1]) * (p2[0] - p1[0]);
+		result &= TEST_CHECK(cross >= -1e-6f);
+	}
+	return result && TEST_CHECK(SpriteMesh::GetArea(polygon) > 0);
+}
+
+/**
+* 不透明なピクセルが全て多角形に含まれることを確かめる.
+*
+* ピクセルの4隅が全ての辺の内側(左側)にあれば、ピクセルは多角形に含まれる.
+*
+* @return 含まれないピクセルがあればfalse.
+*/
+bool CheckCoverage(const std::vector<uint8_t>& alpha, const SpriteMesh::Polygon& polygon)
+{
+	const float eps = 1e-4f;
+	for (uint32_t y = 0; y < cellSize; ++y) {
+		for (uint32_t x = 0; x < cellSize; ++x) {
+			if (alpha[(cellTop + y) * atlasSize + cellLeft + x] == 0) {
+				continue;
+			}
+			for (uint32_t corner = 0; corner < 4; ++corner) {
+				const float qx = static_cast<float>(x + (corner & 1)) / cellSize;
+				const float qy = static_cast<float>(y + (corner >> 1)) / cellSize;
+				for (uint32_t i = 0; i < polygon.count; ++i) {
+					const float* p0 = polygon.vertexList[i];
+					const float* p1 = polygon.vertexList[(i + 1) % polygon.count];
+					const float cross = (p1[0] - p0[0]) * (qy - p0[1]) - (p1[1] - p0[1]) * (qx - p0[0]);
+					if (!TEST_CHECK(cross >= -eps)) {
+						return false;
+					}
+				}
+			}
+		}
+	}
+	return true;
+}
+
+/**
+* セルの範囲にだけ図形を描いた画像を作成する.
+*
+* セルの外側は不透明にして、セルの範囲外を読んでいないことも確かめられるようにする.
+*
+* @param inside ピクセルが図形に含まれるかを返す関数.
+*/
+template<typename F>
+std::vector<uint8_t> CreateAlpha(F inside)
+{
+	std::vector<uint8_t> alpha(atlasSize * atlasSize, 255);
+	for (uint32_t y = 0; y < cellSize; ++y) {
+		for (uint32_t x = 0; x < cellSize; ++x) {
+			alpha[(cellTop + y) * atlasSize + cellLeft + x] = inside(x, y) ? 255 : 0;
+		}
+	}
+	return alpha;
+}
+
+/**
+* 空のセルと不透明なセルの扱いを確かめる.
+*/
+void TestEmptyAndOpaque()
+{
+	SpriteMesh::Polygon polygon;
+	std::vector<uint8_t> alpha = CreateAlpha([](uint32_t, uint32_t) { return false; });
+	TEST_CHECK(!SpriteMesh::Build(alpha.data(), atlasSize, cellLeft, cellTop, cellSize, cellSize, polygon));
+	TEST_CHECK(!SpriteMesh::IsOpaque(alpha.data(), atlasSize, cellLeft, cellTop, cellSize, cellSize));
+
+	alpha = CreateAlpha([](uint32_t, uint32_t) { return true; });
+	TEST_CHECK(SpriteMesh::IsOpaque(alpha.data(), atlasSize, cellLeft, cellTop, cellSize, cellSize));
+	TEST_CHECK(!SpriteMesh::IsOpaque(alpha.data(), atlasSize, cellLeft, cellTop, 0, cellSize));
+	TEST_CHECK(SpriteMesh::Build(alpha.data(), atlasSize, cellLeft, cellTop, cellSize, cellSize, polygon));
+	TEST_CHECK(polygon.count == 4);
+	TEST_CHECK(SpriteMesh::GetArea(polygon) == 1.0f);
+
+	// 半透明なピクセルが1つでもあれば不透明ではない.
+	alpha[(cellTop + 5) * atlasSize + cellLeft + 7] = 254;
+	TEST_CHECK(!SpriteMesh::IsOpaque(alpha.data(), atlasSize, cellLeft, cellTop, cellSize, cellSize));
+}
+
+/**
+* 円や菱形のように矩形との差が大きい図形では、矩形より小さな多角形が作られることを確かめる.
+*/
+void TestShapes()
+{
+	const float c = (cellSize - 1) * 0.5f;
+	const std::vector<uint8_t> circle = CreateAlpha([c](uint32_t x, uint32_t y) {
+		const float dx = x - c;
+		const float dy = y - c;
+		return dx * dx + dy * dy <= 12.0f * 12.0f;
+	});
+	const std::vector<uint8_t> diamond = CreateAlpha([c](uint32_t x, uint32_t y) {
+		return std::abs(x - c) + std::abs(y - c) <= 14.0f;
+	});
+	for (const auto* alpha : { &circle, &diamond }) {
+		SpriteMesh::Polygon polygon;
+		TEST_CHECK(SpriteMesh::Build(alpha->data(), atlasSize, cellLeft, cellTop, cellSize, cellSize, polygon));
+		CheckShape(polygon);
+		CheckCoverage(*alpha, polygon);
+		TEST_CHECK(polygon.count > 4);
+		// 図形を囲む矩形は一辺がおよそ26ピクセルなので、面積はセルの2/3程度. それより十分小さいこと.
+		TEST_CHECK(SpriteMesh::GetArea(polygon) < 0.6f);
+	}
+}
+
+/**
+* 乱数で作った図形について、多角形が不透明部分を全て含むことを確かめる.
+*/
+void TestRandomShapes()
+{
+	std::mt19937 rng(1);
+	for (int n = 0; n < 200; ++n) {
+		const uint32_t count = 1 + rng() % 5;
+		uint32_t blob[5][3];
+		for (uint32_t i = 0; i < count; ++i) {
+			blob[i][0] = rng() % cellSize;
+			blob[i][1] = rng() % cellSize;
+			blob[i][2] = 1 + rng() % 10;
+		}
+		const std::vector<uint8_t> alpha = CreateAlpha([&](uint32_t x, uint32_t y) {
+			for (uint32_t i = 0; i < count; ++i) {
+				const int dx = static_cast<int>(x) - static_cast<int>(blob[i][0]);
+				const int dy = static_cast<int>(y) - static_cast<int>(blob[i][1]);
+				if (static_cast<uint32_t>(dx * dx + dy * dy) <= blob[i][2] * blob[i][2]) {
+					return true;
+				}
+			}
+			return false;
+		});
+		SpriteMesh::Polygon polygon;
+		if (!TEST_CHECK(SpriteMesh::Build(alpha.data(), atlasSize, cellLeft, cellTop, cellSize, cellSize, polygon))) {
+			break;
+		}
+		if (!CheckShape(polygon) || !CheckCoverage(alpha, polygon)) {
+			break;
+		}
+	}
+}
+
+} // unnamed namespace
+
+/**
+* SpriteMeshのテスト.
+*/
+void TestSpriteMesh()
+{
+	TestEmptyAndOpaque();
+	TestShapes();
+	TestRandomShapes();
+}
+
+} // namespace Test
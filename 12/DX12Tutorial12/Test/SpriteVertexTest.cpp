@@ -0,0 +1,453 @@
+/**
+* @file SpriteVertexTest.cpp
+*/
+#include "Test.h"
+#include "../Src/SpriteVertex.h"
+#include "../Src/d3dx12.h"
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+using namespace DirectX;
+using Sprite::Cell;
+using Sprite::Vertex;
+using Sprite::CompactVertex;
+using Sprite::WriteCombiner;
+
+namespace Test {
+
+namespace /* unnamed */ {
+
+const XMFLOAT2 screenOffset(-400.0f, 300.0f); ///< 800x600のビューポートでRendererが使うスクリーン左上座標.
+const size_t benchSpriteCount = 16384; ///< ベンチマークで書き込むスプライト数.
+const int benchRepeatCount = 20; ///< ベンチマークで書き込みを繰り返す回数.
+const int uploadBenchRepeatCount = 10; ///< アップロードヒープへの書き込みを各方法で計測する回数.
+
+/**
+* テスト用のスプライトとセルの組.
+*/
+struct SpriteSet
+{
+	std::vector<Cell> cellList;
+	std::vector<Sprite::Sprite> spriteList;
+	std::vector<const Sprite::Sprite*> spritePtrList; ///< AddVertexBatchに渡すスプライトの配列.
+	std::vector<const Cell*> cellPtrList; ///< AddVertexBatchに渡すセルの配列.
+	uint32_t vertexCount; ///< 全スプライトの頂点数の合計.
+};
+
+/**
+* 乱数でスプライトを作成する.
+*
+* アニメーションリストを持たないスプライトは、SetCellIndexで指定したセルを表示する.
+*
+* @param count       スプライトの数.
+* @param hasRotation trueなら全てのスプライトを回転させる. falseなら回転させない.
+* @param hasMesh     trueなら形状を持つセルを混ぜる. falseなら全て矩形のセルにする.
+* @param seed        乱数の種.
+*/
+SpriteSet CreateSpriteSet(size_t count, bool hasRotation, bool hasMesh, uint32_t seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	SpriteSet set;
+	set.cellList.resize(16);
+	for (size_t i = 0; i < set.cellList.size(); ++i) {
+		Cell& cell = set.cellList[i];
+		cell = {};
+		cell.uv = XMFLOAT2(unit(rng) * 0.5f, unit(rng) * 0.5f);
+		cell.tsize = XMFLOAT2(unit(rng) * 0.5f, unit(rng) * 0.5f);
+		cell.ssize = XMFLOAT2(8.0f + unit(rng) * 120.0f, 8.0f + unit(rng) * 120.0f);
+		cell.offset = XMFLOAT2(unit(rng) * 8.0f - 4.0f, unit(rng) * 8.0f - 4.0f);
+		if (hasMesh && (i % 2)) {
+			// 単位円に内接する凸多角形を形状とする.
+			cell.meshVertexCount = 3 + static_cast<uint32_t>(i % (SpriteMesh::maxVertexCount - 2));
+			for (uint32_t n = 0; n < cell.meshVertexCount; ++n) {
+				const float a = XM_2PI * static_cast<float>(n) / static_cast<float>(cell.meshVertexCount);
+				cell.mesh[n] = XMFLOAT2(0.5f + 0.5f * std::cos(a), 0.5f + 0.5f * std::sin(a));
+			}
+		}
+	}
+	set.spriteList.reserve(count);
+	set.vertexCount = 0;
+	for (size_t i = 0; i < count; ++i) {
+		const XMFLOAT3 pos(unit(rng) * 800.0f, unit(rng) * 600.0f, unit(rng));
+		const float rotation = hasRotation ? (unit(rng) * 2.0f - 1.0f) * XM_PI : 0.0f;
+		const XMFLOAT2 scale(0.5f + unit(rng) * 1.5f, 0.5f + unit(rng) * 1.5f);
+		const XMFLOAT4 color(unit(rng), unit(rng), unit(rng), unit(rng));
+		set.spriteList.emplace_back(nullptr, pos, rotation, scale, color);
+		Sprite::Sprite& sprite = set.spriteList.back();
+		sprite.color[1] = XMFLOAT4(unit(rng), unit(rng), unit(rng), unit(rng));
+		sprite.blendMode = (rng() % 4) ? Sprite::BlendMode_Alpha : Sprite::BlendMode_Add;
+		sprite.palette = rng() % 4;
+		sprite.SetCellIndex(rng() % set.cellList.size());
+	}
+	for (const Sprite::Sprite& sprite : set.spriteList) {
+		const Cell& cell = set.cellList[sprite.GetCellIndex()];
+		set.spritePtrList.push_back(&sprite);
+		set.cellPtrList.push_back(&cell);
+		set.vertexCount += Sprite::GetMeshVertexCount(cell);
+	}
+	return set;
+}
+
+/**
+* 1スプライトずつ頂点データを計算する.
+*
+* バッチ処理を導入する前のRendererと同じく、スプライト毎にXMScalarSinCosで回転を計算して、
+* 頂点とインデックスを書き込み先へ直接格納する. AddVertexBatchの結果の検証と、ベンチマークの比較対象に使う.
+*
+* @return 書き込んだ頂点数.
+*/
+uint32_t AddVertexReference(const Sprite::Sprite& sprite, const Cell& cell, Vertex* v, uint32_t* index, uint32_t baseVertex)
+{
+	const AnimationData& anm = sprite.animeController.GetData();
+	const float cx = screenOffset.x + sprite.pos.x + cell.offset.x * sprite.scale.x;
+	const float cy = screenOffset.y - sprite.pos.y - cell.offset.y * sprite.scale.y;
+	const float sx = cell.ssize.x * sprite.scale.x * anm.scale.x;
+	const float sy = cell.ssize.y * sprite.scale.y * anm.scale.y;
+	float s, c;
+	XMScalarSinCos(&s, &c, sprite.rotation + anm.rotation);
+	const XMVECTOR anmColor = XMLoadFloat4(&anm.color);
+	const XMVECTOR c0 = Sprite::Premultiply(XMVectorMultiply(XMLoadFloat4(&sprite.color[0]), anmColor), sprite.blendMode);
+	const XMVECTOR c1 = Sprite::Premultiply(XMVectorMultiply(XMLoadFloat4(&sprite.color[1]), anmColor), sprite.blendMode);
+	const XMFLOAT2* mesh = Sprite::GetMesh(cell);
+	const uint32_t vertexCount = Sprite::GetMeshVertexCount(cell);
+	for (uint32_t i = 0; i < vertexCount; ++i) {
+		const float lx = (mesh[i].x - 0.5f) * sx;
+		const float ly = (0.5f - mesh[i].y) * sy;
+		v[i].position = XMFLOAT3(cx + c * lx + s * ly, cy - s * lx + c * ly, sprite.pos.z);
+		XMStoreFloat4(&v[i].color, XMVectorLerp(c0, c1, mesh[i].y));
+		v[i].texcoord = XMFLOAT2(cell.uv.x + cell.tsize.x * mesh[i].x, cell.uv.y + cell.tsize.y * mesh[i].y);
+		v[i].palette = static_cast<float>(sprite.palette);
+	}
+	for (uint32_t n = 1; n < vertexCount - 1; ++n) {
+		index[0] = baseVertex;
+		index[1] = baseVertex + n;
+		index[2] = baseVertex + n + 1;
+		index += 3;
+	}
+	return vertexCount;
+}
+
+/**
+* 全スプライトをAddVertexBatchで書き込む.
+*
+* Renderer::FillVertexと同じく、batchSize個ずつ1つのWriteCombinerへ続けて書き込む.
+*
+* @param isStaged WriteCombinerに作業領域を使わせるならtrue.
+*/
+template<typename T>
+void AddVertexBatchAll(const SpriteSet& set, void* vertexList, void* indexList, bool isStaged = true)
+{
+	WriteCombiner vertexOut(vertexList, isStaged);
+	WriteCombiner indexOut(indexList, isStaged);
+	const size_t count = set.spriteList.size();
+	uint32_t baseVertex = 0;
+	for (size_t i = 0; i < count; i += Sprite::batchSize) {
+		const size_t n = std::min(Sprite::batchSize, count - i);
+		Sprite::AddVertexBatch<T>(&set.spritePtrList[i], &set.cellPtrList[i], n, vertexOut, indexOut, baseVertex, screenOffset);
+		for (size_t k = 0; k < n; ++k) {
+			baseVertex += Sprite::GetMeshVertexCount(*set.cellPtrList[i + k]);
+		}
+	}
+	vertexOut.Flush();
+	indexOut.Flush();
+}
+
+/**
+* 全スプライトをAddVertexReferenceで書き込む.
+*/
+void AddVertexReferenceAll(const SpriteSet& set, Vertex* vertexList, uint32_t* indexList)
+{
+	uint32_t baseVertex = 0;
+	for (size_t i = 0; i < set.spriteList.size(); ++i) {
+		const uint32_t n = AddVertexReference(*set.spritePtrList[i], *set.cellPtrList[i], vertexList + baseVertex, indexList, baseVertex);
+		indexList += (n - 2) * 3;
+		baseVertex += n;
+	}
+}
+
+/**
+* 2つの頂点がほぼ等しいか調べる.
+*
+* 三角関数の近似方法が異なるため、位置には回転半径に応じた誤差を許す.
+*/
+bool IsNearlyEqual(const Vertex& a, const Vertex& b)
+{
+	const float* pa = &a.position.x;
+	const float* pb = &b.position.x;
+	for (int i = 0; i < 10; ++i) {
+		const float tolerance = i < 2 ? 1e-3f : 1e-5f;
+		if (std::abs(pa[i] - pb[i]) > tolerance) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+* AddVertexBatchの結果が1スプライトずつ計算した結果と一致することを確かめる.
+*
+* スプライト数がbatchSizeの倍数でない場合や、書き込み先がキャッシュライン境界にない場合も調べる.
+* CompactVertex形式は、1スプライトずつ計算した頂点を変換した値と比べ、丸めの差として1の誤差を許す.
+*/
+void TestAddVertexBatch()
+{
+	int failureCount = 0;
+	for (size_t count : { 1, 3, 4, 5, 17, 1001 }) {
+		const SpriteSet set = CreateSpriteSet(count, count % 2 != 0, true, static_cast<uint32_t>(count));
+		const size_t indexCount = (set.vertexCount - count * 2) * 3;
+		std::vector<Vertex> reference(set.vertexCount);
+		std::vector<uint32_t> referenceIndex(indexCount);
+		AddVertexReferenceAll(set, reference.data(), referenceIndex.data());
+
+		// 先頭に端数のバイトを置いて、書き込み先をキャッシュライン境界からずらす.
+		const size_t skew = 8 + count % 5 * 4;
+		std::vector<uint8_t> vertexBuffer(skew + set.vertexCount * sizeof(Vertex) + WriteCombiner::lineSize, 0xcd);
+		std::vector<uint8_t> indexBuffer(skew + indexCount * sizeof(uint32_t) + WriteCombiner::lineSize, 0xcd);
+		AddVertexBatchAll<Vertex>(set, vertexBuffer.data() + skew, indexBuffer.data() + skew);
+		const Vertex* v = reinterpret_cast<const Vertex*>(vertexBuffer.data() + skew);
+		const uint32_t* index = reinterpret_cast<const uint32_t*>(indexBuffer.data() + skew);
+		failureCount += !TEST_CHECK(vertexBuffer[skew - 1] == 0xcd && vertexBuffer[skew + set.vertexCount * sizeof(Vertex)] == 0xcd);
+		failureCount += !TEST_CHECK(std::equal(referenceIndex.begin(), referenceIndex.end(), index));
+		for (uint32_t i = 0; i < set.vertexCount && failureCount == 0; ++i) {
+			failureCount += !TEST_CHECK(IsNearlyEqual(v[i], reference[i]));
+		}
+
+		// 作業領域を使わずに書き込んでも、同じ範囲に同じ内容が書き込まれる.
+		std::vector<uint8_t> directVertexBuffer(vertexBuffer.size(), 0xcd);
+		std::vector<uint8_t> directIndexBuffer(indexBuffer.size(), 0xcd);
+		AddVertexBatchAll<Vertex>(set, directVertexBuffer.data() + skew, directIndexBuffer.data() + skew, false);
+		failureCount += !TEST_CHECK(directVertexBuffer == vertexBuffer);
+		failureCount += !TEST_CHECK(directIndexBuffer == indexBuffer);
+
+		std::vector<CompactVertex> compactReference(set.vertexCount);
+		Sprite::StoreVertex(reference.data(), set.vertexCount, compactReference.data());
+		std::vector<CompactVertex> compact(set.vertexCount);
+		AddVertexBatchAll<CompactVertex>(set, compact.data(), indexBuffer.data());
+		for (uint32_t i = 0; i < set.vertexCount && failureCount == 0; ++i) {
+			const CompactVertex& a = compact[i];
+			const CompactVertex& b = compactReference[i];
+			failureCount += !TEST_CHECK(abs(a.position.x - b.position.x) <= 1 && abs(a.position.y - b.position.y) <= 1 && a.position.z == b.position.z && a.position.w == b.position.w);
+			failureCount += !TEST_CHECK(abs(a.color.x - b.color.x) <= 1 && abs(a.color.y - b.color.y) <= 1 && abs(a.color.z - b.color.z) <= 1 && abs(a.color.w - b.color.w) <= 1);
+			failureCount += !TEST_CHECK(abs(a.texcoord.x - b.texcoord.x) <= 1 && abs(a.texcoord.y - b.texcoord.y) <= 1);
+		}
+	}
+}
+
+/**
+* AddStaticVertexBatchが全てのスプライトに同じ頂点数を割り当て、余りを最後の頂点で埋めることを確かめる.
+*/
+void TestAddStaticVertexBatch()
+{
+	const SpriteSet set = CreateSpriteSet(37, true, true, 5);
+	const size_t count = set.spriteList.size();
+	std::vector<Vertex> dynamicList(set.vertexCount);
+	std::vector<uint32_t> indexList((set.vertexCount - count * 2) * 3);
+	AddVertexBatchAll<Vertex>(set, dynamicList.data(), indexList.data());
+
+	std::vector<Vertex> staticList(count * SpriteMesh::maxVertexCount);
+	{
+		WriteCombiner out(staticList.data());
+		for (size_t i = 0; i < count; i += Sprite::batchSize) {
+			const size_t n = std::min(Sprite::batchSize, count - i);
+			Sprite::AddStaticVertexBatch<Vertex>(&set.spritePtrList[i], &set.cellPtrList[i], n, out, screenOffset);
+		}
+		out.Flush();
+	}
+	int failureCount = 0;
+	size_t first = 0;
+	for (size_t i = 0; i < count && failureCount == 0; ++i) {
+		const uint32_t vertexCount = Sprite::GetMeshVertexCount(*set.cellPtrList[i]);
+		for (uint32_t n = 0; n < SpriteMesh::maxVertexCount; ++n) {
+			const Vertex& a = staticList[i * SpriteMesh::maxVertexCount + n];
+			const Vertex& b = dynamicList[first + std::min(n, vertexCount - 1)];
+			failureCount += !TEST_CHECK(memcmp(&a, &b, sizeof(Vertex)) == 0);
+		}
+		first += vertexCount;
+	}
+}
+
+/**
+* SpriteInstance::ExpandがAddVertexBatchと同じ三角形を作ることを確かめる.
+*
+* Expandの頂点番号を3つずつ三角形とみなし、AddVertexBatchのインデックスが指す頂点と比べる.
+* 形状の頂点数を超える三角形は、3頂点が同じ位置に重なることを調べる.
+* インスタンスの色はRGBA8に詰めるため、色には量子化の誤差を許す.
+*/
+void TestExpand()
+{
+	static_assert(sizeof(SpriteInstance::Corner) == sizeof(Vertex), "TestExpand compares Corner and Vertex as 10 floats.");
+	const SpriteSet set = CreateSpriteSet(103, true, true, 9);
+	const size_t count = set.spriteList.size();
+	std::vector<Vertex> vertexList(set.vertexCount);
+	std::vector<uint32_t> indexList((set.vertexCount - count * 2) * 3);
+	AddVertexBatchAll<Vertex>(set, vertexList.data(), indexList.data());
+
+	std::vector<SpriteInstance::CellData> cellTable(set.cellList.size());
+	uint32_t maxMeshVertexCount = 0;
+	for (size_t i = 0; i < set.cellList.size(); ++i) {
+		Sprite::MakeCellData(set.cellList[i], cellTable[i]);
+		maxMeshVertexCount = std::max(maxMeshVertexCount, cellTable[i].vertexCount);
+	}
+	const uint32_t vertexCountPerInstance = SpriteInstance::GetVertexCountPerInstance(maxMeshVertexCount);
+	TEST_CHECK(vertexCountPerInstance == (SpriteMesh::maxVertexCount - 2) * 3);
+
+	int failureCount = 0;
+	const uint32_t* index = indexList.data();
+	for (size_t i = 0; i < count && failureCount == 0; ++i) {
+		const Sprite::Sprite& sprite = *set.spritePtrList[i];
+		SpriteInstance::Instance instance;
+		Sprite::MakeInstance(sprite, *set.cellPtrList[i], sprite.GetCellIndex(), screenOffset, instance);
+		const uint32_t triangleCount = Sprite::GetMeshVertexCount(*set.cellPtrList[i]) - 2;
+		for (uint32_t vertexId = 0; vertexId < vertexCountPerInstance; ++vertexId) {
+			SpriteInstance::Corner corner;
+			SpriteInstance::Expand(instance, cellTable.data(), vertexId, corner);
+			if (vertexId / 3 >= triangleCount) {
+				SpriteInstance::Corner first;
+				SpriteInstance::Expand(instance, cellTable.data(), vertexId - vertexId % 3, first);
+				failureCount += !TEST_CHECK(memcmp(corner.position, first.position, sizeof(corner.position)) == 0);
+				continue;
+			}
+			const Vertex& v = vertexList[*index++];
+			const float* expected = &v.position.x;
+			const float* actual = corner.position;
+			for (int k = 0; k < 10; ++k) {
+				const float tolerance = k < 2 ? 1e-3f : (k >= 3 && k < 7) ? 0.5f / 255.0f + 1e-5f : 1e-5f;
+				failureCount += !TEST_CHECK(std::abs(actual[k] - expected[k]) <= tolerance);
+			}
+		}
+	}
+	TEST_CHECK(index == indexList.data() + indexList.size());
+}
+
+/**
+* スプライトの書き込み速度を測る.
+*
+* @param name 表示する名前.
+* @param set  書き込むスプライト.
+* @param func 全スプライトを1回書き込む関数.
+*/
+template<typename F>
+void MeasureSprites(const char* name, const SpriteSet& set, F func)
+{
+	func(); // 書き込み先のページを確保しておく.
+	const double startTime = GetTime();
+	for (int i = 0; i < benchRepeatCount; ++i) {
+		func();
+	}
+	ReportBench(name, GetTime() - startTime, set.spriteList.size() * benchRepeatCount, "sprites");
+}
+
+/**
+* 作成済みの頂点データをWriteCombinerでアップロードヒープへ書き込む速度を、作業領域を経由する場合と直接書き込む場合で比べる.
+*
+* 頂点の計算を含めると書き込み方法の差が計算時間に埋もれるため、AddVertexBatchで作った頂点をmemcpyするだけにする.
+* AddVertexBatchと同じく、batchSize個のスプライト分ずつReserveとCommitを繰り返す.
+* 2つの方法を交互にuploadBenchRepeatCount回ずつ計測し、それぞれ最も短い時間を表示する.
+* D3D12デバイスを作成できない環境では何もしない.
+*
+* @param set 書き込むスプライト. 全て矩形のセルを持つこと.
+*/
+void BenchUploadHeap(const SpriteSet& set)
+{
+	Microsoft::WRL::ComPtr<ID3D12Device> device;
+	if (FAILED(D3D12CreateDevice(nullptr, D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&device)))) {
+		printf("  upload heap: skipped (no D3D12 device)\n");
+		return;
+	}
+	std::vector<Vertex> vertexList(set.vertexCount);
+	std::vector<uint32_t> indexList((set.vertexCount - set.spriteList.size() * 2) * 3);
+	AddVertexBatchAll<Vertex>(set, vertexList.data(), indexList.data());
+	const size_t bufferSize = vertexList.size() * sizeof(Vertex);
+	Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+	if (FAILED(device->CreateCommittedResource(
+		&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
+		D3D12_HEAP_FLAG_NONE,
+		&CD3DX12_RESOURCE_DESC::Buffer(bufferSize),
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&buffer)
+	))) {
+		printf("  upload heap: skipped (CreateCommittedResource failed)\n");
+		return;
+	}
+	CD3DX12_RANGE range(0, 0);
+	void* p;
+	if (FAILED(buffer->Map(0, &range, &p))) {
+		printf("  upload heap: skipped (Map failed)\n");
+		return;
+	}
+
+	const uint8_t* const src = reinterpret_cast<const uint8_t*>(vertexList.data());
+	const size_t chunkSize = Sprite::batchSize * Sprite::GetMeshVertexCount(set.cellList[0]) * sizeof(Vertex);
+	const char* const nameList[2] = { "WriteCombiner (staged)", "WriteCombiner (direct)" };
+	double bestTime[2] = { 1e30, 1e30 };
+	for (int repeat = 0; repeat < uploadBenchRepeatCount; ++repeat) {
+		for (int mode = 0; mode < 2; ++mode) {
+			const double startTime = GetTime();
+			WriteCombiner out(p, mode == 0);
+			for (size_t offset = 0; offset < bufferSize; offset += chunkSize) {
+				const size_t n = std::min(chunkSize, bufferSize - offset);
+				memcpy(out.Reserve(n), src + offset, n);
+				out.Commit(n);
+			}
+			out.Flush();
+			bestTime[mode] = std::min(bestTime[mode], GetTime() - startTime);
+		}
+	}
+	buffer->Unmap(0, nullptr);
+	printf("  upload heap\n");
+	for (int mode = 0; mode < 2; ++mode) {
+		ReportBench(nameList[mode], bestTime[mode], set.spriteList.size(), "sprites");
+	}
+}
+
+} // unnamed namespace
+
+/**
+* SpriteVertexのテスト.
+*/
+void TestSpriteVertex()
+{
+	TestAddVertexBatch();
+	TestAddStaticVertexBatch();
+	TestExpand();
+}
+
+/**
+* SpriteVertexのベンチマーク.
+*
+* 矩形のセルを持つbenchSpriteCount個のスプライトについて、1スプライトずつ計算する方法と
+* AddVertexBatchで書き込む方法の速度を、回転しない場合と回転する場合のそれぞれで比べる.
+* 書き込み先は通常のメモリのため、アップロードヒープへの書き込みとは速度が異なる.
+* 最後に、WriteCombinerの2つの書き込み方法をアップロードヒープで比べる. 結果はRenderer::SetUploadStagedの判断に使う.
+*/
+void BenchSpriteVertex()
+{
+	for (bool hasRotation : { false, true }) {
+		const SpriteSet set = CreateSpriteSet(benchSpriteCount, hasRotation, false, 1);
+		std::vector<Vertex> vertexList(set.vertexCount);
+		std::vector<CompactVertex> compactList(set.vertexCount);
+		std::vector<uint32_t> indexList((set.vertexCount - benchSpriteCount * 2) * 3);
+		printf("  %s\n", hasRotation ? "rotated" : "not rotated");
+		MeasureSprites("AddVertexReference", set, [&] {
+			AddVertexReferenceAll(set, vertexList.data(), indexList.data());
+		});
+		MeasureSprites("AddVertexBatch<Vertex>", set, [&] {
+			AddVertexBatchAll<Vertex>(set, vertexList.data(), indexList.data());
+		});
+		MeasureSprites("AddVertexBatch<CompactVertex>", set, [&] {
+			AddVertexBatchAll<CompactVertex>(set, compactList.data(), indexList.data());
+		});
+	}
+	BenchUploadHeap(CreateSpriteSet(benchSpriteCount, false, false, 1));
+}
+
+} // namespace Test
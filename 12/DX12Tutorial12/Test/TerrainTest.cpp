@@ -0,0 +1,120 @@
+/**
+* @file TerrainTest.cpp
+*/
+#include "Test.h"
+#include "../Src/Terrain.h"
+#include <vector>
+#include <stdlib.h>
+
+namespace Test {
+
+namespace /* unnamed */ {
+
+const uint8_t paddingByte = 0xcd; ///< 行末の余白を埋めておく値. Bakeが書き換えないことを確かめる.
+
+/**
+* Bakeで画像を生成する.
+*
+* @param width       画像の幅.
+* @param height      画像の高さ.
+* @param rowPitch    1行のバイト数.
+* @param threadCount 使用するスレッド数.
+*
+* @return 生成した画像.
+*/
+std::vector<uint8_t> BakeImage(uint32_t width, uint32_t height, size_t rowPitch, uint32_t threadCount)
+{
+	std::vector<uint8_t> image(rowPitch * height, paddingByte);
+	Terrain::Bake(image.data(), rowPitch, width, height, threadCount);
+	return image;
+}
+
+/**
+* Bakeの結果がEvaluatePixelと一致することを確かめる.
+*
+* SIMDとスカラーで演算の順序は同じだが、コンパイラが積和演算にまとめる場合を考えて1の誤差を許す.
+* 幅は4の倍数でない値にして、端数の処理と行末の余白が書き換えられないことも調べる.
+*/
+void TestBakeMatchesReference()
+{
+	const uint32_t width = 123;
+	const uint32_t height = 37;
+	const size_t rowPitch = width * 4 + 20;
+	const std::vector<uint8_t> image = BakeImage(width, height, rowPitch, 1);
+	int failureCount = 0;
+	for (uint32_t y = 0; y < height && failureCount == 0; ++y) {
+		const float v = (static_cast<float>(y) + 0.5f) / static_cast<float>(height);
+		const uint8_t* p = image.data() + rowPitch * y;
+		for (uint32_t x = 0; x < width && failureCount == 0; ++x, p += 4) {
+			const float u = (static_cast<float>(x) + 0.5f) / static_cast<float>(width);
+			uint8_t rgba[4];
+			Terrain::EvaluatePixel(u, v, rgba);
+			for (int i = 0; i < 4; ++i) {
+				failureCount += !TEST_CHECK(abs(p[i] - rgba[i]) <= 1);
+			}
+		}
+		for (size_t i = width * 4; i < rowPitch; ++i) {
+			failureCount += !TEST_CHECK(image[rowPitch * y + i] == paddingByte);
+		}
+	}
+}
+
+/**
+* スレッド数によらず同じ画像が生成されることを確かめる.
+*
+* 行数がスレッド数で割り切れない場合や、スレッド数が行数より多い場合も調べる.
+*/
+void TestBakeThreadCount()
+{
+	const uint32_t width = 64;
+	const uint32_t height = 29;
+	const size_t rowPitch = width * 4;
+	const std::vector<uint8_t> reference = BakeImage(width, height, rowPitch, 1);
+	for (uint32_t threadCount : { 2U, 3U, 8U, 64U }) {
+		TEST_CHECK(BakeImage(width, height, rowPitch, threadCount) == reference);
+	}
+}
+
+} // unnamed namespace
+
+/**
+* Terrainのテスト.
+*/
+void TestTerrain()
+{
+	TestBakeMatchesReference();
+	TestBakeThreadCount();
+}
+
+/**
+* Terrainのベンチマーク.
+*
+* Graphics::CreateTerrainTextureと同じ512x512の地形テクスチャについて、
+* EvaluatePixelによる1ピクセルずつの計算と、Bakeの1スレッドおよび全スレッドでの生成速度を比べる.
+*/
+void BenchTerrain()
+{
+	const uint32_t size = 512;
+	const size_t pixelCount = size * size;
+	std::vector<uint8_t> image(pixelCount * 4);
+
+	double startTime = GetTime();
+	uint8_t* p = image.data();
+	for (uint32_t y = 0; y < size; ++y) {
+		const float v = (static_cast<float>(y) + 0.5f) / static_cast<float>(size);
+		for (uint32_t x = 0; x < size; ++x, p += 4) {
+			Terrain::EvaluatePixel((static_cast<float>(x) + 0.5f) / static_cast<float>(size), v, p);
+		}
+	}
+	ReportBench("EvaluatePixel", GetTime() - startTime, pixelCount, "pixels");
+
+	startTime = GetTime();
+	Terrain::Bake(image.data(), size * 4, size, size, 1);
+	ReportBench("Bake (1 thread)", GetTime() - startTime, pixelCount, "pixels");
+
+	startTime = GetTime();
+	Terrain::Bake(image.data(), size * 4, size, size);
+	ReportBench("Bake (all threads)", GetTime() - startTime, pixelCount, "pixels");
+}
+
+} // namespace Test
@@ -0,0 +1,66 @@
+/**
+* @file Test.cpp
+*/
+#include "Test.h"
+#include <chrono>
+#include <stdio.h>
+
+namespace Test {
+
+namespace /* unnamed */ {
+
+int failureCount = 0; ///< 成り立たなかった条件の数.
+
+} // unnamed namespace
+
+/**
+* 条件の結果を記録する.
+*
+* @param result 条件の結果.
+* @param expr   条件の文字列.
+* @param file   条件を書いたファイル名.
+* @param line   条件を書いた行番号.
+*
+* @return resultをそのまま返す.
+*/
+bool Check(bool result, const char* expr, const char* file, int line)
+{
+	if (!result) {
+		++failureCount;
+		printf("  FAILED: %s (%s:%d)\n", expr, file, line);
+	}
+	return result;
+}
+
+/**
+* 成り立たなかった条件の数を取得する.
+*/
+int GetFailureCount()
+{
+	return failureCount;
+}
+
+/**
+* 現在の時刻を取得する.
+*
+* @return 任意の時点からの経過時間(秒).
+*/
+double GetTime()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+* ベンチマークの結果を表示する.
+*
+* @param name    計測した処理の名前.
+* @param seconds 計測した時間(秒).
+* @param count   計測した時間内に処理した数.
+* @param unit    countの単位.
+*/
+void ReportBench(const char* name, double seconds, size_t count, const char* unit)
+{
+	printf("  %-40s %12.0f %s/s (%zu %s in %.2f ms)\n", name, static_cast<double>(count) / seconds, unit, count, unit, seconds * 1000.0);
+}
+
+} // namespace Test
@@ -0,0 +1,40 @@
+/**
+* @file Test.h
+*/
+#ifndef DX12TUTORIAL_TEST_TEST_H_
+#define DX12TUTORIAL_TEST_TEST_H_
+#include <stddef.h>
+
+/**
+* 単体テストとベンチマークの共通機能.
+*
+* テストはTEST_CHECKで条件を調べ、成り立たなかった条件をファイル名と行番号つきで表示する.
+* ベンチマークはコマンドラインに--benchを指定したときだけ実行する.
+*/
+namespace Test {
+
+bool Check(bool result, const char* expr, const char* file, int line);
+int GetFailureCount();
+double GetTime();
+void ReportBench(const char* name, double seconds, size_t count, const char* unit);
+
+// 各テストファイルで定義するテストとベンチマーク.
+void TestBuddyAllocator();
+void BenchBuddyAllocator();
+void TestRingAllocator();
+void TestDescriptorAllocator();
+void TestCopyFenceTracker();
+void TestTerrain();
+void BenchTerrain();
+void TestPalette();
+void TestSpriteMesh();
+void TestDistanceField();
+void TestSpriteVertex();
+void BenchSpriteVertex();
+
+} // namespace Test
+
+/// 条件exprが成り立つか調べる. 成り立たなければ失敗として数える.
+#define TEST_CHECK(expr) ::Test::Check(!!(expr), #expr, __FILE__, __LINE__)
+
+#endif // DX12TUTORIAL_TEST_TEST_H_